@@ -0,0 +1,615 @@
+#include "Engine/Animation/AnimAssetCache.hpp"
+#include "Engine/Animation/AnimPose.hpp"
+#include "Engine/Animation/FbxFileImporter.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/MemoryFile.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/IO/BufferReader.hpp"
+#include "Engine/IO/BufferWriter.hpp"
+
+#include <filesystem>
+#include <string.h>
+#include <type_traits>
+
+
+//----------------------------------------------------------------------------------------------------------
+// header: magic, version, endianness, number of chunks
+// chunk:  type, size of the payload in bytes, payload
+static char const ANIM_CACHE_MAGIC[ 4 ]	  = { 'S', 'D', 'A', 'C' };
+constexpr size_t  ANIM_CACHE_HEADER_SIZE  = 4 + 4 + 1 + 4;
+constexpr size_t  ANIM_CACHE_CHUNK_HEADER = 4 + 4;
+
+// the smallest a joint or a channel can be, so a corrupt count can't make the parse allocate more than the chunk could hold
+constexpr size_t ANIM_CACHE_MIN_JOINT_SIZE	 = 4 + 4;						// empty name, parent index
+constexpr size_t ANIM_CACHE_MIN_CHANNEL_SIZE = 4 + 4 + 1 + 3 * ( 1 + 1 + 4 ); // joint id, empty name, playback type, three empty curves
+
+
+//----------------------------------------------------------------------------------------------------------
+// A corrupt count or length must not read past the end of its chunk, so every read checks first and
+// the parse returns false for the caller to import the FBX again
+static bool AreBytesLeftInChunk( BufferReader const& reader, size_t chunkEnd, size_t numBytes )
+{
+	return reader.m_currentOffsetFromStart <= chunkEnd && numBytes <= chunkEnd - reader.m_currentOffsetFromStart;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// element count, then the array as it is in memory; the element types are plain floats, ints and bytes
+// ( Vec2 has a user copy constructor, so they aren't all formally trivially copyable )
+template <typename T>
+static void AppendArray( BufferWriter& writer, std::vector<T> const& array )
+{
+	static_assert( std::is_standard_layout<T>::value, "only plain data can be cached as a memory image" );
+	writer.AppendUnsignedInt( ( uint32_t ) array.size() );
+	writer.AppendBytes( array.data(), array.size() * sizeof( T ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+template <typename T>
+static bool ParseArray( BufferReader& reader, size_t chunkEnd, std::vector<T>& outArray )
+{
+	static_assert( std::is_standard_layout<T>::value, "only plain data can be cached as a memory image" );
+	if ( !AreBytesLeftInChunk( reader, chunkEnd, 4 ) )
+	{
+		return false;
+	}
+
+	uint32_t numElements = reader.ParseUint32();
+	if ( !AreBytesLeftInChunk( reader, chunkEnd, ( size_t ) numElements * sizeof( T ) ) )
+	{
+		return false;
+	}
+
+	outArray.resize( numElements );
+	reader.ParseBytes( outArray.data(), ( size_t ) numElements * sizeof( T ) );
+	return true;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static bool ParseString( BufferReader& reader, size_t chunkEnd, std::string& outString )
+{
+	if ( !AreBytesLeftInChunk( reader, chunkEnd, 4 ) )
+	{
+		return false;
+	}
+
+	uint32_t stringLength = reader.ParseUint32();
+	if ( !AreBytesLeftInChunk( reader, chunkEnd, stringLength ) )
+	{
+		return false;
+	}
+
+	outString.resize( stringLength );
+	if ( stringLength > 0 )
+	{
+		reader.ParseBytes( &outString[ 0 ], stringLength );
+	}
+	return true;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+template <typename CurveType>
+static void AppendCurve( BufferWriter& writer, CurveType const& curve )
+{
+	writer.AppendByte( ( uint8_t ) curve.m_interpolationType );
+	writer.AppendByte( ( uint8_t ) curve.m_playbackType );
+	AppendArray( writer, curve.m_keyframes );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+template <typename CurveType>
+static bool ParseCurve( BufferReader& reader, size_t chunkEnd, CurveType& outCurve )
+{
+	if ( !AreBytesLeftInChunk( reader, chunkEnd, 2 ) )
+	{
+		return false;
+	}
+
+	outCurve.m_interpolationType = ( AnimInterpolationType ) reader.ParseByte();
+	outCurve.m_playbackType		 = ( AnimPlaybackType ) reader.ParseByte();
+	return ParseArray( reader, chunkEnd, outCurve.m_keyframes );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static void AppendSkeleton( BufferWriter& writer, Skeleton const& skeleton )
+{
+	int numJoints = skeleton.GetNumberOfJoints();
+	writer.AppendUnsignedInt( ( uint32_t ) numJoints );
+
+	std::vector<Transform> bindLocalTransforms;
+	bindLocalTransforms.reserve( numJoints );
+	for ( int jointIndex = 0; jointIndex < numJoints; jointIndex++ )
+	{
+		writer.AppendStringAfter32BitLength( skeleton.GetJointName( jointIndex ).c_str() );
+		writer.AppendInt( skeleton.GetParentOfJoint( jointIndex ) );
+		bindLocalTransforms.push_back( skeleton.GetBindLocalTransformOfJoint( jointIndex ) );
+	}
+	AppendArray( writer, bindLocalTransforms );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// nullptr if the chunk is corrupt
+static std::shared_ptr<Skeleton const> ParseSkeleton( BufferReader& reader, size_t chunkEnd )
+{
+	if ( !AreBytesLeftInChunk( reader, chunkEnd, 4 ) )
+	{
+		return nullptr;
+	}
+
+	uint32_t numJoints = reader.ParseUint32();
+	if ( !AreBytesLeftInChunk( reader, chunkEnd, ( size_t ) numJoints * ANIM_CACHE_MIN_JOINT_SIZE ) )
+	{
+		return nullptr;
+	}
+
+	std::vector<SkeletonJoint> joints( numJoints );
+	for ( SkeletonJoint& joint : joints )
+	{
+		if ( !ParseString( reader, chunkEnd, joint.m_name ) || !AreBytesLeftInChunk( reader, chunkEnd, 4 ) )
+		{
+			return nullptr;
+		}
+		joint.m_parentIndex = reader.ParseInt32();
+		if ( joint.m_parentIndex < -1 || joint.m_parentIndex >= ( int ) numJoints )
+		{
+			return nullptr;
+		}
+	}
+
+	// a loop of parents would never reach the root
+	for ( SkeletonJoint const& joint : joints )
+	{
+		int		 parentIndex = joint.m_parentIndex;
+		uint32_t depth		 = 0;
+		for ( ; parentIndex >= 0 && depth <= numJoints; depth++ )
+		{
+			parentIndex = joints[ parentIndex ].m_parentIndex;
+		}
+		if ( depth > numJoints )
+		{
+			return nullptr;
+		}
+	}
+
+	std::vector<Transform> bindLocalTransforms;
+	if ( !ParseArray( reader, chunkEnd, bindLocalTransforms ) || bindLocalTransforms.size() != joints.size() )
+	{
+		return nullptr;
+	}
+	for ( uint32_t jointIndex = 0; jointIndex < numJoints; jointIndex++ )
+	{
+		joints[ jointIndex ].m_bindLocalTransform = bindLocalTransforms[ jointIndex ];
+	}
+
+	return std::make_shared<Skeleton const>( joints );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static void AppendClip( BufferWriter& writer, AnimClip const& clip )
+{
+	writer.AppendStringAfter32BitLength( clip.m_name.c_str() );
+	writer.AppendBool( clip.m_isLooping );
+	writer.AppendBool( clip.m_removeRootMotion );
+	writer.AppendUnsignedInt( ( uint32_t ) clip.m_animChannels.size() );
+	for ( AnimChannel const& channel : clip.m_animChannels )
+	{
+		writer.AppendInt( channel.m_jointId );
+		writer.AppendStringAfter32BitLength( channel.m_jointName.c_str() );
+		writer.AppendByte( ( uint8_t ) channel.m_playbackType );
+		AppendCurve( writer, channel.m_positionCurve );
+		AppendCurve( writer, channel.m_rotationCurve );
+		AppendCurve( writer, channel.m_scaleCurve );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Sampling a clip indexes the pose by joint id, so a channel past the end of the skeleton would read and write past its streams
+static bool AreClipJointIdsInSkeleton( std::vector<AnimClip> const& clips, Skeleton const& skeleton )
+{
+	for ( AnimClip const& clip : clips )
+	{
+		for ( AnimChannel const& channel : clip.m_animChannels )
+		{
+			if ( channel.m_jointId >= skeleton.GetNumberOfJoints() )
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static bool ParseClip( BufferReader& reader, size_t chunkEnd, AnimClip& outClip )
+{
+	if ( !ParseString( reader, chunkEnd, outClip.m_name ) || !AreBytesLeftInChunk( reader, chunkEnd, 1 + 1 + 4 ) )
+	{
+		return false;
+	}
+
+	outClip.m_isLooping		   = reader.ParseBool();
+	outClip.m_removeRootMotion = reader.ParseBool();
+	uint32_t numChannels	   = reader.ParseUint32();
+	if ( !AreBytesLeftInChunk( reader, chunkEnd, ( size_t ) numChannels * ANIM_CACHE_MIN_CHANNEL_SIZE ) )
+	{
+		return false;
+	}
+
+	outClip.m_animChannels.resize( numChannels );
+	for ( AnimChannel& channel : outClip.m_animChannels )
+	{
+		if ( !AreBytesLeftInChunk( reader, chunkEnd, 4 ) )
+		{
+			return false;
+		}
+		channel.m_jointId = reader.ParseInt32();
+		if ( channel.m_jointId < 0 )
+		{
+			return false;
+		}
+
+		if ( !ParseString( reader, chunkEnd, channel.m_jointName ) || !AreBytesLeftInChunk( reader, chunkEnd, 1 ) )
+		{
+			return false;
+		}
+		channel.m_playbackType = ( AnimPlaybackType ) reader.ParseByte();
+
+		if ( !ParseCurve( reader, chunkEnd, channel.m_positionCurve ) || !ParseCurve( reader, chunkEnd, channel.m_rotationCurve ) ||
+			 !ParseCurve( reader, chunkEnd, channel.m_scaleCurve ) )
+		{
+			return false;
+		}
+	}
+	outClip.CalculateTimeStamps();
+	return true;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// the joint and weight pairs of every vertex go flat, with a count per vertex
+static void AppendSkinnedMesh( BufferWriter& writer, AnimCacheSkinnedMesh const& mesh )
+{
+	writer.AppendStringAfter32BitLength( mesh.m_name.c_str() );
+	AppendArray( writer, mesh.m_vertexes );
+
+	std::vector<uint16_t> numInfluencesByVertex;
+	std::vector<int>	  jointIds;
+	std::vector<float>	  weights;
+	numInfluencesByVertex.reserve( mesh.m_jointAndWeightsMapping.size() );
+	for ( std::vector<std::pair<int, float>> const& influences : mesh.m_jointAndWeightsMapping )
+	{
+		numInfluencesByVertex.push_back( ( uint16_t ) influences.size() );
+		for ( std::pair<int, float> const& influence : influences )
+		{
+			jointIds.push_back( influence.first );
+			weights.push_back( influence.second );
+		}
+	}
+	AppendArray( writer, numInfluencesByVertex );
+	AppendArray( writer, jointIds );
+	AppendArray( writer, weights );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static bool ParseSkinnedMesh( BufferReader& reader, size_t chunkEnd, AnimCacheSkinnedMesh& outMesh )
+{
+	if ( !ParseString( reader, chunkEnd, outMesh.m_name ) || !ParseArray( reader, chunkEnd, outMesh.m_vertexes ) )
+	{
+		return false;
+	}
+
+	std::vector<uint16_t> numInfluencesByVertex;
+	std::vector<int>	  jointIds;
+	std::vector<float>	  weights;
+	if ( !ParseArray( reader, chunkEnd, numInfluencesByVertex ) || !ParseArray( reader, chunkEnd, jointIds ) || !ParseArray( reader, chunkEnd, weights ) ||
+		 jointIds.size() != weights.size() )
+	{
+		return false;
+	}
+
+	outMesh.m_jointAndWeightsMapping.resize( numInfluencesByVertex.size() );
+	size_t influenceIndex = 0;
+	for ( size_t vertexIndex = 0; vertexIndex < numInfluencesByVertex.size(); vertexIndex++ )
+	{
+		int numInfluences = numInfluencesByVertex[ vertexIndex ];
+		if ( influenceIndex + numInfluences > jointIds.size() )
+		{
+			return false;
+		}
+
+		std::vector<std::pair<int, float>>& influences = outMesh.m_jointAndWeightsMapping[ vertexIndex ];
+		influences.reserve( numInfluences );
+		for ( int index = 0; index < numInfluences; index++, influenceIndex++ )
+		{
+			influences.emplace_back( jointIds[ influenceIndex ], weights[ influenceIndex ] );
+		}
+	}
+	return true;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// type, then the payload size patched in once the payload is written
+template <typename AppendPayloadFunction>
+static void AppendChunk( BufferWriter& writer, AnimCacheChunkType chunkType, AppendPayloadFunction appendPayload )
+{
+	writer.AppendUnsignedInt( chunkType );
+	size_t sizeOffset = writer.m_buffer.size();
+	writer.AppendUnsignedInt( 0 );
+
+	appendPayload();
+
+	uint32_t payloadSize = ( uint32_t ) ( writer.m_buffer.size() - sizeOffset - 4 );
+	memcpy( writer.m_buffer.data() + sizeOffset, &payloadSize, 4 );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+bool AnimAssetCache::SaveToFile( AnimCacheContents const& contents, std::string const& cacheFilename )
+{
+	uint32_t numChunks = ( contents.m_skeleton ? 1 : 0 ) + ( uint32_t ) contents.m_clips.size() + ( uint32_t ) contents.m_skinnedMeshes.size();
+
+	Buffer		 buffer;
+	BufferWriter writer( buffer, GetPlatformEndianness() );
+	writer.AppendBytes( ANIM_CACHE_MAGIC, 4 );
+	writer.AppendUnsignedInt( ANIM_CACHE_VERSION );
+	writer.AppendByte( ( uint8_t ) GetPlatformEndianness() );
+	writer.AppendUnsignedInt( numChunks );
+
+	if ( contents.m_skeleton )
+	{
+		AppendChunk( writer, ANIM_CACHE_CHUNK_SKELETON, [ & ]() { AppendSkeleton( writer, *contents.m_skeleton ); } );
+	}
+	for ( AnimClip const& clip : contents.m_clips )
+	{
+		AppendChunk( writer, ANIM_CACHE_CHUNK_CLIP, [ & ]() { AppendClip( writer, clip ); } );
+	}
+	for ( AnimCacheSkinnedMesh const& mesh : contents.m_skinnedMeshes )
+	{
+		AppendChunk( writer, ANIM_CACHE_CHUNK_SKINNED_MESH, [ & ]() { AppendSkinnedMesh( writer, mesh ); } );
+	}
+
+	return FileWriteFromBuffer( buffer, cacheFilename ) != 0;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+bool AnimAssetCache::LoadFromFile( std::string const& cacheFilename, AnimCacheContents& outContents, uint32_t chunkTypesToLoad )
+{
+	outContents = AnimCacheContents();
+
+	MemoryFile memoryFile( cacheFilename.c_str() );
+	if ( !memoryFile || memoryFile.size() < ANIM_CACHE_HEADER_SIZE )
+	{
+		return false;
+	}
+
+	BufferReader reader( memoryFile.data(), memoryFile.size(), GetPlatformEndianness() );
+	char		 magic[ 4 ];
+	reader.ParseBytes( magic, 4 );
+	uint32_t version	= reader.ParseUint32();
+	uint8_t	 endianness = reader.ParseByte();
+	if ( memcmp( magic, ANIM_CACHE_MAGIC, 4 ) != 0 || version != ANIM_CACHE_VERSION || endianness != ( uint8_t ) GetPlatformEndianness() )
+	{
+		DebuggerPrintf( "Anim cache %s is from another version or platform, ignoring it\n", cacheFilename.c_str() );
+		return false;
+	}
+
+	// clip joint ids are checked against the skeleton, so it's parsed whenever clips are, wherever its chunk is
+	uint32_t chunkTypesToParse = chunkTypesToLoad;
+	if ( ( chunkTypesToLoad & ANIM_CACHE_CHUNK_CLIP ) != 0 )
+	{
+		chunkTypesToParse |= ANIM_CACHE_CHUNK_SKELETON;
+	}
+
+	uint32_t numChunks = reader.ParseUint32();
+	for ( uint32_t chunkIndex = 0; chunkIndex < numChunks; chunkIndex++ )
+	{
+		if ( reader.m_currentOffsetFromStart + ANIM_CACHE_CHUNK_HEADER > reader.m_bufferSize )
+		{
+			return false;
+		}
+		uint32_t chunkType	 = reader.ParseUint32();
+		uint32_t payloadSize = reader.ParseUint32();
+		size_t	 chunkEnd	 = reader.m_currentOffsetFromStart + payloadSize;
+		if ( chunkEnd > reader.m_bufferSize )
+		{
+			return false;
+		}
+
+		if ( ( chunkType & chunkTypesToParse ) != 0 )
+		{
+			bool isChunkValid = true;
+			if ( chunkType == ANIM_CACHE_CHUNK_SKELETON )
+			{
+				outContents.m_skeleton = ParseSkeleton( reader, chunkEnd );
+				isChunkValid		   = outContents.m_skeleton != nullptr;
+			}
+			else if ( chunkType == ANIM_CACHE_CHUNK_CLIP )
+			{
+				outContents.m_clips.emplace_back();
+				isChunkValid = ParseClip( reader, chunkEnd, outContents.m_clips.back() );
+			}
+			else if ( chunkType == ANIM_CACHE_CHUNK_SKINNED_MESH )
+			{
+				outContents.m_skinnedMeshes.emplace_back();
+				isChunkValid = ParseSkinnedMesh( reader, chunkEnd, outContents.m_skinnedMeshes.back() );
+			}
+
+			if ( !isChunkValid )
+			{
+				DebuggerPrintf( "Anim cache %s is corrupt, ignoring it\n", cacheFilename.c_str() );
+				outContents = AnimCacheContents();
+				return false;
+			}
+		}
+
+		// skips chunks that weren't asked for and chunk types this version doesn't know
+		reader.m_currentOffsetFromStart = chunkEnd;
+	}
+
+	// without a skeleton in the file there is nothing to check the joint ids against
+	if ( outContents.m_skeleton && !AreClipJointIdsInSkeleton( outContents.m_clips, *outContents.m_skeleton ) )
+	{
+		DebuggerPrintf( "Anim cache %s has a clip channel past the end of its skeleton, ignoring it\n", cacheFilename.c_str() );
+		outContents = AnimCacheContents();
+		return false;
+	}
+	if ( ( chunkTypesToLoad & ANIM_CACHE_CHUNK_SKELETON ) == 0 )
+	{
+		outContents.m_skeleton = nullptr;
+	}
+
+	return true;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void AnimAssetCache::LoadAnimClip( char const* fbxFilename, AnimClip& outClip )
+{
+	double startTime = GetCurrentTimeSeconds();
+
+	AnimCacheContents contents;
+	if ( IsCacheUsable( fbxFilename ) && LoadFromFile( GetCacheFilename( fbxFilename ), contents, ANIM_CACHE_CHUNK_CLIP ) && !contents.m_clips.empty() )
+	{
+		outClip = std::move( contents.m_clips[ 0 ] );
+		DebuggerPrintf( "Anim Clip Cache Loading Time: %f\n", ( GetCurrentTimeSeconds() - startTime ) * 1000.0 );
+		return;
+	}
+
+	FbxFileImporter::LoadAnimClipFromFile( fbxFilename, outClip );
+	DebuggerPrintf( "Anim Clip Fbx Import Time: %f\n", ( GetCurrentTimeSeconds() - startTime ) * 1000.0 );
+
+	if ( !outClip.m_animChannels.empty() )
+	{
+		contents.m_clips.push_back( outClip );
+		AddToCache( fbxFilename, std::move( contents ), ANIM_CACHE_CHUNK_CLIP );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void AnimAssetCache::LoadRestPose( char const* fbxFilename, AnimPose& outPose )
+{
+	double startTime = GetCurrentTimeSeconds();
+
+	AnimCacheContents contents;
+	if ( IsCacheUsable( fbxFilename ) && LoadFromFile( GetCacheFilename( fbxFilename ), contents, ANIM_CACHE_CHUNK_SKELETON ) && contents.m_skeleton )
+	{
+		outPose = AnimPose( contents.m_skeleton );
+		DebuggerPrintf( "Rest Pose Cache Loading Time: %f\n", ( GetCurrentTimeSeconds() - startTime ) * 1000.0 );
+		return;
+	}
+
+	FbxFileImporter::LoadRestPoseFromFile( fbxFilename, outPose );
+	DebuggerPrintf( "Rest Pose Fbx Import Time: %f\n", ( GetCurrentTimeSeconds() - startTime ) * 1000.0 );
+
+	if ( outPose.GetSkeleton() )
+	{
+		contents.m_skeleton = outPose.GetSkeleton();
+		AddToCache( fbxFilename, std::move( contents ), ANIM_CACHE_CHUNK_SKELETON );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// appends to the outputs, same as FbxFileImporter::LoadPreRiggedAndPreSkinnedMeshBindPoseFromFile()
+void AnimAssetCache::LoadSkinnedMesh( char const* fbxFilename, std::vector<Vertex_PCUTBN>& outVerts, std::vector<std::vector<std::pair<int, float>>>& outJointAndWeightsMapping )
+{
+	double startTime = GetCurrentTimeSeconds();
+
+	AnimCacheContents contents;
+	if ( IsCacheUsable( fbxFilename ) && LoadFromFile( GetCacheFilename( fbxFilename ), contents, ANIM_CACHE_CHUNK_SKINNED_MESH ) && !contents.m_skinnedMeshes.empty() )
+	{
+		AnimCacheSkinnedMesh& mesh = contents.m_skinnedMeshes[ 0 ];
+		outVerts.insert( outVerts.end(), mesh.m_vertexes.begin(), mesh.m_vertexes.end() );
+		outJointAndWeightsMapping.insert( outJointAndWeightsMapping.end(), std::make_move_iterator( mesh.m_jointAndWeightsMapping.begin() ),
+			std::make_move_iterator( mesh.m_jointAndWeightsMapping.end() ) );
+		DebuggerPrintf( "Skinned Mesh Cache Loading Time: %f\n", ( GetCurrentTimeSeconds() - startTime ) * 1000.0 );
+		return;
+	}
+
+	AnimCacheSkinnedMesh mesh;
+	mesh.m_name = fbxFilename;
+	FbxFileImporter::LoadPreRiggedAndPreSkinnedMeshBindPoseFromFile( fbxFilename, mesh.m_vertexes, mesh.m_jointAndWeightsMapping );
+	DebuggerPrintf( "Skinned Mesh Fbx Import Time: %f\n", ( GetCurrentTimeSeconds() - startTime ) * 1000.0 );
+
+	outVerts.insert( outVerts.end(), mesh.m_vertexes.begin(), mesh.m_vertexes.end() );
+	outJointAndWeightsMapping.insert( outJointAndWeightsMapping.end(), mesh.m_jointAndWeightsMapping.begin(), mesh.m_jointAndWeightsMapping.end() );
+
+	if ( !mesh.m_vertexes.empty() )
+	{
+		contents.m_skinnedMeshes.push_back( std::move( mesh ) );
+		AddToCache( fbxFilename, std::move( contents ), ANIM_CACHE_CHUNK_SKINNED_MESH );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+std::string AnimAssetCache::GetCacheFilename( char const* fbxFilename )
+{
+	return std::string( fbxFilename ) + ANIM_CACHE_FILE_EXTENSION;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// a cache without its FBX is what ships where there is no FBX SDK, so it's always usable
+bool AnimAssetCache::IsCacheUsable( char const* fbxFilename )
+{
+	std::error_code errorCode;
+	auto			cacheWriteTime = std::filesystem::last_write_time( GetCacheFilename( fbxFilename ), errorCode );
+	if ( errorCode )
+	{
+		return false;
+	}
+
+	auto fbxWriteTime = std::filesystem::last_write_time( fbxFilename, errorCode );
+	if ( errorCode )
+	{
+		return true;
+	}
+
+	return cacheWriteTime >= fbxWriteTime;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// newContents replaces the chunks of newChunkType in the cache and keeps the others, unless they are out of date
+void AnimAssetCache::AddToCache( char const* fbxFilename, AnimCacheContents&& newContents, uint32_t newChunkType )
+{
+	std::string		  cacheFilename = GetCacheFilename( fbxFilename );
+	AnimCacheContents contents;
+	if ( IsCacheUsable( fbxFilename ) )
+	{
+		LoadFromFile( cacheFilename, contents );
+	}
+
+	if ( newChunkType == ANIM_CACHE_CHUNK_SKELETON )
+	{
+		contents.m_skeleton = newContents.m_skeleton;
+	}
+	else if ( newChunkType == ANIM_CACHE_CHUNK_CLIP )
+	{
+		contents.m_clips = std::move( newContents.m_clips );
+	}
+	else if ( newChunkType == ANIM_CACHE_CHUNK_SKINNED_MESH )
+	{
+		contents.m_skinnedMeshes = std::move( newContents.m_skinnedMeshes );
+	}
+
+	if ( !SaveToFile( contents, cacheFilename ) )
+	{
+		DebuggerPrintf( "Failed to write anim cache %s\n", cacheFilename.c_str() );
+	}
+}
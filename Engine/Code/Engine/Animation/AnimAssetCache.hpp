@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Engine/Animation/AnimClip.hpp"
+#include "Engine/Animation/Skeleton.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+class AnimPose;
+
+
+//----------------------------------------------------------------------------------------------------------
+constexpr uint32_t	  ANIM_CACHE_VERSION		= 1; // bump whenever the layout of any chunk changes
+constexpr char const* ANIM_CACHE_FILE_EXTENSION = ".animcache";
+
+
+//----------------------------------------------------------------------------------------------------------
+enum AnimCacheChunkType : uint32_t
+{
+	ANIM_CACHE_CHUNK_SKELETON	  = 1 << 0,
+	ANIM_CACHE_CHUNK_CLIP		  = 1 << 1,
+	ANIM_CACHE_CHUNK_SKINNED_MESH = 1 << 2,
+	ANIM_CACHE_ALL_CHUNKS		  = 0xFFFFFFFF,
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct AnimCacheSkinnedMesh
+{
+	std::string										m_name;
+	std::vector<Vertex_PCUTBN>						m_vertexes;
+	std::vector<std::vector<std::pair<int, float>>> m_jointAndWeightsMapping; // by vertex
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct AnimCacheContents
+{
+	std::shared_ptr<Skeleton const>	  m_skeleton; // null if the file has none
+	std::vector<AnimClip>			  m_clips;
+	std::vector<AnimCacheSkinnedMesh> m_skinnedMeshes;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Skeletons, clips and skinned meshes cooked out of FBX files into a versioned binary file.
+// The file is a header followed by chunks; keyframes, bind transforms and vertexes are stored
+// as the memory images of their arrays, so loading is one file read and a copy per array.
+// Files are written in the endianness of the machine that cooked them and are only loaded there.
+//
+// The Load functions use the cache next to an FBX ( the FBX file name + ANIM_CACHE_FILE_EXTENSION )
+// while it's newer than the FBX, or on its own when the FBX isn't there; otherwise they import the
+// FBX and add what they imported to the cache
+class AnimAssetCache
+{
+public:
+	static bool SaveToFile( AnimCacheContents const& contents, std::string const& cacheFilename );
+	static bool LoadFromFile( std::string const& cacheFilename, AnimCacheContents& outContents, uint32_t chunkTypesToLoad = ANIM_CACHE_ALL_CHUNKS ); // false if missing, out of date or from another endianness
+
+	static void LoadAnimClip( char const* fbxFilename, AnimClip& outClip );
+	static void LoadRestPose( char const* fbxFilename, AnimPose& outPose );
+	static void LoadSkinnedMesh( char const* fbxFilename, std::vector<Vertex_PCUTBN>& outVerts, std::vector<std::vector<std::pair<int, float>>>& outJointAndWeightsMapping );
+
+	static std::string GetCacheFilename( char const* fbxFilename );
+
+protected:
+	static bool IsCacheUsable( char const* fbxFilename );
+	static void AddToCache( char const* fbxFilename, AnimCacheContents&& newContents, uint32_t newChunkType );
+};
@@ -0,0 +1,219 @@
+#include "Engine/Animation/AnimAssetCacheBenchmark.hpp"
+#include "Engine/Animation/AnimAssetCache.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <filesystem>
+#include <math.h>
+#include <string.h>
+
+
+//----------------------------------------------------------------------------------------------------------
+constexpr char const* ANIM_CACHE_BENCHMARK_FILE_NAME = "AnimAssetCacheBenchmark.animcache";
+
+
+//----------------------------------------------------------------------------------------------------------
+static void LogToDevConsole( Rgba8 const& color, std::string const& text )
+{
+	if ( g_theDevConsole )
+	{
+		g_theDevConsole->AddLine( color, text );
+	}
+	else
+	{
+		DebuggerPrintf( "%s\n", text.c_str() );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static void BuildBenchmarkContents( AnimCacheContents& contents, AnimAssetCacheBenchmarkSettings const& settings )
+{
+	std::vector<SkeletonJoint> joints( settings.m_numJoints );
+	for ( int jointId = 0; jointId < settings.m_numJoints; jointId++ )
+	{
+		joints[ jointId ].m_name			   = Stringf( "Joint%d", jointId );
+		joints[ jointId ].m_parentIndex		   = jointId - 1;
+		joints[ jointId ].m_bindLocalTransform = Transform( Vec3( 10.f, 0.f, 0.f ), Quaternion::IDENTITY, Vec3( 1.f, 1.f, 1.f ) );
+	}
+	contents.m_skeleton = std::make_shared<Skeleton const>( joints );
+
+	int	  numKeyframes		 = ( int ) ( settings.m_clipSeconds * settings.m_keyframeRateHz ) + 1;
+	float keyframeDurationMs = 1000.f / settings.m_keyframeRateHz;
+	Vec3  swingAxis			 = Vec3( 0.f, 0.6f, 0.8f );
+
+	contents.m_clips.emplace_back();
+	AnimClip& clip	 = contents.m_clips.back();
+	clip.m_name		 = "AnimCacheBench.fbx";
+	clip.m_isLooping = true;
+	for ( int jointId = 0; jointId < settings.m_numJoints; jointId++ )
+	{
+		AnimChannel& channel = clip.CreateOrGetAnimChannel( jointId );
+		channel.m_jointName	 = joints[ jointId ].m_name;
+		for ( int keyframeIndex = 0; keyframeIndex < numKeyframes; keyframeIndex++ )
+		{
+			float timeMs  = ( float ) keyframeIndex * keyframeDurationMs;
+			float seconds = timeMs / 1000.f;
+			channel.m_positionCurve.m_keyframes.push_back( { timeMs, Vec3( 10.f + sinf( seconds + ( float ) jointId ), 0.f, 0.f ) } );
+			channel.m_rotationCurve.m_keyframes.push_back( { timeMs, Quaternion::MakeFromAxisOfRotationAndAngleDegrees( swingAxis, 40.f * sinf( 3.f * seconds + 0.3f * ( float ) jointId ) ) } );
+			channel.m_scaleCurve.m_keyframes.push_back( { timeMs, Vec3( 1.f, 1.f, 1.f ) } );
+		}
+	}
+	clip.CalculateTimeStamps();
+
+	contents.m_skinnedMeshes.emplace_back();
+	AnimCacheSkinnedMesh& mesh = contents.m_skinnedMeshes.back();
+	mesh.m_name				   = "AnimCacheBench.fbx";
+	mesh.m_vertexes.resize( settings.m_numVertexes );
+	mesh.m_jointAndWeightsMapping.resize( settings.m_numVertexes );
+	for ( int vertexIndex = 0; vertexIndex < settings.m_numVertexes; vertexIndex++ )
+	{
+		mesh.m_vertexes[ vertexIndex ].m_position	 = Vec3( ( float ) vertexIndex, 1.f, 2.f );
+		mesh.m_vertexes[ vertexIndex ].m_normal		 = Vec3( 0.f, 0.f, 1.f );
+		mesh.m_jointAndWeightsMapping[ vertexIndex ] = { { vertexIndex % settings.m_numJoints, 0.7f }, { ( vertexIndex + 1 ) % settings.m_numJoints, 0.3f } };
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+template <typename T_Keyframe>
+static bool AreKeyframesIdentical( std::vector<T_Keyframe> const& keyframesA, std::vector<T_Keyframe> const& keyframesB )
+{
+	return keyframesA.size() == keyframesB.size() && memcmp( keyframesA.data(), keyframesB.data(), keyframesA.size() * sizeof( T_Keyframe ) ) == 0;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static bool AreContentsIdentical( AnimCacheContents const& saved, AnimCacheContents const& loaded )
+{
+	if ( !loaded.m_skeleton || loaded.m_skeleton->GetNumberOfJoints() != saved.m_skeleton->GetNumberOfJoints() ||
+		 loaded.m_clips.size() != saved.m_clips.size() || loaded.m_skinnedMeshes.size() != saved.m_skinnedMeshes.size() )
+	{
+		return false;
+	}
+
+	for ( int jointId = 0; jointId < saved.m_skeleton->GetNumberOfJoints(); jointId++ )
+	{
+		if ( loaded.m_skeleton->GetJointName( jointId ) != saved.m_skeleton->GetJointName( jointId ) ||
+			 loaded.m_skeleton->GetParentOfJoint( jointId ) != saved.m_skeleton->GetParentOfJoint( jointId ) )
+		{
+			return false;
+		}
+	}
+
+	for ( size_t clipIndex = 0; clipIndex < saved.m_clips.size(); clipIndex++ )
+	{
+		AnimClip const& savedClip  = saved.m_clips[ clipIndex ];
+		AnimClip const& loadedClip = loaded.m_clips[ clipIndex ];
+		if ( loadedClip.m_name != savedClip.m_name || loadedClip.m_isLooping != savedClip.m_isLooping || loadedClip.GetEndTime() != savedClip.GetEndTime() ||
+			 loadedClip.m_animChannels.size() != savedClip.m_animChannels.size() )
+		{
+			return false;
+		}
+		for ( size_t channelIndex = 0; channelIndex < savedClip.m_animChannels.size(); channelIndex++ )
+		{
+			AnimChannel const& savedChannel	 = savedClip.m_animChannels[ channelIndex ];
+			AnimChannel const& loadedChannel = loadedClip.m_animChannels[ channelIndex ];
+			if ( loadedChannel.m_jointId != savedChannel.m_jointId || loadedChannel.m_jointName != savedChannel.m_jointName ||
+				 !AreKeyframesIdentical( loadedChannel.m_positionCurve.m_keyframes, savedChannel.m_positionCurve.m_keyframes ) ||
+				 !AreKeyframesIdentical( loadedChannel.m_rotationCurve.m_keyframes, savedChannel.m_rotationCurve.m_keyframes ) ||
+				 !AreKeyframesIdentical( loadedChannel.m_scaleCurve.m_keyframes, savedChannel.m_scaleCurve.m_keyframes ) )
+			{
+				return false;
+			}
+		}
+	}
+
+	for ( size_t meshIndex = 0; meshIndex < saved.m_skinnedMeshes.size(); meshIndex++ )
+	{
+		AnimCacheSkinnedMesh const& savedMesh  = saved.m_skinnedMeshes[ meshIndex ];
+		AnimCacheSkinnedMesh const& loadedMesh = loaded.m_skinnedMeshes[ meshIndex ];
+		if ( loadedMesh.m_name != savedMesh.m_name || loadedMesh.m_vertexes.size() != savedMesh.m_vertexes.size() ||
+			 loadedMesh.m_jointAndWeightsMapping != savedMesh.m_jointAndWeightsMapping )
+		{
+			return false;
+		}
+		for ( size_t vertexIndex = 0; vertexIndex < savedMesh.m_vertexes.size(); vertexIndex++ )
+		{
+			if ( loadedMesh.m_vertexes[ vertexIndex ].m_position != savedMesh.m_vertexes[ vertexIndex ].m_position ||
+				 loadedMesh.m_vertexes[ vertexIndex ].m_normal != savedMesh.m_vertexes[ vertexIndex ].m_normal )
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+AnimAssetCacheBenchmarkResult RunAnimAssetCacheBenchmark( AnimAssetCacheBenchmarkSettings const& settings )
+{
+	AnimCacheContents savedContents;
+	BuildBenchmarkContents( savedContents, settings );
+
+	AnimAssetCacheBenchmarkResult result;
+	double						  startSeconds = GetCurrentTimeSeconds();
+	bool						  didSave	   = AnimAssetCache::SaveToFile( savedContents, ANIM_CACHE_BENCHMARK_FILE_NAME );
+	result.m_saveMilliseconds				   = ( GetCurrentTimeSeconds() - startSeconds ) * 1000.0;
+	if ( !didSave )
+	{
+		return result;
+	}
+
+	std::error_code errorCode;
+	result.m_fileBytes = std::filesystem::file_size( ANIM_CACHE_BENCHMARK_FILE_NAME, errorCode );
+
+	result.m_loadMilliseconds		  = 1.0e9;
+	result.m_loadClipOnlyMilliseconds = 1.0e9;
+	for ( int loadIndex = 0; loadIndex < settings.m_numLoads; loadIndex++ )
+	{
+		AnimCacheContents loadedContents;
+		startSeconds = GetCurrentTimeSeconds();
+		AnimAssetCache::LoadFromFile( ANIM_CACHE_BENCHMARK_FILE_NAME, loadedContents );
+		result.m_loadMilliseconds = fmin( result.m_loadMilliseconds, ( GetCurrentTimeSeconds() - startSeconds ) * 1000.0 );
+
+		AnimCacheContents loadedClipContents;
+		startSeconds = GetCurrentTimeSeconds();
+		AnimAssetCache::LoadFromFile( ANIM_CACHE_BENCHMARK_FILE_NAME, loadedClipContents, ANIM_CACHE_CHUNK_CLIP );
+		result.m_loadClipOnlyMilliseconds = fmin( result.m_loadClipOnlyMilliseconds, ( GetCurrentTimeSeconds() - startSeconds ) * 1000.0 );
+	}
+
+	AnimCacheContents loadedContents;
+	result.m_didRoundTrip = AnimAssetCache::LoadFromFile( ANIM_CACHE_BENCHMARK_FILE_NAME, loadedContents ) && AreContentsIdentical( savedContents, loadedContents );
+
+	std::filesystem::remove( ANIM_CACHE_BENCHMARK_FILE_NAME, errorCode );
+	return result;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+bool Command_AnimCacheBench( EventArgs& args )
+{
+	AnimAssetCacheBenchmarkSettings settings;
+	settings.m_numJoints   = args.GetValue( "Joints", settings.m_numJoints );
+	settings.m_numVertexes = args.GetValue( "Vertexes", settings.m_numVertexes );
+	if ( settings.m_numJoints < 1 || settings.m_numVertexes < 0 )
+	{
+		LogToDevConsole( DevConsole::ERROR_COLOR, "AnimCacheBench: Joints has to be at least 1 and Vertexes at least 0" );
+		return true;
+	}
+
+	AnimAssetCacheBenchmarkResult result = RunAnimAssetCacheBenchmark( settings );
+	if ( result.m_fileBytes == 0 )
+	{
+		LogToDevConsole( DevConsole::ERROR_COLOR, Stringf( "AnimCacheBench: could not write %s", ANIM_CACHE_BENCHMARK_FILE_NAME ) );
+		return true;
+	}
+
+	Rgba8 color = result.m_didRoundTrip ? DevConsole::INFO_MAJOR_COLOR : DevConsole::ERROR_COLOR;
+	LogToDevConsole( color, Stringf( "AnimCacheBench: %d joints, %.1f seconds keyed at %.0fHz, %d vertexes; %llu bytes, %s", settings.m_numJoints,
+		settings.m_clipSeconds, settings.m_keyframeRateHz, settings.m_numVertexes, ( unsigned long long ) result.m_fileBytes,
+		result.m_didRoundTrip ? "loads back identical" : "LOADS BACK DIFFERENT" ) );
+	LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "  ms: save %.2f, load %.2f, load the clip only %.2f", result.m_saveMilliseconds,
+		result.m_loadMilliseconds, result.m_loadClipOnlyMilliseconds ) );
+	return true;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <cstdint>
+
+
+//----------------------------------------------------------------------------------------------------------
+struct AnimAssetCacheBenchmarkSettings
+{
+	int	  m_numJoints	   = 60;
+	float m_clipSeconds	   = 10.f;
+	float m_keyframeRateHz = 30.f;
+	int	  m_numVertexes	   = 30000; // in the skinned mesh, each weighted to two joints
+	int	  m_numLoads	   = 50;	// the fastest load is reported
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct AnimAssetCacheBenchmarkResult
+{
+	uintmax_t m_fileBytes				 = 0;
+	double	  m_saveMilliseconds		 = 0.0;
+	double	  m_loadMilliseconds		 = 0.0; // skeleton, clip and skinned mesh, file read included
+	double	  m_loadClipOnlyMilliseconds = 0.0;
+	bool	  m_didRoundTrip			 = false; // what was loaded is what was saved
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Saves a skeleton, a clip and a skinned mesh to a cache file in the working directory, times loading
+// it whole and loading just the clip chunk, checks the loaded contents against the saved ones, and
+// deletes the file
+AnimAssetCacheBenchmarkResult RunAnimAssetCacheBenchmark( AnimAssetCacheBenchmarkSettings const& settings );
+
+// "AnimCacheBench Joints=60 Vertexes=30000"; logs the file size and milliseconds per save and load
+// DevConsole::Startup() subscribes it
+bool Command_AnimCacheBench( EventArgs& args );
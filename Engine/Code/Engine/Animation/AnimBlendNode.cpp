@@ -39,9 +39,9 @@ void AnimPoseNode::Update( float parametricZeroToOne )
 
 
 //----------------------------------------------------------------------------------------------------------
-AnimPose const AnimPoseNode::Evaluate()
+void AnimPoseNode::AppendInstructions( std::vector<AnimBlendInstruction>& out_instructions )
 {
-	return m_pose;
+	out_instructions.push_back( { AnimBlendInstructionType::PUSH_POSE, this } );
 }
 
 
@@ -76,13 +76,13 @@ void BinaryLerpBlendNode::Update( float parametricZeroToOne )
 
 
 //----------------------------------------------------------------------------------------------------------
-AnimPose const BinaryLerpBlendNode::Evaluate()
+void BinaryLerpBlendNode::AppendInstructions( std::vector<AnimBlendInstruction>& out_instructions )
 {
-	AnimPose const& poseA = m_childNodeA->Evaluate();
-	AnimPose const& poseB = m_childNodeB->Evaluate();
-	AnimPose::Blend( m_blendedPose, poseA, poseB, m_blendValue, -1 );
+	GUARANTEE_OR_DIE( m_childNodeA != nullptr && m_childNodeB != nullptr, "BinaryLerpBlendNode needs both children before the tree is compiled" );
 
-	return m_blendedPose;
+	m_childNodeA->AppendInstructions( out_instructions );
+	m_childNodeB->AppendInstructions( out_instructions );
+	out_instructions.push_back( { m_jointMask != nullptr ? AnimBlendInstructionType::MASKED_BLEND : AnimBlendInstructionType::BLEND, this } );
 }
 
 
@@ -148,11 +148,9 @@ void AnimClipNode::Update( float parametricZeroToOne )
 
 
 //----------------------------------------------------------------------------------------------------------
-AnimPose const AnimClipNode::Evaluate()
+void AnimClipNode::AppendInstructions( std::vector<AnimBlendInstruction>& out_instructions )
 {
-	m_animClip.Sample( m_localTimeMs, m_sampledPose );
-
-	return m_sampledPose;
+	out_instructions.push_back( { AnimBlendInstructionType::SAMPLE_CLIP, this } );
 }
 
 
@@ -161,3 +159,54 @@ void AnimClipNode::AddChild( AnimBlendNode* childNode )
 {
 	UNUSED( childNode );
 }
+
+
+//----------------------------------------------------------------------------------------------------------
+// AdditiveBlendNode
+//----------------------------------------------------------------------------------------------------------
+AdditiveBlendNode::AdditiveBlendNode()
+{
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+AdditiveBlendNode::~AdditiveBlendNode()
+{
+	m_baseNode	   = nullptr;
+	m_additiveNode = nullptr;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void AdditiveBlendNode::Update( float parametricZeroToOne )
+{
+	m_blendValue = parametricZeroToOne;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void AdditiveBlendNode::AppendInstructions( std::vector<AnimBlendInstruction>& out_instructions )
+{
+	GUARANTEE_OR_DIE( m_baseNode != nullptr && m_additiveNode != nullptr, "AdditiveBlendNode needs a base and an additive child before the tree is compiled" );
+
+	m_baseNode->AppendInstructions( out_instructions );
+	m_additiveNode->AppendInstructions( out_instructions );
+	out_instructions.push_back( { AnimBlendInstructionType::ADDITIVE, this } );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void AdditiveBlendNode::AddChild( AnimBlendNode* childNode )
+{
+	UNUSED( childNode );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void AdditiveBlendNode::ClearChildren()
+{
+	delete m_baseNode;
+	delete m_additiveNode;
+	m_baseNode	   = nullptr;
+	m_additiveNode = nullptr;
+}
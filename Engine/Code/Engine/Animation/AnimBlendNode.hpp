@@ -1,14 +1,44 @@
 #pragma once
 
 
+#include "Engine/Animation/AnimClip.hpp"
+#include "Engine/Animation/AnimJointMask.hpp"
 #include "Engine/Animation/AnimPose.hpp"
 
+#include <memory>
+#include <vector>
+
 
 class AnimPose;
 class AnimClip;
+class AnimBlendNode;
+
+
+//----------------------------------------------------------------------------------------------------------
+// What AnimBlendTree runs instead of walking the nodes; every instruction pushes one pose on the
+// tree's pose stack or pops two and pushes their result
+enum class AnimBlendInstructionType
+{
+	SAMPLE_CLIP,  // AnimClipNode: sample into the node's pose and push it
+	PUSH_POSE,	  // AnimPoseNode: push the node's pose, no copy
+	BLEND,		  // BinaryLerpBlendNode: pop B and A, push A lerped toward B
+	MASKED_BLEND, // BinaryLerpBlendNode with a joint mask: same, each joint by its mask weight
+	ADDITIVE,	  // AdditiveBlendNode: pop the additive pose and the base, push the base plus the weighted additive
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Nodes are read when the instruction runs, so Update() on a node takes effect without compiling again
+struct AnimBlendInstruction
+{
+	AnimBlendInstructionType m_type = AnimBlendInstructionType::PUSH_POSE;
+	AnimBlendNode*			 m_node = nullptr;
+};
 
 
 //----------------------------------------------------------------------------------------------------------
+// Nodes describe the tree and hold its parameters; AnimBlendTree compiles them into a list of
+// AnimBlendInstruction and evaluates that, children before parents
 //----------------------------------------------------------------------------------------------------------
 class AnimBlendNode
 {
@@ -16,10 +46,10 @@ public:
 	AnimBlendNode();
 	virtual ~AnimBlendNode() = 0;
 
-	virtual void			Update( float parametricZeroToOne )	 = 0;
-	virtual AnimPose const Evaluate()							 = 0;
-	virtual void			AddChild( AnimBlendNode* childNode ) = 0;
-	virtual void			ClearChildren()						 = 0;
+	virtual void Update( float parametricZeroToOne )									   = 0;
+	virtual void AppendInstructions( std::vector<AnimBlendInstruction>& out_instructions ) = 0;
+	virtual void AddChild( AnimBlendNode* childNode )									   = 0;
+	virtual void ClearChildren()														   = 0;
 
 	//----------------------------------------------------------------------------------------------------------
 	bool m_debug = false;
@@ -35,10 +65,10 @@ public:
 
 	AnimPose const& m_pose;
 
-	virtual void			Update( float parametricZeroToOne );
-	virtual AnimPose const Evaluate() override;
-	virtual void			AddChild( AnimBlendNode* childNode ) override;
-	virtual void			ClearChildren() override {}
+	virtual void Update( float parametricZeroToOne );
+	virtual void AppendInstructions( std::vector<AnimBlendInstruction>& out_instructions ) override;
+	virtual void AddChild( AnimBlendNode* childNode ) override;
+	virtual void ClearChildren() override {}
 };
 
 
@@ -49,14 +79,14 @@ public:
 	BinaryLerpBlendNode();
 	~BinaryLerpBlendNode();
 
-	virtual void			Update( float parametricZeroToOne ) override;
-	virtual AnimPose const Evaluate() override;
-	virtual void			AddChild( AnimBlendNode* childNode ) override;
-	virtual void			ClearChildren() override;
+	virtual void Update( float parametricZeroToOne ) override;
+	virtual void AppendInstructions( std::vector<AnimBlendInstruction>& out_instructions ) override;
+	virtual void AddChild( AnimBlendNode* childNode ) override;
+	virtual void ClearChildren() override;
 
 public:
-	float	 m_blendValue = 0.f;
-	AnimPose m_blendedPose;
+	float								 m_blendValue = 0.f;
+	std::shared_ptr<AnimJointMask const> m_jointMask; // per joint scale of m_blendValue, null blends every joint fully; set before the tree compiles
 
 //protected:
 	AnimBlendNode* m_childNodeA = nullptr;
@@ -71,19 +101,35 @@ public:
 	AnimClipNode( AnimClip const& animClip );
 	~AnimClipNode();
 
-	virtual void			Update( float parametricZeroToOne ) override;
-	virtual AnimPose const Evaluate() override;
-	virtual void			AddChild( AnimBlendNode* childNode ) override;
-	virtual void			ClearChildren() override {}
+	virtual void Update( float parametricZeroToOne ) override;
+	virtual void AppendInstructions( std::vector<AnimBlendInstruction>& out_instructions ) override;
+	virtual void AddChild( AnimBlendNode* childNode ) override;
+	virtual void ClearChildren() override {}
 
 public:
 	AnimClip const& m_animClip;
-	AnimPose		m_sampledPose;
+	AnimPose		m_sampledPose; // the caller gives it the skeleton; joints without a channel keep their value
+	AnimClipCursor	m_clipCursor;
 	float			m_localTimeMs = 0.f;
 };
 
 
 //----------------------------------------------------------------------------------------------------------
+// Adds a difference pose ( AnimPose::GetDifference() ) on top of a base pose, scaled by the blend value
 class AdditiveBlendNode : public AnimBlendNode
 {
+public:
+	AdditiveBlendNode();
+	~AdditiveBlendNode();
+
+	virtual void Update( float parametricZeroToOne ) override;
+	virtual void AppendInstructions( std::vector<AnimBlendInstruction>& out_instructions ) override;
+	virtual void AddChild( AnimBlendNode* childNode ) override;
+	virtual void ClearChildren() override;
+
+public:
+	float m_blendValue = 1.f; // weight of the additive pose
+
+	AnimBlendNode* m_baseNode	  = nullptr;
+	AnimBlendNode* m_additiveNode = nullptr;
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "Engine/Animation/AnimBlendTree.hpp"
 #include "Engine/Animation/AnimBlendNode.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
 
 
 
@@ -17,7 +18,102 @@ AnimBlendTree::~AnimBlendTree()
 
 
 //----------------------------------------------------------------------------------------------------------
-AnimPose const AnimBlendTree::Evaluate()
+void AnimBlendTree::Compile()
 {
-	return m_rootNode->Evaluate();
+	m_instructions.clear();
+	m_compiledRootNode = m_rootNode;
+	if ( m_rootNode == nullptr )
+	{
+		return;
+	}
+
+	m_rootNode->AppendInstructions( m_instructions );
+
+	// leaves push, blends pop two and push one
+	int stackDepth	  = 0;
+	int maxStackDepth = 0;
+	for ( AnimBlendInstruction const& instruction : m_instructions )
+	{
+		bool isLeaf = instruction.m_type == AnimBlendInstructionType::SAMPLE_CLIP || instruction.m_type == AnimBlendInstructionType::PUSH_POSE;
+		stackDepth += isLeaf ? 1 : -1;
+		maxStackDepth = stackDepth > maxStackDepth ? stackDepth : maxStackDepth;
+	}
+	GUARANTEE_OR_DIE( stackDepth == 1, "AnimBlendTree compiled to an unbalanced instruction list" );
+
+	m_scratchPoses.resize( maxStackDepth );
+	m_poseStack.resize( maxStackDepth );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+AnimPose const& AnimBlendTree::Evaluate()
+{
+	if ( m_compiledRootNode != m_rootNode || m_instructions.empty() )
+	{
+		Compile();
+	}
+
+	int stackDepth = 0;
+	for ( AnimBlendInstruction const& instruction : m_instructions )
+	{
+		switch ( instruction.m_type )
+		{
+		case AnimBlendInstructionType::SAMPLE_CLIP:
+		{
+			AnimClipNode* clipNode = static_cast<AnimClipNode*>( instruction.m_node );
+			clipNode->m_animClip.Sample( clipNode->m_localTimeMs, clipNode->m_sampledPose, &clipNode->m_clipCursor );
+			m_poseStack[ stackDepth++ ] = &clipNode->m_sampledPose;
+			break;
+		}
+		case AnimBlendInstructionType::PUSH_POSE:
+		{
+			m_poseStack[ stackDepth++ ] = &static_cast<AnimPoseNode*>( instruction.m_node )->m_pose;
+			break;
+		}
+		case AnimBlendInstructionType::BLEND:
+		case AnimBlendInstructionType::MASKED_BLEND:
+		{
+			BinaryLerpBlendNode* blendNode = static_cast<BinaryLerpBlendNode*>( instruction.m_node );
+			stackDepth--;
+			AnimPose const* poseA	   = m_poseStack[ stackDepth - 1 ];
+			AnimPose const* poseB	   = m_poseStack[ stackDepth ];
+			AnimPose&		resultPose = m_scratchPoses[ stackDepth - 1 ];
+
+			if ( instruction.m_type == AnimBlendInstructionType::MASKED_BLEND )
+			{
+				AnimPose::Blend( resultPose, *poseA, *poseB, blendNode->m_blendValue, *blendNode->m_jointMask );
+			}
+			else
+			{
+				AnimPose::Blend( resultPose, *poseA, *poseB, blendNode->m_blendValue, -1 );
+			}
+			m_poseStack[ stackDepth - 1 ] = &resultPose;
+			break;
+		}
+		case AnimBlendInstructionType::ADDITIVE:
+		{
+			AdditiveBlendNode* additiveNode = static_cast<AdditiveBlendNode*>( instruction.m_node );
+			stackDepth--;
+			AnimPose const* basePose	 = m_poseStack[ stackDepth - 1 ];
+			AnimPose const* additivePose = m_poseStack[ stackDepth ];
+			AnimPose&		resultPose	 = m_scratchPoses[ stackDepth - 1 ];
+
+			if ( additiveNode->m_blendValue < 1.f )
+			{
+				if ( m_zeroDifferencePose.GetSkeleton() != basePose->GetSkeleton() )
+				{
+					basePose->GetDifference( *basePose, m_zeroDifferencePose );
+				}
+				AnimPose& weightedAdditivePose = m_scratchPoses[ stackDepth ];
+				AnimPose::Blend( weightedAdditivePose, m_zeroDifferencePose, *additivePose, additiveNode->m_blendValue, -1 );
+				additivePose = &weightedAdditivePose;
+			}
+			basePose->GetAddition( *additivePose, resultPose );
+			m_poseStack[ stackDepth - 1 ] = &resultPose;
+			break;
+		}
+		}
+	}
+
+	return *m_poseStack[ 0 ];
 }
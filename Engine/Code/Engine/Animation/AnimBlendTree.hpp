@@ -1,19 +1,36 @@
 #pragma once
 
+#include "Engine/Animation/AnimBlendNode.hpp"
+#include "Engine/Animation/AnimPose.hpp"
+
+#include <vector>
+
 
 class AnimBlendNode;
 class AnimPose;
 
 
 //----------------------------------------------------------------------------------------------------------
+// Evaluates the node tree from a flat list of instructions over a stack of scratch poses,
+// instead of recursing through the nodes. Sampled clips stay in their AnimClipNode's pose and
+// AnimPoseNodes are pushed by address, so only blend results are written to the scratch poses.
+// The scratch poses take their size from the first Evaluate(); after that evaluating allocates nothing.
 class AnimBlendTree
 {
 public:
 	AnimBlendTree();
 	~AnimBlendTree();
 
-	AnimPose const Evaluate();
+	void			Compile();	// after changing the children of any node; Evaluate() compiles a new m_rootNode by itself
+	AnimPose const& Evaluate(); // valid until the next Evaluate()
 
 
 	AnimBlendNode* m_rootNode = nullptr;
-};
\ No newline at end of file
+
+protected:
+	AnimBlendNode*					  m_compiledRootNode = nullptr;
+	std::vector<AnimBlendInstruction> m_instructions;
+	std::vector<AnimPose>			  m_scratchPoses; // one per level of the pose stack
+	std::vector<AnimPose const*>	  m_poseStack;
+	AnimPose						  m_zeroDifferencePose; // adds nothing; weighted additive poses are blended from it
+};
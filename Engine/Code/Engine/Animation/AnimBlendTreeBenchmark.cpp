@@ -0,0 +1,203 @@
+#include "Engine/Animation/AnimBlendTreeBenchmark.hpp"
+#include "Engine/Animation/AnimBlendNode.hpp"
+#include "Engine/Animation/AnimBlendTree.hpp"
+#include "Engine/Animation/AnimClip.hpp"
+#include "Engine/Animation/AnimJointMask.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <math.h>
+#include <memory>
+
+
+//----------------------------------------------------------------------------------------------------------
+constexpr int ANIM_TREE_BENCHMARK_NUM_LEAVES = 6;
+
+
+//----------------------------------------------------------------------------------------------------------
+static void LogToDevConsole( Rgba8 const& color, std::string const& text )
+{
+	if ( g_theDevConsole )
+	{
+		g_theDevConsole->AddLine( color, text );
+	}
+	else
+	{
+		DebuggerPrintf( "%s\n", text.c_str() );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// A 10 second loop keyed at 30Hz; clips with different phases blend into poses that differ
+static void BuildBenchmarkClip( AnimClip& clip, int numJoints, float phase )
+{
+	constexpr int	NUM_KEYFRAMES		 = 301;
+	constexpr float KEYFRAME_DURATION_MS = 1000.f / 30.f;
+
+	clip.m_isLooping = true;
+	for ( int jointId = 0; jointId < numJoints; jointId++ )
+	{
+		AnimChannel& channel = clip.CreateOrGetAnimChannel( jointId );
+		for ( int keyframeIndex = 0; keyframeIndex < NUM_KEYFRAMES; keyframeIndex++ )
+		{
+			float timeMs	 = ( float ) keyframeIndex * KEYFRAME_DURATION_MS;
+			float seconds	 = timeMs / 1000.f;
+			float jointPhase = ( float ) jointId + phase;
+			channel.m_positionCurve.m_keyframes.push_back( { timeMs, Vec3( 10.f + sinf( seconds + jointPhase ), 0.f, 0.f ) } );
+			channel.m_rotationCurve.m_keyframes.push_back( { timeMs, Quaternion::MakeFromAxisOfRotationAndAngleDegrees( Vec3( 0.f, 0.6f, 0.8f ), 40.f * sinf( 3.f * seconds + 0.3f * jointPhase ) ) } );
+			channel.m_scaleCurve.m_keyframes.push_back( { timeMs, Vec3( 1.f, 1.f, 1.f ) } );
+		}
+	}
+	clip.CalculateTimeStamps();
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static BinaryLerpBlendNode* CreateLerpNode( std::vector<std::unique_ptr<BinaryLerpBlendNode>>& lerpNodes, AnimBlendNode* childNodeA, AnimBlendNode* childNodeB )
+{
+	lerpNodes.push_back( std::make_unique<BinaryLerpBlendNode>() );
+	lerpNodes.back()->m_childNodeA = childNodeA;
+	lerpNodes.back()->m_childNodeB = childNodeB;
+	return lerpNodes.back().get();
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// ( ( leaf0, leaf1 ), ( leaf2, leaf3 ) ) blended with ( leaf4, leaf5 )
+static AnimBlendNode* CreateLerpTree( std::vector<std::unique_ptr<BinaryLerpBlendNode>>& lerpNodes, AnimBlendNode* const* leafNodes )
+{
+	BinaryLerpBlendNode* leftNode  = CreateLerpNode( lerpNodes, CreateLerpNode( lerpNodes, leafNodes[ 0 ], leafNodes[ 1 ] ), CreateLerpNode( lerpNodes, leafNodes[ 2 ], leafNodes[ 3 ] ) );
+	BinaryLerpBlendNode* rightNode = CreateLerpNode( lerpNodes, leafNodes[ 4 ], leafNodes[ 5 ] );
+	return CreateLerpNode( lerpNodes, leftNode, rightNode );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static double TimeEvaluations( AnimBlendTree& tree, std::vector<std::unique_ptr<AnimClipNode>> const& clipNodes,
+	std::vector<std::unique_ptr<BinaryLerpBlendNode>> const& lerpNodes, int numEvaluations )
+{
+	// a 600 frame cycle through the clips; each clip and blend gets its own offset
+	auto updateNodes = [ & ]( int frameIndex )
+	{
+		float cycleFraction = fmodf( ( float ) frameIndex / 600.f, 1.f );
+		for ( size_t clipIndex = 0; clipIndex < clipNodes.size(); clipIndex++ )
+		{
+			clipNodes[ clipIndex ]->Update( fmodf( cycleFraction + 0.1f * ( float ) clipIndex, 1.f ) );
+		}
+		for ( size_t lerpIndex = 0; lerpIndex < lerpNodes.size(); lerpIndex++ )
+		{
+			lerpNodes[ lerpIndex ]->Update( fmodf( 0.2f + 0.1f * ( float ) lerpIndex + cycleFraction, 1.f ) );
+		}
+	};
+
+	// the first evaluations compile the tree and size its scratch poses
+	for ( int frameIndex = 0; frameIndex < 10; frameIndex++ )
+	{
+		updateNodes( frameIndex );
+		tree.Evaluate();
+	}
+
+	double startSeconds = GetCurrentTimeSeconds();
+	for ( int frameIndex = 0; frameIndex < numEvaluations; frameIndex++ )
+	{
+		updateNodes( frameIndex );
+		tree.Evaluate();
+	}
+	return ( double ) numEvaluations / ( GetCurrentTimeSeconds() - startSeconds );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+AnimBlendTreeBenchmarkResult RunAnimBlendTreeBenchmark( AnimBlendTreeBenchmarkSettings const& settings )
+{
+	std::vector<SkeletonJoint> joints( settings.m_numJoints );
+	for ( int jointId = 0; jointId < settings.m_numJoints; jointId++ )
+	{
+		joints[ jointId ].m_name		= Stringf( "Joint%d", jointId );
+		joints[ jointId ].m_parentIndex = jointId == 0 ? -1 : ( jointId - 1 ) / 2;
+	}
+	std::shared_ptr<Skeleton const> skeleton = std::make_shared<Skeleton const>( joints );
+
+	std::vector<AnimClip>					   clips( ANIM_TREE_BENCHMARK_NUM_LEAVES );
+	std::vector<std::unique_ptr<AnimClipNode>> clipNodes;
+	AnimBlendNode*							   clipLeafNodes[ ANIM_TREE_BENCHMARK_NUM_LEAVES ];
+	for ( int clipIndex = 0; clipIndex < ANIM_TREE_BENCHMARK_NUM_LEAVES; clipIndex++ )
+	{
+		BuildBenchmarkClip( clips[ clipIndex ], settings.m_numJoints, 0.7f * ( float ) clipIndex );
+		clipNodes.push_back( std::make_unique<AnimClipNode>( clips[ clipIndex ] ) );
+		clipNodes.back()->m_sampledPose = AnimPose( skeleton );
+		clipLeafNodes[ clipIndex ]		= clipNodes.back().get();
+	}
+
+	AnimBlendTreeBenchmarkResult result;
+	{
+		std::vector<std::unique_ptr<BinaryLerpBlendNode>> lerpNodes;
+		AnimBlendTree									  tree;
+		tree.m_rootNode						  = CreateLerpTree( lerpNodes, clipLeafNodes );
+		result.m_clipTreeEvaluationsPerSecond = TimeEvaluations( tree, clipNodes, lerpNodes, settings.m_numEvaluations );
+
+		tree.m_rootNode = nullptr; // the tree deletes its root, but the vectors here own every node
+	}
+
+	{
+		// the right pair only moves joint 2 and the joints under it, and the last pair is added on top at 0.3
+		std::vector<std::unique_ptr<BinaryLerpBlendNode>> lerpNodes;
+		BinaryLerpBlendNode*							  leftNode	= CreateLerpNode( lerpNodes, clipLeafNodes[ 0 ], clipLeafNodes[ 1 ] );
+		BinaryLerpBlendNode*							  rightNode = CreateLerpNode( lerpNodes, clipLeafNodes[ 2 ], clipLeafNodes[ 3 ] );
+		rightNode->m_jointMask										= std::make_shared<AnimJointMask const>( AnimJointMask::MakeFromRootJoint( skeleton, 2 ) );
+
+		AdditiveBlendNode additiveNode;
+		additiveNode.m_baseNode		= CreateLerpNode( lerpNodes, leftNode, rightNode );
+		additiveNode.m_additiveNode = CreateLerpNode( lerpNodes, clipLeafNodes[ 4 ], clipLeafNodes[ 5 ] );
+		additiveNode.m_blendValue	= 0.3f;
+
+		AnimBlendTree tree;
+		tree.m_rootNode									= &additiveNode;
+		result.m_maskedAdditiveTreeEvaluationsPerSecond	= TimeEvaluations( tree, clipNodes, lerpNodes, settings.m_numEvaluations );
+
+		tree.m_rootNode = nullptr;
+	}
+
+	{
+		// the clip nodes are still updated, but nothing samples them; the leaves are the poses they last sampled
+		std::vector<std::unique_ptr<AnimPoseNode>> poseNodes;
+		AnimBlendNode*							   poseLeafNodes[ ANIM_TREE_BENCHMARK_NUM_LEAVES ];
+		for ( int leafIndex = 0; leafIndex < ANIM_TREE_BENCHMARK_NUM_LEAVES; leafIndex++ )
+		{
+			poseNodes.push_back( std::make_unique<AnimPoseNode>( clipNodes[ leafIndex ]->m_sampledPose ) );
+			poseLeafNodes[ leafIndex ] = poseNodes.back().get();
+		}
+
+		std::vector<std::unique_ptr<BinaryLerpBlendNode>> lerpNodes;
+		AnimBlendTree									  tree;
+		tree.m_rootNode						  = CreateLerpTree( lerpNodes, poseLeafNodes );
+		result.m_poseTreeEvaluationsPerSecond = TimeEvaluations( tree, clipNodes, lerpNodes, settings.m_numEvaluations );
+
+		tree.m_rootNode = nullptr;
+	}
+	return result;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+bool Command_AnimTreeBench( EventArgs& args )
+{
+	AnimBlendTreeBenchmarkSettings settings;
+	settings.m_numJoints	  = args.GetValue( "Joints", settings.m_numJoints );
+	settings.m_numEvaluations = args.GetValue( "Evaluations", settings.m_numEvaluations );
+	if ( settings.m_numJoints < 3 || settings.m_numEvaluations < 1 )
+	{
+		LogToDevConsole( DevConsole::ERROR_COLOR, "AnimTreeBench: Joints has to be at least 3 and Evaluations at least 1" );
+		return true;
+	}
+
+	AnimBlendTreeBenchmarkResult result = RunAnimBlendTreeBenchmark( settings );
+	LogToDevConsole( DevConsole::INFO_MAJOR_COLOR, Stringf( "AnimTreeBench: %d joints, 6 leaves under 5 blends; evaluations per second:", settings.m_numJoints ) );
+	LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "  clips %.0f, clips with a masked and an additive blend %.0f, poses without sampling %.0f",
+		result.m_clipTreeEvaluationsPerSecond, result.m_maskedAdditiveTreeEvaluationsPerSecond, result.m_poseTreeEvaluationsPerSecond ) );
+	return true;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------
+struct AnimBlendTreeBenchmarkSettings
+{
+	int m_numJoints		 = 60;
+	int m_numEvaluations = 20000; // per tree, updating every node before each
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Evaluations per second of three trees of the same shape: six leaves under five blends
+struct AnimBlendTreeBenchmarkResult
+{
+	double m_clipTreeEvaluationsPerSecond			= 0.0; // AnimClipNode leaves under BinaryLerpBlendNodes
+	double m_maskedAdditiveTreeEvaluationsPerSecond = 0.0; // the same, with one blend masked and the root additive
+	double m_poseTreeEvaluationsPerSecond			= 0.0; // AnimPoseNode leaves, so only the blends run
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// How fast AnimBlendTree::Evaluate() runs the compiled instructions, with clips sampled at new times
+// and blend values changed every evaluation, the way a character updates its tree each frame
+AnimBlendTreeBenchmarkResult RunAnimBlendTreeBenchmark( AnimBlendTreeBenchmarkSettings const& settings );
+
+// "AnimTreeBench Joints=60 Evaluations=20000"; logs evaluations per second of each tree
+// DevConsole::Startup() subscribes it
+bool Command_AnimTreeBench( EventArgs& args );
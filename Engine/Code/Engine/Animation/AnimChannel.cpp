@@ -2,17 +2,21 @@
 
 
 //----------------------------------------------------------------------------------------------------------
-Transform AnimChannel::Sample( Transform const& reference, float sampleTimeMilliSeconds, bool isLooping, bool dontSampleTranslation ) const
+Transform AnimChannel::Sample( Transform const& reference, float sampleTimeMilliSeconds, bool isLooping, bool dontSampleTranslation, AnimChannelCursor* cursor ) const
 {
 	Transform result = reference;
 
+	int* positionKeyframeCursor = cursor ? &cursor->m_positionKeyframeIndex : nullptr;
+	int* rotationKeyframeCursor = cursor ? &cursor->m_rotationKeyframeIndex : nullptr;
+	int* scaleKeyframeCursor	= cursor ? &cursor->m_scaleKeyframeIndex : nullptr;
+
 	// position
 	if (dontSampleTranslation)
 	{
 		// still sample z
 		if ( !m_positionCurve.IsEmpty() )
 		{
-			result.m_position	= m_positionCurve.Sample( sampleTimeMilliSeconds, isLooping );
+			result.m_position	= m_positionCurve.Sample( sampleTimeMilliSeconds, isLooping, positionKeyframeCursor );
 			result.m_position.x = 0.f;
 			result.m_position.y = 0.f;
 		}
@@ -21,20 +25,20 @@ Transform AnimChannel::Sample( Transform const& reference, float sampleTimeMilli
 	{
 		if ( !m_positionCurve.IsEmpty() )
 		{
-			result.m_position = m_positionCurve.Sample( sampleTimeMilliSeconds, isLooping );
+			result.m_position = m_positionCurve.Sample( sampleTimeMilliSeconds, isLooping, positionKeyframeCursor );
 		}
 	}
 	
 	// rotation
 	if ( !m_rotationCurve.IsEmpty() )
 	{
-		result.m_rotation = m_rotationCurve.Sample( sampleTimeMilliSeconds, isLooping );
+		result.m_rotation = m_rotationCurve.Sample( sampleTimeMilliSeconds, isLooping, rotationKeyframeCursor );
 	}
 
 	// scale
 	if ( !m_scaleCurve.IsEmpty() )
 	{
-		result.m_scale = m_scaleCurve.Sample( sampleTimeMilliSeconds, isLooping );
+		result.m_scale = m_scaleCurve.Sample( sampleTimeMilliSeconds, isLooping, scaleKeyframeCursor );
 	}
 
 	return result;
@@ -7,6 +7,16 @@
 #include <string>
 
 
+//----------------------------------------------------------------------------------------------------------
+// Where one playing instance last sampled each curve of a channel, see GetKeyframeIndexAtSampleTime()
+struct AnimChannelCursor
+{
+	int m_positionKeyframeIndex = 0;
+	int m_rotationKeyframeIndex = 0;
+	int m_scaleKeyframeIndex	= 0;
+};
+
+
 //----------------------------------------------------------------------------------------------------------
 // Every joint has an animation channel, which stores the Animation curve of the joint's position, rotation, and scale.
 class AnimChannel
@@ -14,7 +24,7 @@ class AnimChannel
 public:
 	AnimChannel() = default;
 
-	Transform Sample( Transform const& reference, float sampleTimeMilliSeconds, bool isLooping, bool dontSampleTranslation = false ) const;
+	Transform Sample( Transform const& reference, float sampleTimeMilliSeconds, bool isLooping, bool dontSampleTranslation = false, AnimChannelCursor* cursor = nullptr ) const;
 	bool	  IsValid() const;
 
 	int			m_jointId	= -1;
@@ -1,34 +1,44 @@
 #include "Engine/Animation/AnimClip.hpp"
+#include "Engine/Animation/AnimAssetCache.hpp"
 #include "Engine/Animation/AnimPose.hpp"
 #include "Engine/Animation/AnimUtils.hpp"
-#include "Engine/Animation/FbxFileImporter.hpp"
+#include "Engine/Core/ParallelFor.hpp"
 
 
 //----------------------------------------------------------------------------------------------------------
 std::map<std::string, AnimClip*> AnimClip::s_animClipRegistery;
 
+// channels write to distinct joints, so big skeletons sample their channels in parallel
+constexpr int CHANNELS_PER_PARALLEL_CHUNK = 32;
+
 
 //----------------------------------------------------------------------------------------------------------
-float AnimClip::Sample( float sampleTimeMilliSeconds, AnimPose& outPose ) const
+float AnimClip::Sample( float sampleTimeMilliSeconds, AnimPose& outPose, AnimClipCursor* cursor ) const
 {
 	AnimPlaybackType playbackType		= m_isLooping ? AnimPlaybackType::LOOP : AnimPlaybackType::ONCE;
 	float			 adjustedSampleTime = AdjustSampleTimeToFitInsideRange( sampleTimeMilliSeconds, m_startTimeMilliseconds, m_endTimeMilliseconds, playbackType );
 
-	// 1. for every Animation channel is this clip
-	for ( int index = 0; index < m_animChannels.size(); index++ )
+	if ( cursor != nullptr && cursor->m_channelCursors.size() != m_animChannels.size() )
 	{
-		AnimChannel const& animChannel = m_animChannels[ index ];
-		int				   jointId	   = animChannel.m_jointId;
+		cursor->m_channelCursors.assign( m_animChannels.size(), AnimChannelCursor() );
+	}
 
-		// 2. sample the Animation Curve for that joint id
-		Transform defaultLocalTransform = outPose.GetLocalTransformOfJoint( jointId );
+	// 1. for every Animation channel is this clip
+	ParallelFor( 0, ( int ) m_animChannels.size(), CHANNELS_PER_PARALLEL_CHUNK, [ & ]( int index )
+		{
+			AnimChannel const& animChannel = m_animChannels[ index ];
+			int				   jointId	   = animChannel.m_jointId;
 
-		bool	  removeRootMotionTranslation = ( index == 0 ) && m_removeRootMotion;
-		Transform animatedLocalTransform	  = animChannel.Sample( defaultLocalTransform, adjustedSampleTime, m_isLooping, removeRootMotionTranslation );
+			// 2. sample the Animation Curve for that joint id
+			Transform defaultLocalTransform = outPose.GetLocalTransformOfJoint( jointId );
 
-		// 3. set the local transform
-		outPose.SetLocalTransformOfJoint( animatedLocalTransform, jointId );
-	}
+			bool			   removeRootMotionTranslation = ( index == 0 ) && m_removeRootMotion;
+			AnimChannelCursor* channelCursor			   = cursor ? &cursor->m_channelCursors[ index ] : nullptr;
+			Transform		   animatedLocalTransform	   = animChannel.Sample( defaultLocalTransform, adjustedSampleTime, m_isLooping, removeRootMotionTranslation, channelCursor );
+
+			// 3. set the local transform
+			outPose.SetLocalTransformOfJoint( animatedLocalTransform, jointId );
+		} );
 
 	return adjustedSampleTime;
 }
@@ -103,10 +113,10 @@ AnimClip* AnimClip::LoadOrGetAnimationClip( std::string clipFilePath )
 	{
 		return iter->second;
 	}
-	else // load from file
+	else // load from the cooked cache, or from the fbx file the first time
 	{
 		AnimClip* newClip = new AnimClip();
-		FbxFileImporter::LoadAnimClipFromFile( clipFilePath.c_str(), *newClip );
+		AnimAssetCache::LoadAnimClip( clipFilePath.c_str(), *newClip );
 
 		s_animClipRegistery[ clipFilePath ] = newClip;
 		return newClip;
@@ -10,6 +10,14 @@
 class AnimPose;
 
 
+//----------------------------------------------------------------------------------------------------------
+// Kept by each playing instance of a clip (a crossfade target, a clip node) so that sampling it
+// frame after frame picks up every curve where the last sample left it
+struct AnimClipCursor
+{
+	std::vector<AnimChannelCursor> m_channelCursors; // sized by the first Sample() that uses it
+};
+
 
 //----------------------------------------------------------------------------------------------------------
 // A snippet of Animation that can be played back.
@@ -23,7 +31,7 @@ public:
 	std::vector<AnimChannel> m_animChannels;
 	bool					 m_isLooping = false;
 
-	float		 Sample( float sampleTimeMilliSeconds, AnimPose& outPose ) const;
+	float		 Sample( float sampleTimeMilliSeconds, AnimPose& outPose, AnimClipCursor* cursor = nullptr ) const;
 	AnimChannel& CreateOrGetAnimChannel( int jointId );
 
 	float GetStartTime() const;
@@ -16,13 +16,13 @@ void AnimCrossfadeController::Update( float deltaSeconds )
 	m_currentPlaybackTimeMilliseconds += deltaMilliseconds;
 
 	// sample the current clip
-	m_currentAnimation->Sample( m_currentPlaybackTimeMilliseconds, m_currentSampledPose );
+	m_currentAnimation->Sample( m_currentPlaybackTimeMilliseconds, m_currentSampledPose, &m_currentClipCursor );
 
 	for ( int index = 0; index < m_targets.size(); index++ )
 	{
 		AnimCrossFadeTarget& target = m_targets[ index ];
 
-		target.m_targetAnimation->Sample( target.m_playbackTimeMilliseconds, target.m_sampledPose );
+		target.m_targetAnimation->Sample( target.m_playbackTimeMilliseconds, target.m_sampledPose, &target.m_clipCursor );
 
 		// blend value is a range map between elapsed time and fade duration
 		float blendValue = RangeMapClamped( target.m_elapsedTimeInFadeMilliseconds, 0.f, target.m_fadeDurationMilliseconds, 0.f, 1.f );
@@ -44,6 +44,7 @@ void AnimCrossfadeController::Update( float deltaSeconds )
 		{
 			m_currentAnimation				  = target.m_targetAnimation;
 			m_currentPlaybackTimeMilliseconds = target.m_playbackTimeMilliseconds;
+			m_currentClipCursor				  = target.m_clipCursor;
 			m_targets.erase( m_targets.begin() + index );
 
 			DebuggerPrintf( "Animation Cross faded: %s\n", m_currentAnimation->m_name.c_str() );
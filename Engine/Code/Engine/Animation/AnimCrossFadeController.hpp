@@ -11,11 +11,12 @@ struct AnimCrossFadeTarget
 {
 	AnimCrossFadeTarget() = default;
 
-	AnimPose  m_sampledPose;
-	AnimClip* m_targetAnimation				  = nullptr;
-	float	  m_playbackTimeMilliseconds	  = 0.f;
-	float	  m_fadeDurationMilliseconds	  = 0.f;
-	float	  m_elapsedTimeInFadeMilliseconds = 0.f;
+	AnimPose	   m_sampledPose;
+	AnimClipCursor m_clipCursor;
+	AnimClip*	   m_targetAnimation			   = nullptr;
+	float		   m_playbackTimeMilliseconds	   = 0.f;
+	float		   m_fadeDurationMilliseconds	   = 0.f;
+	float		   m_elapsedTimeInFadeMilliseconds = 0.f;
 };
 
 
@@ -33,9 +34,10 @@ public:
 
 	std::vector<AnimCrossFadeTarget> m_targets;
 
-	AnimClip* m_currentAnimation				= nullptr;
-	float	  m_currentPlaybackTimeMilliseconds = 0.f;
-	AnimPose  m_currentSampledPose;
+	AnimClip*	   m_currentAnimation				 = nullptr;
+	float		   m_currentPlaybackTimeMilliseconds = 0.f;
+	AnimPose	   m_currentSampledPose;
+	AnimClipCursor m_currentClipCursor; // hint only, so it may be stale when m_currentAnimation is changed directly
 
 
 	//----------------------------------------------------------------------------------------------------------
@@ -8,7 +8,7 @@
 
 
 //----------------------------------------------------------------------------------------------------------
-float FloatAnimCurve::Sample( float sampleTimeMilliSeconds, bool isLooping ) const
+float FloatAnimCurve::Sample( float sampleTimeMilliSeconds, bool isLooping, int* keyframeCursor ) const
 {
 	if ( m_keyframes.size() == 1 )
 	{
@@ -24,7 +24,7 @@ float FloatAnimCurve::Sample( float sampleTimeMilliSeconds, bool isLooping ) con
 	sampleTimeMilliSeconds			= AdjustSampleTimeToFitInsideRange( sampleTimeMilliSeconds, curveStartTime, curveEndTime, playbackType );
 
 	// 2. get the pair of keyframes that surround given time
-	int currentKeyframeIndex = GetKeyframeIndexAtSampleTime( m_keyframes, sampleTimeMilliSeconds );
+	int currentKeyframeIndex = GetKeyframeIndexAtSampleTime( m_keyframes, sampleTimeMilliSeconds, keyframeCursor );
 	int nextKeyframeIndex	 = currentKeyframeIndex + 1;
 
 	if ( m_interpolationType == AnimInterpolationType::Linear )
@@ -62,7 +62,7 @@ float FloatAnimCurve::GetEndTimeMilliSeconds() const
 
 
 //----------------------------------------------------------------------------------------------------------
-Vec3 Vec3AnimCurve::Sample( float sampleTimeMilliSeconds, bool isLooping ) const
+Vec3 Vec3AnimCurve::Sample( float sampleTimeMilliSeconds, bool isLooping, int* keyframeCursor ) const
 {
 	if ( m_keyframes.size() == 1 )
 	{
@@ -78,7 +78,7 @@ Vec3 Vec3AnimCurve::Sample( float sampleTimeMilliSeconds, bool isLooping ) const
 	sampleTimeMilliSeconds			= AdjustSampleTimeToFitInsideRange( sampleTimeMilliSeconds, curveStartTime, curveEndTime, playbackType );
 
 	// 2. get the pair of keyframes that surround given time
-	int currentKeyframeIndex = GetKeyframeIndexAtSampleTime( m_keyframes, sampleTimeMilliSeconds );
+	int currentKeyframeIndex = GetKeyframeIndexAtSampleTime( m_keyframes, sampleTimeMilliSeconds, keyframeCursor );
 	int nextKeyframeIndex	 = currentKeyframeIndex + 1;
 
 	if ( m_interpolationType == AnimInterpolationType::Linear )
@@ -192,7 +192,7 @@ Vector3Keyframe const& Vec3AnimCurve::GetKeyframeAtLastIndex() const
 
 
 //----------------------------------------------------------------------------------------------------------
-Quaternion QuaternionAnimCurve::Sample( float sampleTimeMilliSeconds, bool isLooping ) const
+Quaternion QuaternionAnimCurve::Sample( float sampleTimeMilliSeconds, bool isLooping, int* keyframeCursor ) const
 {
 	if ( m_keyframes.size() == 1 )
 	{
@@ -208,7 +208,7 @@ Quaternion QuaternionAnimCurve::Sample( float sampleTimeMilliSeconds, bool isLoo
 	sampleTimeMilliSeconds			= AdjustSampleTimeToFitInsideRange( sampleTimeMilliSeconds, curveStartTime, curveEndTime, playbackType );
 
 	// 2. get the pair of keyframes that surround given time
-	int currentKeyframeIndex = GetKeyframeIndexAtSampleTime( m_keyframes, sampleTimeMilliSeconds );
+	int currentKeyframeIndex = GetKeyframeIndexAtSampleTime( m_keyframes, sampleTimeMilliSeconds, keyframeCursor );
 	int nextKeyframeIndex	 = currentKeyframeIndex + 1;
 
 	if ( m_interpolationType == AnimInterpolationType::Linear )
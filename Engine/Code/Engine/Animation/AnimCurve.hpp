@@ -25,7 +25,7 @@ public:
 	AnimInterpolationType	   m_interpolationType = AnimInterpolationType::Linear;
 	AnimPlaybackType		   m_playbackType	   = AnimPlaybackType::ONCE;
 
-	float		 Sample( float sampleTimeMilliSeconds, bool isLooping ) const;
+	float		 Sample( float sampleTimeMilliSeconds, bool isLooping, int* keyframeCursor = nullptr ) const;
 	bool		 IsEmpty() const { return m_keyframes.empty(); }
 	unsigned int GetSize() const { return ( unsigned int ) m_keyframes.size(); }
 
@@ -42,7 +42,7 @@ public:
 	AnimInterpolationType		 m_interpolationType = AnimInterpolationType::Linear;
 	AnimPlaybackType			 m_playbackType		 = AnimPlaybackType::ONCE;
 
-	Vec3		 Sample( float sampleTimeMilliSeconds, bool isLooping ) const;
+	Vec3		 Sample( float sampleTimeMilliSeconds, bool isLooping, int* keyframeCursor = nullptr ) const;
 	bool		 IsEmpty() const { return m_keyframes.empty(); }
 	unsigned int GetSize() const { return ( unsigned int ) m_keyframes.size(); }
 
@@ -68,7 +68,7 @@ public:
 	AnimInterpolationType			m_interpolationType = AnimInterpolationType::Linear;
 	AnimPlaybackType				m_playbackType		= AnimPlaybackType::ONCE;
 
-	Quaternion	 Sample( float sampleTimeMilliSeconds, bool isLooping ) const;
+	Quaternion	 Sample( float sampleTimeMilliSeconds, bool isLooping, int* keyframeCursor = nullptr ) const;
 	bool		 IsEmpty() const { return m_keyframes.empty(); }
 	unsigned int GetSize() const { return unsigned int( m_keyframes.size() ); }
 
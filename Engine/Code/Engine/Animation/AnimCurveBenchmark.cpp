@@ -0,0 +1,106 @@
+#include "Engine/Animation/AnimCurveBenchmark.hpp"
+#include "Engine/Animation/AnimCurve.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------
+static void LogToDevConsole( Rgba8 const& color, std::string const& text )
+{
+	if ( g_theDevConsole )
+	{
+		g_theDevConsole->AddLine( color, text );
+	}
+	else
+	{
+		DebuggerPrintf( "%s\n", text.c_str() );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Plays both curves back from startTimeMs; returns nanoseconds per sample and a sum of the samples
+static double TimeCurvePlayback( AnimCurveBenchmarkSettings const& settings, Vec3AnimCurve const& positionCurve, QuaternionAnimCurve const& rotationCurve,
+	float startTimeMs, bool useCursor, double& out_checksum )
+{
+	float frameDurationMs = 1000.f / settings.m_playbackRateHz;
+
+	out_checksum		= 0.0;
+	double startSeconds = GetCurrentTimeSeconds();
+	for ( int repeatIndex = 0; repeatIndex < settings.m_numRepeats; repeatIndex++ )
+	{
+		int positionCursor = 0;
+		int rotationCursor = 0;
+		for ( int frameIndex = 0; frameIndex < settings.m_numPlaybackFrames; frameIndex++ )
+		{
+			float	   sampleTimeMs = startTimeMs + ( float ) frameIndex * frameDurationMs;
+			Vec3	   position		= positionCurve.Sample( sampleTimeMs, false, useCursor ? &positionCursor : nullptr );
+			Quaternion rotation		= rotationCurve.Sample( sampleTimeMs, false, useCursor ? &rotationCursor : nullptr );
+			out_checksum += ( double ) position.x + ( double ) rotation.w;
+		}
+	}
+	double elapsedSeconds = GetCurrentTimeSeconds() - startSeconds;
+	return elapsedSeconds * 1.0e9 / ( 2.0 * ( double ) settings.m_numRepeats * ( double ) settings.m_numPlaybackFrames );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+AnimCurveBenchmarkResult RunAnimCurveBenchmark( AnimCurveBenchmarkSettings const& settings )
+{
+	float keyframeDurationMs = 1000.f / settings.m_keyframeRateHz;
+
+	Vec3AnimCurve		positionCurve;
+	QuaternionAnimCurve rotationCurve;
+	for ( int keyframeIndex = 0; keyframeIndex < settings.m_numKeyframes; keyframeIndex++ )
+	{
+		float timeMs = ( float ) keyframeIndex * keyframeDurationMs;
+		positionCurve.m_keyframes.push_back( { timeMs, Vec3( ( float ) keyframeIndex, ( float ) ( keyframeIndex % 7 ), 1.f ) } );
+		rotationCurve.m_keyframes.push_back( { timeMs, Quaternion::MakeFromAxisOfRotationAndAngleDegrees( Vec3( 0.f, 0.f, 1.f ), ( float ) ( keyframeIndex % 360 ) ) } );
+	}
+
+	float endTimeMs			 = ( float ) ( settings.m_numKeyframes - 1 ) * keyframeDurationMs;
+	float playbackDurationMs = ( float ) settings.m_numPlaybackFrames * 1000.f / settings.m_playbackRateHz;
+	float lateStartTimeMs	 = endTimeMs - playbackDurationMs - 1.f;
+
+	double binarySearchStartChecksum = 0.0;
+	double binarySearchEndChecksum	 = 0.0;
+	double cursorStartChecksum		 = 0.0;
+	double cursorEndChecksum		 = 0.0;
+
+	AnimCurveBenchmarkResult result;
+	result.m_binarySearchStartNs = TimeCurvePlayback( settings, positionCurve, rotationCurve, 0.f, false, binarySearchStartChecksum );
+	result.m_binarySearchEndNs	 = TimeCurvePlayback( settings, positionCurve, rotationCurve, lateStartTimeMs, false, binarySearchEndChecksum );
+	result.m_cursorStartNs		 = TimeCurvePlayback( settings, positionCurve, rotationCurve, 0.f, true, cursorStartChecksum );
+	result.m_cursorEndNs		 = TimeCurvePlayback( settings, positionCurve, rotationCurve, lateStartTimeMs, true, cursorEndChecksum );
+	result.m_doResultsMatch		 = binarySearchStartChecksum == cursorStartChecksum && binarySearchEndChecksum == cursorEndChecksum;
+	return result;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+bool Command_AnimCurveBench( EventArgs& args )
+{
+	AnimCurveBenchmarkSettings settings;
+	settings.m_numKeyframes		 = args.GetValue( "Keys", settings.m_numKeyframes );
+	settings.m_numPlaybackFrames = args.GetValue( "Frames", settings.m_numPlaybackFrames );
+	if ( settings.m_numKeyframes < 2 || settings.m_numPlaybackFrames < 1 )
+	{
+		LogToDevConsole( DevConsole::ERROR_COLOR, "AnimCurveBench: Keys has to be at least 2 and Frames at least 1" );
+		return true;
+	}
+
+	AnimCurveBenchmarkResult result = RunAnimCurveBenchmark( settings );
+
+	LogToDevConsole( DevConsole::INFO_MAJOR_COLOR, Stringf( "AnimCurveBench: %d keys at %.0fHz, %d frames of %.0fHz playback, ns per curve sample",
+		settings.m_numKeyframes, settings.m_keyframeRateHz, settings.m_numPlaybackFrames, settings.m_playbackRateHz ) );
+	LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "  binary search: %.1f at the start, %.1f at the end", result.m_binarySearchStartNs, result.m_binarySearchEndNs ) );
+	LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "  cursor:        %.1f at the start, %.1f at the end", result.m_cursorStartNs, result.m_cursorEndNs ) );
+	if ( !result.m_doResultsMatch )
+	{
+		LogToDevConsole( DevConsole::ERROR_COLOR, "AnimCurveBench: samples with and without the cursor differ" );
+	}
+	return true;
+}
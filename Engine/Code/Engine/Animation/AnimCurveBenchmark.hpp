@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------
+struct AnimCurveBenchmarkSettings
+{
+	int	  m_numKeyframes	  = 10000;
+	float m_keyframeRateHz	  = 30.f;
+	int	  m_numPlaybackFrames = 300; // consecutive samples, as a character plays the curves back
+	float m_playbackRateHz	  = 60.f;
+	int	  m_numRepeats		  = 200;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Nanoseconds per curve sample, playing back from the start of the curves and from just before their end
+struct AnimCurveBenchmarkResult
+{
+	double m_binarySearchStartNs = 0.0; // no cursor
+	double m_binarySearchEndNs	 = 0.0;
+	double m_cursorStartNs		 = 0.0;
+	double m_cursorEndNs		 = 0.0;
+	bool   m_doResultsMatch		 = false; // the cursor changes nothing but the speed
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// How long finding the keyframes around the sample time takes, with and without a keyframe cursor.
+// Samples a position and a rotation curve frame after frame; without a cursor every sample binary
+// searches, with one it looks a few keyframes ahead of the last sample
+AnimCurveBenchmarkResult RunAnimCurveBenchmark( AnimCurveBenchmarkSettings const& settings );
+
+// "AnimCurveBench Keys=10000 Frames=300"; logs nanoseconds per sample
+// DevConsole::Startup() subscribes it
+bool Command_AnimCurveBench( EventArgs& args );
@@ -0,0 +1,64 @@
+#include "Engine/Animation/AnimJointMask.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------
+AnimJointMask::AnimJointMask( std::shared_ptr<Skeleton const> const& skeleton, float weight )
+	: m_skeleton( skeleton )
+{
+	int numJoints		= skeleton->GetNumberOfJoints();
+	int numPaddedJoints = ( numJoints + ANIM_POSE_SIMD_WIDTH - 1 ) / ANIM_POSE_SIMD_WIDTH * ANIM_POSE_SIMD_WIDTH;
+	m_jointWeights.assign( numPaddedJoints, 0.f );
+	for ( int jointId = 0; jointId < numJoints; jointId++ )
+	{
+		m_jointWeights[ jointId ] = weight;
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+AnimJointMask AnimJointMask::MakeFromRootJoint( std::shared_ptr<Skeleton const> const& skeleton, int rootJointId, float weight )
+{
+	AnimJointMask mask( skeleton );
+	mask.SetHierarchyWeight( rootJointId, weight );
+	return mask;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+AnimJointMask AnimJointMask::MakeFromJoints( std::shared_ptr<Skeleton const> const& skeleton, std::vector<int> const& jointIds, float weight )
+{
+	AnimJointMask mask( skeleton );
+	for ( int jointId : jointIds )
+	{
+		mask.SetJointWeight( jointId, weight );
+	}
+	return mask;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void AnimJointMask::SetJointWeight( int jointId, float weight )
+{
+	m_jointWeights[ jointId ] = weight;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void AnimJointMask::SetHierarchyWeight( int rootJointId, float weight )
+{
+	// parents are visited before their children, so each joint only has to look at its parent
+	int				  numJoints = m_skeleton->GetNumberOfJoints();
+	std::vector<bool> isUnderRoot( numJoints, false );
+
+	std::vector<int> const& evaluationOrder = m_skeleton->GetEvaluationOrder();
+	for ( int orderIndex = 0; orderIndex < numJoints; orderIndex++ )
+	{
+		int jointId		= evaluationOrder.empty() ? orderIndex : evaluationOrder[ orderIndex ];
+		int parentIndex = m_skeleton->GetParentOfJoint( jointId );
+		if ( jointId == rootJointId || ( parentIndex >= 0 && isUnderRoot[ parentIndex ] ) )
+		{
+			isUnderRoot[ jointId ]	  = true;
+			m_jointWeights[ jointId ] = weight;
+		}
+	}
+}
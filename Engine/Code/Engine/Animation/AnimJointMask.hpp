@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Engine/Animation/AnimPose.hpp"
+#include "Engine/Animation/Skeleton.hpp"
+
+#include <memory>
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------------
+// A blend weight for every joint of one skeleton, for layering one pose over part of another
+// ( upper body over lower body ). Built once and shared by every blend that layers the same
+// part of the skeleton, so a masked AnimPose::Blend() is one pass over the joints with no
+// hierarchy walk. Weights are stored padded to ANIM_POSE_SIMD_WIDTH like the pose streams,
+// with 0 in the padding.
+class AnimJointMask
+{
+public:
+	AnimJointMask() = default;
+	explicit AnimJointMask( std::shared_ptr<Skeleton const> const& skeleton, float weight = 0.f ); // every joint at weight
+
+	static AnimJointMask MakeFromRootJoint( std::shared_ptr<Skeleton const> const& skeleton, int rootJointId, float weight = 1.f ); // the root and every joint under it
+	static AnimJointMask MakeFromJoints( std::shared_ptr<Skeleton const> const& skeleton, std::vector<int> const& jointIds, float weight = 1.f ); // only the listed joints
+
+	void SetJointWeight( int jointId, float weight );
+	void SetHierarchyWeight( int rootJointId, float weight ); // one pass over the joints, parents before children
+
+	std::shared_ptr<Skeleton const> const& GetSkeleton() const { return m_skeleton; }
+	float								   GetJointWeight( int jointId ) const { return m_jointWeights[ jointId ]; }
+	float const*						   GetJointWeights() const { return m_jointWeights.data(); }
+
+protected:
+	std::vector<float>				m_jointWeights; // 0 leaves the joint as pose A, 1 blends it fully
+	std::shared_ptr<Skeleton const> m_skeleton;
+};
@@ -1,50 +1,91 @@
 #include "Engine/Animation/AnimPose.hpp"
+#include "Engine/Animation/AnimJointMask.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Math/MathUtils.hpp"
 
+#include <emmintrin.h>
+
 
 //-------------------------------------------------------------------------
-AnimPose::AnimPose()
+static float const s_identityTransformStreamValues[] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f, 1.f, 1.f }; // per LocalTransformStream
+
+
+//----------------------------------------------------------------------------------------------------------
+// four joints' rotations, one component per register
+struct QuaternionLanes
 {
+	__m128 x;
+	__m128 y;
+	__m128 z;
+	__m128 w;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// p * q on four joints at once, same convention as Quaternion::operator*()
+static QuaternionLanes MultiplyQuaternionLanes( QuaternionLanes const& p, QuaternionLanes const& q )
+{
+	QuaternionLanes result;
+	result.w = _mm_sub_ps( _mm_mul_ps( p.w, q.w ), _mm_add_ps( _mm_add_ps( _mm_mul_ps( p.x, q.x ), _mm_mul_ps( p.y, q.y ) ), _mm_mul_ps( p.z, q.z ) ) );
+	result.x = _mm_add_ps( _mm_add_ps( _mm_mul_ps( p.w, q.x ), _mm_mul_ps( q.w, p.x ) ), _mm_sub_ps( _mm_mul_ps( p.y, q.z ), _mm_mul_ps( p.z, q.y ) ) );
+	result.y = _mm_add_ps( _mm_add_ps( _mm_mul_ps( p.w, q.y ), _mm_mul_ps( q.w, p.y ) ), _mm_sub_ps( _mm_mul_ps( p.z, q.x ), _mm_mul_ps( p.x, q.z ) ) );
+	result.z = _mm_add_ps( _mm_add_ps( _mm_mul_ps( p.w, q.z ), _mm_mul_ps( q.w, p.z ) ), _mm_sub_ps( _mm_mul_ps( p.x, q.y ), _mm_mul_ps( p.y, q.x ) ) );
+	return result;
 }
 
 
 //-------------------------------------------------------------------------
-AnimPose::AnimPose( AnimPose const& copy )
+AnimPose::AnimPose()
 {
-	m_parentJointIndices   = copy.m_parentJointIndices;
-	m_jointLocalTransforms = copy.m_jointLocalTransforms;
-	m_jointNames		   = copy.m_jointNames;
 }
 
 
 //-------------------------------------------------------------------------
-// TODO later: optimize later with fast copy
-AnimPose& AnimPose::operator=( AnimPose const& copyFrom )
+AnimPose::AnimPose( std::shared_ptr<Skeleton const> const& skeleton )
+	: m_numJoints( skeleton->GetNumberOfJoints() )
+	, m_skeleton( skeleton )
 {
-	if ( this == &copyFrom )
+	m_numPaddedJoints = ( m_numJoints + ANIM_POSE_SIMD_WIDTH - 1 ) / ANIM_POSE_SIMD_WIDTH * ANIM_POSE_SIMD_WIDTH;
+	m_localTransformStreams.resize( NUM_LOCAL_TRANSFORM_STREAMS * m_numPaddedJoints );
+
+	for ( int stream = 0; stream < NUM_LOCAL_TRANSFORM_STREAMS; stream++ )
+	{
+		float* streamValues = GetStream( stream );
+		for ( int jointIndex = m_numJoints; jointIndex < m_numPaddedJoints; jointIndex++ )
+		{
+			streamValues[ jointIndex ] = s_identityTransformStreamValues[ stream ];
+		}
+	}
+
+	for ( int jointIndex = 0; jointIndex < m_numJoints; jointIndex++ )
 	{
-		return *this;
+		SetLocalTransformOfJoint( skeleton->GetBindLocalTransformOfJoint( jointIndex ), jointIndex );
 	}
+}
 
-	m_parentJointIndices   = copyFrom.m_parentJointIndices;
-	m_jointLocalTransforms = copyFrom.m_jointLocalTransforms;
-	m_jointNames		   = copyFrom.m_jointNames;
 
-	return *this;
+//-------------------------------------------------------------------------
+// poses of the same skeleton have the same size, so from then on copying into this one won't allocate
+void AnimPose::MatchSkeletonOf( AnimPose const& other )
+{
+	if ( m_skeleton != other.m_skeleton )
+	{
+		*this = other;
+	}
 }
 
 
 //-------------------------------------------------------------------------
 int AnimPose::GetNumberOfJoints() const
 {
-	return ( int ) m_jointLocalTransforms.size();
+	return m_numJoints;
 }
 
 
 //-------------------------------------------------------------------------
 int AnimPose::GetParentOfJoint( int jointId ) const
 {
-	return m_parentJointIndices[ jointId ];
+	return m_skeleton->GetParentOfJoint( jointId );
 }
 
 
@@ -52,7 +93,13 @@ int AnimPose::GetParentOfJoint( int jointId ) const
 //-------------------------------------------------------------------------
 Transform AnimPose::GetLocalTransformOfJoint( int jointId ) const
 {
-	Transform localTransform = m_jointLocalTransforms[ jointId ];
+	Transform localTransform;
+	localTransform.m_position = Vec3( GetStream( POSITION_X )[ jointId ], GetStream( POSITION_Y )[ jointId ], GetStream( POSITION_Z )[ jointId ] );
+	localTransform.m_rotation.x = GetStream( ROTATION_X )[ jointId ];
+	localTransform.m_rotation.y = GetStream( ROTATION_Y )[ jointId ];
+	localTransform.m_rotation.z = GetStream( ROTATION_Z )[ jointId ];
+	localTransform.m_rotation.w = GetStream( ROTATION_W )[ jointId ];
+	localTransform.m_scale		= Vec3( GetStream( SCALE_X )[ jointId ], GetStream( SCALE_Y )[ jointId ], GetStream( SCALE_Z )[ jointId ] );
 	return localTransform;
 }
 
@@ -60,18 +107,18 @@ Transform AnimPose::GetLocalTransformOfJoint( int jointId ) const
 //-------------------------------------------------------------------------
 Transform AnimPose::GetGlobalTransformOfJoint( int jointId ) const
 {
-	Transform globalTransform = m_jointLocalTransforms[ jointId ];
+	Transform globalTransform = GetLocalTransformOfJoint( jointId );
 
-	int parentIndex = m_parentJointIndices[ jointId ];
+	int parentIndex = GetParentOfJoint( jointId );
 	while ( parentIndex >= 0 )
 	{
 		Transform&		 thisJointTransform	  = globalTransform;
-		Transform const& parentJointTransform = m_jointLocalTransforms[ parentIndex ];
+		Transform const& parentJointTransform = GetLocalTransformOfJoint( parentIndex );
 
 		globalTransform = Transform::ApplyChildToParentTransform( thisJointTransform, parentJointTransform );
 
 		// move up
-		int grandParentIndex = m_parentJointIndices[ parentIndex ];
+		int grandParentIndex = GetParentOfJoint( parentIndex );
 		parentIndex			 = grandParentIndex;
 	}
 
@@ -80,33 +127,79 @@ Transform AnimPose::GetGlobalTransformOfJoint( int jointId ) const
 
 
 //----------------------------------------------------------------------------------------------------------
-void AnimPose::GetMatrixArray( std::vector<Mat44>& out ) const
+// Every joint is concatenated with its parent's already global transform exactly once, so the
+// whole pose costs one concatenation per joint instead of one per joint and ancestor.
+// Same result as GetGlobalTransformOfJoint() as long as scales are uniform; with non-uniform
+// scale the two group the concatenations differently
+void AnimPose::GetGlobalTransforms( std::vector<Transform>& out_globalTransforms ) const
 {
-	for ( int jointIndex = 0; jointIndex < m_jointLocalTransforms.size(); jointIndex++ )
+	int numJoints = GetNumberOfJoints();
+	out_globalTransforms.resize( numJoints );
+	if ( numJoints == 0 )
 	{
-		Transform globalTransform = GetGlobalTransformOfJoint( jointIndex );
-		Mat44	  matrix		  = Mat44::CreateFromTransform( globalTransform );
-		out.push_back( matrix );
+		return;
+	}
+
+	std::vector<int> const& evaluationOrder = m_skeleton->GetEvaluationOrder();
+	for ( int orderIndex = 0; orderIndex < numJoints; orderIndex++ )
+	{
+		int jointIndex	= evaluationOrder.empty() ? orderIndex : evaluationOrder[ orderIndex ];
+		int parentIndex = m_skeleton->GetParentOfJoint( jointIndex );
+		if ( parentIndex < 0 )
+		{
+			out_globalTransforms[ jointIndex ] = GetLocalTransformOfJoint( jointIndex );
+		}
+		else
+		{
+			out_globalTransforms[ jointIndex ] = Transform::ApplyChildToParentTransform( GetLocalTransformOfJoint( jointIndex ), out_globalTransforms[ parentIndex ] );
+		}
 	}
 }
 
 
 //----------------------------------------------------------------------------------------------------------
-void AnimPose::AddJoint( Transform const& localTransform, int parentIndex, std::string jointName)
+void AnimPose::GetGlobalMatrices( std::vector<Mat44>& out_globalMatrices ) const
 {
-	m_jointLocalTransforms.push_back( localTransform );
-	m_parentJointIndices.push_back( parentIndex );
-	m_jointNames.push_back( jointName );
+	// children still need their parent's global transform, so keep those around per thread
+	static thread_local std::vector<Transform> s_globalTransforms;
+	GetGlobalTransforms( s_globalTransforms );
+
+	int numJoints = GetNumberOfJoints();
+	out_globalMatrices.resize( numJoints );
+	for ( int jointIndex = 0; jointIndex < numJoints; jointIndex++ )
+	{
+		out_globalMatrices[ jointIndex ] = Mat44::CreateFromTransform( s_globalTransforms[ jointIndex ] );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void AnimPose::GetMatrixArray( std::vector<Mat44>& out ) const
+{
+	static thread_local std::vector<Transform> s_globalTransforms;
+	GetGlobalTransforms( s_globalTransforms );
+
+	for ( int jointIndex = 0; jointIndex < m_numJoints; jointIndex++ )
+	{
+		Mat44 matrix = Mat44::CreateFromTransform( s_globalTransforms[ jointIndex ] );
+		out.push_back( matrix );
+	}
 }
 
 
 //----------------------------------------------------------------------------------------------------------
 void AnimPose::SetLocalTransformOfJoint( Transform const& newLocalTransform, int jointId )
 {
-	Transform& currentTransform = m_jointLocalTransforms[ jointId ];
-	currentTransform.m_position = newLocalTransform.m_position;
-	currentTransform.m_rotation = newLocalTransform.m_rotation;
-	currentTransform.m_scale	= newLocalTransform.m_scale;
+	GetStream( POSITION_X )[ jointId ] = newLocalTransform.m_position.x;
+	GetStream( POSITION_Y )[ jointId ] = newLocalTransform.m_position.y;
+	GetStream( POSITION_Z )[ jointId ] = newLocalTransform.m_position.z;
+	GetStream( ROTATION_X )[ jointId ] = newLocalTransform.m_rotation.x;
+	GetStream( ROTATION_Y )[ jointId ] = newLocalTransform.m_rotation.y;
+	GetStream( ROTATION_Z )[ jointId ] = newLocalTransform.m_rotation.z;
+	GetStream( ROTATION_W )[ jointId ] = newLocalTransform.m_rotation.w;
+	GetStream( SCALE_X )[ jointId ]	   = newLocalTransform.m_scale.x;
+	GetStream( SCALE_Y )[ jointId ]	   = newLocalTransform.m_scale.y;
+	GetStream( SCALE_Z )[ jointId ]	   = newLocalTransform.m_scale.z;
 }
 
 
@@ -144,112 +237,198 @@ bool AnimPose::operator!=( AnimPose const& other )
 
 
 //----------------------------------------------------------------------------------------------------------
+// Same as LerpTransform() on every joint, ANIM_POSE_SIMD_WIDTH joints at a time.
+// outResultPose may be poseA or poseB; with a blend root, joints outside its hierarchy come out as pose A.
+// The blend root's hierarchy is walked on every call; blends of the same root every frame should
+// build an AnimJointMask once and use the overload taking it.
+// A pose A without a skeleton has no joints to mask, so it blends like a blend without a root
 void AnimPose::Blend( AnimPose& outResultPose, AnimPose const& poseA, AnimPose const& poseB, float parametricZeroToOne, int blendRootJointId )
 {
-	int numJoints = poseA.GetNumberOfJoints();
+	if ( blendRootJointId < 0 || poseA.m_skeleton == nullptr )
+	{
+		BlendJoints( outResultPose, poseA, poseB, parametricZeroToOne, nullptr );
+		return;
+	}
 
-	for ( int jointId = 0; jointId < numJoints; jointId++ )
+	// parents are visited before their children, so each joint only has to look at its parent
+	static thread_local std::vector<float> s_jointWeights;
+	s_jointWeights.assign( poseA.m_numPaddedJoints, 0.f );
+
+	std::vector<int> const& evaluationOrder = poseA.m_skeleton->GetEvaluationOrder();
+	for ( int orderIndex = 0; orderIndex < poseA.m_numJoints; orderIndex++ )
 	{
-		if ( blendRootJointId >= 0 )
+		int jointId		= evaluationOrder.empty() ? orderIndex : evaluationOrder[ orderIndex ];
+		int parentIndex = poseA.m_skeleton->GetParentOfJoint( jointId );
+		if ( jointId == blendRootJointId || ( parentIndex >= 0 && s_jointWeights[ parentIndex ] > 0.f ) )
 		{
-			bool isJointUnderBlendRootJoint = poseA.IsJointUnderRootHierarchy( jointId, blendRootJointId );
-			if ( isJointUnderBlendRootJoint )
-			{
-				Transform const& poseALocalTransform = poseA.GetLocalTransformOfJoint( jointId );
-				Transform const& poseBLocalTransform = poseB.GetLocalTransformOfJoint( jointId );
-
-				Transform blendedLocalTransform = LerpTransform( poseALocalTransform, poseBLocalTransform, parametricZeroToOne );
-				outResultPose.SetLocalTransformOfJoint( blendedLocalTransform, jointId );
-			}
-			else // above blended root
-			{
-				continue;
-			}
-		}
-		else // rootId = -1 is root of the entire skeletal
-		{
-			Transform const& poseALocalTransform = poseA.GetLocalTransformOfJoint( jointId );
-			Transform const& poseBLocalTransform = poseB.GetLocalTransformOfJoint( jointId );
-
-			Transform blendedLocalTransform = LerpTransform( poseALocalTransform, poseBLocalTransform, parametricZeroToOne );
-			outResultPose.SetLocalTransformOfJoint( blendedLocalTransform, jointId );
+			s_jointWeights[ jointId ] = 1.f;
 		}
 	}
+
+	BlendJoints( outResultPose, poseA, poseB, parametricZeroToOne, s_jointWeights.data() );
 }
 
 
 //----------------------------------------------------------------------------------------------------------
-bool AnimPose::IsJointUnderRootHierarchy( int jointId, int rootId ) const
+void AnimPose::Blend( AnimPose& outResultPose, AnimPose const& poseA, AnimPose const& poseB, float parametricZeroToOne, AnimJointMask const& jointMask )
 {
-	if ( jointId == rootId )
+	if ( poseA.m_skeleton == nullptr )
 	{
-		return true;
-	}
-
-	// bubble up and find root
-	int parentJointId = m_parentJointIndices[ jointId ];
-	while ( parentJointId >= 0 )
-	{
-		if ( parentJointId == rootId )
-		{
-			return true;
-		}
-		parentJointId = m_parentJointIndices[ parentJointId ];
+		BlendJoints( outResultPose, poseA, poseB, parametricZeroToOne, nullptr );
+		return;
 	}
 
-	return false;
+	GUARANTEE_OR_DIE( jointMask.GetSkeleton() == poseA.m_skeleton, "AnimJointMask is for a different skeleton than the poses it blends" );
+	BlendJoints( outResultPose, poseA, poseB, parametricZeroToOne, jointMask.GetJointWeights() );
 }
 
 
 //----------------------------------------------------------------------------------------------------------
-// D = A - B
-void AnimPose::GetDifference( AnimPose const& poseToSubtract, AnimPose& outResultPose )
+// Every joint is lerped by parametricZeroToOne times its weight, so a weight of 0 gives pose A
+// and the kernel is the same one pass whether or not there is a mask
+void AnimPose::BlendJoints( AnimPose& outResultPose, AnimPose const& poseA, AnimPose const& poseB, float parametricZeroToOne, float const* jointWeights )
 {
-	for ( int jointIndex = 0; jointIndex < m_jointLocalTransforms.size(); jointIndex++ )
-	{
-		Transform const& A = m_jointLocalTransforms[ jointIndex ];
-		Transform const& B = poseToSubtract.m_jointLocalTransforms[ jointIndex ];
-		Transform&		 D = outResultPose.m_jointLocalTransforms[ jointIndex ];
+	outResultPose.MatchSkeletonOf( poseA );
 
-		// position
-		D.m_position = A.m_position - B.m_position;
+	int	   numPaddedJoints = poseA.m_numPaddedJoints;
+	__m128 blendValue	   = _mm_set1_ps( parametricZeroToOne );
+	__m128 zero			   = _mm_setzero_ps();
+	__m128 signBit		   = _mm_set1_ps( -0.f );
 
-		// rotation
-		Quaternion ARotationInverse	  = A.m_rotation.GetInverse();
-		Quaternion rotationDifference = B.m_rotation * ARotationInverse;
-		D.m_rotation				  = rotationDifference;
+	for ( int firstJoint = 0; firstJoint < numPaddedJoints; firstJoint += ANIM_POSE_SIMD_WIDTH )
+	{
+		__m128 t = blendValue;
+		if ( jointWeights != nullptr )
+		{
+			t = _mm_mul_ps( t, _mm_loadu_ps( jointWeights + firstJoint ) );
+		}
+
+		// position and scale
+		for ( int stream : { POSITION_X, POSITION_Y, POSITION_Z, SCALE_X, SCALE_Y, SCALE_Z } )
+		{
+			__m128 a = _mm_loadu_ps( poseA.GetStream( stream ) + firstJoint );
+			__m128 b = _mm_loadu_ps( poseB.GetStream( stream ) + firstJoint );
+			_mm_storeu_ps( outResultPose.GetStream( stream ) + firstJoint, _mm_add_ps( a, _mm_mul_ps( _mm_sub_ps( b, a ), t ) ) );
+		}
 
-		// scale
-		D.m_scale = A.m_scale - B.m_scale;
+		// rotation: nlerp on the shortest path
+		QuaternionLanes a;
+		a.x = _mm_loadu_ps( poseA.GetStream( ROTATION_X ) + firstJoint );
+		a.y = _mm_loadu_ps( poseA.GetStream( ROTATION_Y ) + firstJoint );
+		a.z = _mm_loadu_ps( poseA.GetStream( ROTATION_Z ) + firstJoint );
+		a.w = _mm_loadu_ps( poseA.GetStream( ROTATION_W ) + firstJoint );
+
+		QuaternionLanes b;
+		b.x = _mm_loadu_ps( poseB.GetStream( ROTATION_X ) + firstJoint );
+		b.y = _mm_loadu_ps( poseB.GetStream( ROTATION_Y ) + firstJoint );
+		b.z = _mm_loadu_ps( poseB.GetStream( ROTATION_Z ) + firstJoint );
+		b.w = _mm_loadu_ps( poseB.GetStream( ROTATION_W ) + firstJoint );
+
+		__m128 dotProduct = _mm_add_ps( _mm_add_ps( _mm_mul_ps( a.x, b.x ), _mm_mul_ps( a.y, b.y ) ), _mm_add_ps( _mm_mul_ps( a.z, b.z ), _mm_mul_ps( a.w, b.w ) ) );
+		__m128 flipSign	  = _mm_and_ps( _mm_cmplt_ps( dotProduct, zero ), signBit );
+		b.x				  = _mm_xor_ps( b.x, flipSign );
+		b.y				  = _mm_xor_ps( b.y, flipSign );
+		b.z				  = _mm_xor_ps( b.z, flipSign );
+		b.w				  = _mm_xor_ps( b.w, flipSign );
+
+		QuaternionLanes blended;
+		blended.x = _mm_add_ps( a.x, _mm_mul_ps( _mm_sub_ps( b.x, a.x ), t ) );
+		blended.y = _mm_add_ps( a.y, _mm_mul_ps( _mm_sub_ps( b.y, a.y ), t ) );
+		blended.z = _mm_add_ps( a.z, _mm_mul_ps( _mm_sub_ps( b.z, a.z ), t ) );
+		blended.w = _mm_add_ps( a.w, _mm_mul_ps( _mm_sub_ps( b.w, a.w ), t ) );
+
+		__m128 lengthSquared = _mm_add_ps( _mm_add_ps( _mm_mul_ps( blended.x, blended.x ), _mm_mul_ps( blended.y, blended.y ) ),
+			_mm_add_ps( _mm_mul_ps( blended.z, blended.z ), _mm_mul_ps( blended.w, blended.w ) ) );
+		__m128 length		 = _mm_sqrt_ps( lengthSquared );
+
+		_mm_storeu_ps( outResultPose.GetStream( ROTATION_X ) + firstJoint, _mm_div_ps( blended.x, length ) );
+		_mm_storeu_ps( outResultPose.GetStream( ROTATION_Y ) + firstJoint, _mm_div_ps( blended.y, length ) );
+		_mm_storeu_ps( outResultPose.GetStream( ROTATION_Z ) + firstJoint, _mm_div_ps( blended.z, length ) );
+		_mm_storeu_ps( outResultPose.GetStream( ROTATION_W ) + firstJoint, _mm_div_ps( blended.w, length ) );
 	}
 }
 
 
 //----------------------------------------------------------------------------------------------------------
-void AnimPose::GetAddition( AnimPose const& poseToAdd, AnimPose& outResultPose )
+bool AnimPose::IsJointUnderRootHierarchy( int jointId, int rootId ) const
 {
-	for ( int jointIndex = 0; jointIndex < m_jointLocalTransforms.size(); jointIndex++ )
+	return m_skeleton->IsJointUnderRootHierarchy( jointId, rootId );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// D = A - B
+void AnimPose::GetDifference( AnimPose const& poseToSubtract, AnimPose& outResultPose ) const
+{
+	outResultPose.MatchSkeletonOf( *this );
+
+	for ( int firstJoint = 0; firstJoint < m_numPaddedJoints; firstJoint += ANIM_POSE_SIMD_WIDTH )
 	{
-		Transform const& jointTransform		  = m_jointLocalTransforms[ jointIndex ];
-		Transform const& jointTransformToAdd  = poseToAdd.m_jointLocalTransforms[ jointIndex ];
-		Transform&		 resultJointTransform = outResultPose.m_jointLocalTransforms[ jointIndex ];
+		// position and scale
+		for ( int stream : { POSITION_X, POSITION_Y, POSITION_Z, SCALE_X, SCALE_Y, SCALE_Z } )
+		{
+			__m128 A = _mm_loadu_ps( GetStream( stream ) + firstJoint );
+			__m128 B = _mm_loadu_ps( poseToSubtract.GetStream( stream ) + firstJoint );
+			_mm_storeu_ps( outResultPose.GetStream( stream ) + firstJoint, _mm_sub_ps( A, B ) );
+		}
 
-		resultJointTransform = jointTransform + jointTransformToAdd;
+		// rotation: B * inverse( A ), the conjugate since rotations are unit quaternions
+		__m128			signBit = _mm_set1_ps( -0.f );
+		QuaternionLanes ARotationInverse;
+		ARotationInverse.x = _mm_xor_ps( _mm_loadu_ps( GetStream( ROTATION_X ) + firstJoint ), signBit );
+		ARotationInverse.y = _mm_xor_ps( _mm_loadu_ps( GetStream( ROTATION_Y ) + firstJoint ), signBit );
+		ARotationInverse.z = _mm_xor_ps( _mm_loadu_ps( GetStream( ROTATION_Z ) + firstJoint ), signBit );
+		ARotationInverse.w = _mm_loadu_ps( GetStream( ROTATION_W ) + firstJoint );
+
+		QuaternionLanes BRotation;
+		BRotation.x = _mm_loadu_ps( poseToSubtract.GetStream( ROTATION_X ) + firstJoint );
+		BRotation.y = _mm_loadu_ps( poseToSubtract.GetStream( ROTATION_Y ) + firstJoint );
+		BRotation.z = _mm_loadu_ps( poseToSubtract.GetStream( ROTATION_Z ) + firstJoint );
+		BRotation.w = _mm_loadu_ps( poseToSubtract.GetStream( ROTATION_W ) + firstJoint );
+
+		QuaternionLanes rotationDifference = MultiplyQuaternionLanes( BRotation, ARotationInverse );
+		_mm_storeu_ps( outResultPose.GetStream( ROTATION_X ) + firstJoint, rotationDifference.x );
+		_mm_storeu_ps( outResultPose.GetStream( ROTATION_Y ) + firstJoint, rotationDifference.y );
+		_mm_storeu_ps( outResultPose.GetStream( ROTATION_Z ) + firstJoint, rotationDifference.z );
+		_mm_storeu_ps( outResultPose.GetStream( ROTATION_W ) + firstJoint, rotationDifference.w );
 	}
 }
 
 
 //----------------------------------------------------------------------------------------------------------
-void AnimPose::CalculateGlobalInverseBindPoseMatrices()
+// same as Transform::operator+() on every joint
+void AnimPose::GetAddition( AnimPose const& poseToAdd, AnimPose& outResultPose ) const
 {
-	for (int jointIndex = 0; jointIndex < m_jointLocalTransforms.size(); jointIndex++)
+	outResultPose.MatchSkeletonOf( *this );
+
+	for ( int firstJoint = 0; firstJoint < m_numPaddedJoints; firstJoint += ANIM_POSE_SIMD_WIDTH )
 	{
-		Transform jointGlobalTransform	 = GetGlobalTransformOfJoint( jointIndex );
-		jointGlobalTransform.m_scale	 = Vec3( 1.f, 1.f, 1.f );
-		Mat44 jointGlobalTransformMatrix = Mat44::CreateFromTransform( jointGlobalTransform );
-		Mat44 jointGlobalInverseBindPoseMatrix = jointGlobalTransformMatrix.GetOrthonormalInverse();
+		// position and scale
+		for ( int stream : { POSITION_X, POSITION_Y, POSITION_Z, SCALE_X, SCALE_Y, SCALE_Z } )
+		{
+			__m128 jointValues		= _mm_loadu_ps( GetStream( stream ) + firstJoint );
+			__m128 jointValuesToAdd = _mm_loadu_ps( poseToAdd.GetStream( stream ) + firstJoint );
+			_mm_storeu_ps( outResultPose.GetStream( stream ) + firstJoint, _mm_add_ps( jointValues, jointValuesToAdd ) );
+		}
 
-		m_jointGlobalInverseBindPoseMatrices.push_back( jointGlobalInverseBindPoseMatrix );
+		// rotation
+		QuaternionLanes jointRotation;
+		jointRotation.x = _mm_loadu_ps( GetStream( ROTATION_X ) + firstJoint );
+		jointRotation.y = _mm_loadu_ps( GetStream( ROTATION_Y ) + firstJoint );
+		jointRotation.z = _mm_loadu_ps( GetStream( ROTATION_Z ) + firstJoint );
+		jointRotation.w = _mm_loadu_ps( GetStream( ROTATION_W ) + firstJoint );
+
+		QuaternionLanes jointRotationToAdd;
+		jointRotationToAdd.x = _mm_loadu_ps( poseToAdd.GetStream( ROTATION_X ) + firstJoint );
+		jointRotationToAdd.y = _mm_loadu_ps( poseToAdd.GetStream( ROTATION_Y ) + firstJoint );
+		jointRotationToAdd.z = _mm_loadu_ps( poseToAdd.GetStream( ROTATION_Z ) + firstJoint );
+		jointRotationToAdd.w = _mm_loadu_ps( poseToAdd.GetStream( ROTATION_W ) + firstJoint );
+
+		QuaternionLanes resultRotation = MultiplyQuaternionLanes( jointRotation, jointRotationToAdd );
+		_mm_storeu_ps( outResultPose.GetStream( ROTATION_X ) + firstJoint, resultRotation.x );
+		_mm_storeu_ps( outResultPose.GetStream( ROTATION_Y ) + firstJoint, resultRotation.y );
+		_mm_storeu_ps( outResultPose.GetStream( ROTATION_Z ) + firstJoint, resultRotation.z );
+		_mm_storeu_ps( outResultPose.GetStream( ROTATION_W ) + firstJoint, resultRotation.w );
 	}
 }
 
@@ -257,5 +436,5 @@ void AnimPose::CalculateGlobalInverseBindPoseMatrices()
 //----------------------------------------------------------------------------------------------------------
 Mat44 const& AnimPose::GetGlobalInverseBindPoseMatrixOfJoint( int jointId ) const
 {
-	return m_jointGlobalInverseBindPoseMatrices[ jointId ];
+	return m_skeleton->GetGlobalInverseBindPoseMatrixOfJoint( jointId );
 }
@@ -1,55 +1,99 @@
 #pragma once
 
+#include "Engine/Animation/Skeleton.hpp"
 #include "Engine/Math/Transform.hpp"
 #include "Engine/Math/Mat44.hpp"
 
 
+#include <memory>
 #include <vector>
 #include <string>
 
 
+class AnimJointMask;
+
+
+//-------------------------------------------------------------------------
+constexpr int ANIM_POSE_SIMD_WIDTH = 4; // joints per SSE register in the blend kernels
+
+
 //-------------------------------------------------------------------------
 // The pose class needs to keep track of the transformation of every joint in
 // the skeleton of the animating character.
-// It also needs to keep track of the parent joint of every joint.
+// The parent of every joint, the names and the bind pose live in the shared Skeleton;
+// a pose only owns its local transforms.
+//
+// Local transforms are stored as a structure of arrays, one float stream per component,
+// so Blend(), GetDifference() and GetAddition() work on ANIM_POSE_SIMD_WIDTH joints at a time.
 class AnimPose
 {
 public:
 	AnimPose();
+	explicit AnimPose( std::shared_ptr<Skeleton const> const& skeleton ); // starts in the bind pose
 
+	// outResultPose becomes a copy of poseA first if it isn't a pose of the same skeleton yet.
+	// With a mask, each joint blends by parametricZeroToOne times its mask weight
 	static void Blend( AnimPose& outResultPose, AnimPose const& poseA, AnimPose const& poseB, float parametricZeroToOne, int rootJointId );
+	static void Blend( AnimPose& outResultPose, AnimPose const& poseA, AnimPose const& poseB, float parametricZeroToOne, AnimJointMask const& jointMask );
 
-	// copy
-	AnimPose( AnimPose const& copy );
-	AnimPose& operator=( AnimPose const& copyFrom );
+	std::shared_ptr<Skeleton const> const& GetSkeleton() const { return m_skeleton; }
 
-	void AddJoint( Transform const& localTransform, int parentIndex, std::string jointName);
 	void SetLocalTransformOfJoint( Transform const& newLocalTransform, int jointId );
 
 	int		  GetNumberOfJoints() const;
 	int		  GetParentOfJoint( int jointId ) const;
 	Transform GetLocalTransformOfJoint( int jointId ) const;
-	Transform GetGlobalTransformOfJoint( int jointId ) const;
+	Transform GetGlobalTransformOfJoint( int jointId ) const; // walks up the parent chain; use GetGlobalTransforms() for every joint
+
+	// Global transforms of every joint in one pass over the joints, parents before children.
+	// The output is resized, not appended to, so keeping it around between frames means no allocation
+	void GetGlobalTransforms( std::vector<Transform>& out_globalTransforms ) const;
+	void GetGlobalMatrices( std::vector<Mat44>& out_globalMatrices ) const;
 
 	bool IsJointUnderRootHierarchy( int jointId, int rootId ) const;
 
 	// matrix
-	void GetMatrixArray( std::vector<Mat44>& out ) const;
+	void GetMatrixArray( std::vector<Mat44>& out ) const; // appends the global matrix of every joint
 
 	// operators
 	bool operator==( AnimPose const& other );
 	bool operator!=( AnimPose const& other );
 
-	void GetDifference( AnimPose const& poseToSubtract, AnimPose& outResultPose );
-	void GetAddition( AnimPose const& poseToAdd, AnimPose& outResultPose );
+	void GetDifference( AnimPose const& poseToSubtract, AnimPose& outResultPose ) const;
+	void GetAddition( AnimPose const& poseToAdd, AnimPose& outResultPose ) const; // outResultPose may be this pose
 
-	void CalculateGlobalInverseBindPoseMatrices();
 	Mat44 const& GetGlobalInverseBindPoseMatrixOfJoint( int jointId ) const;
-	std::vector<Mat44> m_jointGlobalInverseBindPoseMatrices;
 
 
 protected:
-	std::vector<Transform>	 m_jointLocalTransforms;
-	std::vector<int>		 m_parentJointIndices;
-	std::vector<std::string> m_jointNames;
-};
\ No newline at end of file
+	enum LocalTransformStream
+	{
+		POSITION_X,
+		POSITION_Y,
+		POSITION_Z,
+		ROTATION_X,
+		ROTATION_Y,
+		ROTATION_Z,
+		ROTATION_W,
+		SCALE_X,
+		SCALE_Y,
+		SCALE_Z,
+		NUM_LOCAL_TRANSFORM_STREAMS
+	};
+
+	float*		 GetStream( int stream ) { return m_localTransformStreams.data() + stream * m_numPaddedJoints; }
+	float const* GetStream( int stream ) const { return m_localTransformStreams.data() + stream * m_numPaddedJoints; }
+
+	void MatchSkeletonOf( AnimPose const& other );
+
+	static void BlendJoints( AnimPose& outResultPose, AnimPose const& poseA, AnimPose const& poseB, float parametricZeroToOne, float const* jointWeights ); // jointWeights may be nullptr
+
+	// NUM_LOCAL_TRANSFORM_STREAMS streams of m_numPaddedJoints floats each, in one allocation.
+	// The padding joints past the last real one start as identity and go through the kernels like
+	// any other joint, so their rotations stay unit length and nothing ever reads them
+	std::vector<float> m_localTransformStreams;
+	int				   m_numJoints		 = 0;
+	int				   m_numPaddedJoints = 0; // m_numJoints rounded up to ANIM_POSE_SIMD_WIDTH
+
+	std::shared_ptr<Skeleton const> m_skeleton;
+};
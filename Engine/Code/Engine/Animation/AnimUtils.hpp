@@ -3,9 +3,9 @@
 
 #include <vector>
 
-struct FloatKeyframe;
-struct Vector3Keyframe;
-struct QuaternionKeyframe;
+
+//----------------------------------------------------------------------------------------------------------
+constexpr int KEYFRAME_CURSOR_MAX_STEPS = 4; // keyframes a cursor looks ahead before falling back to a binary search
 
 
 //------------------------------------------------------------------------------------------------
@@ -30,6 +30,76 @@ float AdjustSampleTimeToFitInsideRange( float sampleTimeMilliSeconds, float star
 
 
 //----------------------------------------------------------------------------------------------------------
-int GetKeyframeIndexAtSampleTime( std::vector<FloatKeyframe> const& m_keyframes, float sampleTime );
-int GetKeyframeIndexAtSampleTime( std::vector<Vector3Keyframe> const& m_keyframes, float sampleTime );
-int GetKeyframeIndexAtSampleTime( std::vector<QuaternionKeyframe> const& m_keyframes, float sampleTime );
+// Index of the first of the two keyframes around the sample time, -1 with fewer than two keyframes.
+// keyframeCursor, if given, is where this curve was last sampled and gets the result: playback only moves
+// a keyframe or so per frame, so looking from there is O(1), and a seek or a loop back to the start falls
+// back to a binary search instead of scanning from the first keyframe.
+template <typename KeyframeType>
+int GetKeyframeIndexAtSampleTime( std::vector<KeyframeType> const& keyframes, float sampleTimeMilliSeconds, int* keyframeCursor = nullptr )
+{
+	int numFrames = ( int ) keyframes.size();
+	if ( numFrames <= 1 )
+	{
+		return -1;
+	}
+
+	float timeOfFirstFrame		= keyframes[ 0 ].m_timeMilliSeconds;
+	int	  secondLastIndex		= numFrames - 2;
+	float timeOfSecondLastFrame = keyframes[ secondLastIndex ].m_timeMilliSeconds;
+
+	int keyframeIndex = -1;
+	if ( sampleTimeMilliSeconds <= timeOfFirstFrame )
+	{
+		keyframeIndex = 0;
+	}
+	else if ( sampleTimeMilliSeconds >= timeOfSecondLastFrame )
+	{
+		keyframeIndex = secondLastIndex;
+	}
+	else
+	{
+		// the pair is somewhere before the second last keyframe: keyframes[ index ] < sample time <= keyframes[ index + 1 ]
+		if ( keyframeCursor != nullptr )
+		{
+			int cursorIndex = *keyframeCursor < 0 ? 0 : *keyframeCursor;
+			for ( int index = cursorIndex; index < secondLastIndex && index < cursorIndex + KEYFRAME_CURSOR_MAX_STEPS; index++ )
+			{
+				if ( keyframes[ index ].m_timeMilliSeconds >= sampleTimeMilliSeconds )
+				{
+					break; // went back in time
+				}
+				if ( keyframes[ index + 1 ].m_timeMilliSeconds >= sampleTimeMilliSeconds )
+				{
+					keyframeIndex = index;
+					break;
+				}
+			}
+		}
+
+		if ( keyframeIndex < 0 )
+		{
+			// first keyframe at or after the sample time
+			int lowIndex  = 1;
+			int highIndex = secondLastIndex;
+			while ( lowIndex < highIndex )
+			{
+				int middleIndex = ( lowIndex + highIndex ) / 2;
+				if ( keyframes[ middleIndex ].m_timeMilliSeconds >= sampleTimeMilliSeconds )
+				{
+					highIndex = middleIndex;
+				}
+				else
+				{
+					lowIndex = middleIndex + 1;
+				}
+			}
+			keyframeIndex = lowIndex - 1;
+		}
+	}
+
+	if ( keyframeCursor != nullptr )
+	{
+		*keyframeCursor = keyframeIndex;
+	}
+	return keyframeIndex;
+}
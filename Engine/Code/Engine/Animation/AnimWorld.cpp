@@ -0,0 +1,93 @@
+#include "Engine/Animation/AnimWorld.hpp"
+#include "Engine/Animation/AnimBlendTree.hpp"
+#include "Engine/Animation/AnimCrossFadeController.hpp"
+#include "Engine/Animation/AnimPose.hpp"
+#include "Engine/Core/ParallelFor.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------
+AnimWorld::~AnimWorld()
+{
+	for ( AnimWorldCharacter& character : m_characters )
+	{
+		delete character.m_crossfadeController;
+		delete character.m_blendTree;
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int AnimWorld::AddCharacter( AnimCrossfadeController* crossfadeController )
+{
+	AnimWorldCharacter character;
+	character.m_crossfadeController = crossfadeController;
+	character.m_pose				= &crossfadeController->m_currentSampledPose;
+	character.m_globalMatrices.resize( crossfadeController->m_currentSampledPose.GetNumberOfJoints() );
+
+	m_characters.push_back( std::move( character ) );
+	return ( int ) m_characters.size() - 1;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int AnimWorld::AddCharacter( AnimBlendTree* blendTree )
+{
+	AnimWorldCharacter character;
+	character.m_blendTree = blendTree;
+
+	m_characters.push_back( std::move( character ) );
+	return ( int ) m_characters.size() - 1;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void AnimWorld::Update( float deltaSeconds, int maxNumThreads )
+{
+	struct UpdateContext
+	{
+		AnimWorld* m_world		  = nullptr;
+		float	   m_deltaSeconds = 0.f;
+	};
+
+	UpdateContext updateContext;
+	updateContext.m_world		 = this;
+	updateContext.m_deltaSeconds = deltaSeconds;
+
+	ParallelForChunkFunction updateChunk = []( void const* context, int chunkBegin, int chunkEnd, int participantIndex )
+	{
+		( void ) participantIndex;
+
+		UpdateContext const& update = *static_cast<UpdateContext const*>( context );
+		for ( int characterIndex = chunkBegin; characterIndex < chunkEnd; characterIndex++ )
+		{
+			update.m_world->UpdateCharacter( update.m_world->m_characters[ characterIndex ], update.m_deltaSeconds );
+		}
+	};
+
+	int numParticipants = GetMaxParallelForParticipants();
+	if ( maxNumThreads > 0 && maxNumThreads < numParticipants )
+	{
+		numParticipants = maxNumThreads;
+	}
+
+	// grain size from the measured cost of the first characters, a character is tens of microseconds
+	RunParallelFor( 0, ( int ) m_characters.size(), 0, numParticipants, updateChunk, &updateContext );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void AnimWorld::UpdateCharacter( AnimWorldCharacter& character, float deltaSeconds )
+{
+	// 1. sample and blend
+	if ( character.m_crossfadeController != nullptr )
+	{
+		character.m_crossfadeController->Update( deltaSeconds );
+	}
+	else
+	{
+		character.m_pose = &character.m_blendTree->Evaluate();
+	}
+
+	// 2. global pose
+	character.m_pose->GetGlobalMatrices( character.m_globalMatrices );
+}
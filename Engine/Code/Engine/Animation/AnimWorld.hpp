@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Engine/Math/Mat44.hpp"
+
+#include <vector>
+
+
+class AnimBlendTree;
+class AnimCrossfadeController;
+class AnimPose;
+
+
+//----------------------------------------------------------------------------------------------------------
+// One animated character of an AnimWorld: either a crossfade controller or a blend tree
+struct AnimWorldCharacter
+{
+	AnimCrossfadeController* m_crossfadeController = nullptr;
+	AnimBlendTree*			 m_blendTree		   = nullptr;
+
+	AnimPose const*	   m_pose = nullptr;   // result of the last Update()
+	std::vector<Mat44> m_globalMatrices; // of every joint of m_pose; sized when the character is added, or by the first Update() of a blend tree
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Owns the controllers and blend trees of many characters and updates all of them at once.
+// Each character is sampled, blended and put through the global pose pass on one thread, and
+// the characters are spread over the JobSystem's COMPUTATION workers with ParallelFor(),
+// so the clip sampling nested inside runs inline instead of splitting again.
+// Characters only touch their own poses and matrices, and clips are only read, so characters
+// sharing clips and skeletons update side by side without locks.
+class AnimWorld
+{
+public:
+	AnimWorld() = default;
+	~AnimWorld();
+
+	AnimWorld( AnimWorld const& copy )			  = delete;
+	AnimWorld& operator=( AnimWorld const& copy ) = delete;
+
+	// the world takes ownership; returns the index of the character
+	int AddCharacter( AnimCrossfadeController* crossfadeController );
+	int AddCharacter( AnimBlendTree* blendTree ); // parameters of the tree are set by the caller before Update()
+
+	void Update( float deltaSeconds, int maxNumThreads = 0 ); // the calling thread and up to maxNumThreads - 1 workers; 0 for every worker
+
+	int						  GetNumCharacters() const { return ( int ) m_characters.size(); }
+	AnimWorldCharacter const& GetCharacter( int characterIndex ) const { return m_characters[ characterIndex ]; }
+
+protected:
+	void UpdateCharacter( AnimWorldCharacter& character, float deltaSeconds );
+
+	std::vector<AnimWorldCharacter> m_characters;
+};
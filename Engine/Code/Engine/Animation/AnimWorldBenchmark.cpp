@@ -0,0 +1,159 @@
+#include "Engine/Animation/AnimWorldBenchmark.hpp"
+#include "Engine/Animation/AnimClip.hpp"
+#include "Engine/Animation/AnimCrossFadeController.hpp"
+#include "Engine/Animation/AnimWorld.hpp"
+#include "Engine/Animation/Skeleton.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/ParallelFor.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <memory>
+
+
+//----------------------------------------------------------------------------------------------------------
+static void LogToDevConsole( Rgba8 const& color, std::string const& text )
+{
+	if ( g_theDevConsole )
+	{
+		g_theDevConsole->AddLine( color, text );
+	}
+	else
+	{
+		DebuggerPrintf( "%s\n", text.c_str() );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Ten looping seconds keyed at 30Hz, every joint swinging with its own phase
+static void BuildBenchmarkClip( AnimClip& clip, int numJoints, float phaseDegrees )
+{
+	constexpr int	NUM_KEYFRAMES		 = 301;
+	constexpr float KEYFRAME_DURATION_MS = 1000.f / 30.f;
+
+	clip.m_name		 = "AnimWorldBench";
+	clip.m_isLooping = true;
+	for ( int jointId = 0; jointId < numJoints; jointId++ )
+	{
+		AnimChannel& channel	= clip.CreateOrGetAnimChannel( jointId );
+		float		 jointPhase	= phaseDegrees + 17.f * ( float ) jointId;
+		Vec3		 swingAxis	= Vec3( 0.f, 0.6f, 0.8f );
+		for ( int keyframeIndex = 0; keyframeIndex < NUM_KEYFRAMES; keyframeIndex++ )
+		{
+			float timeMs	 = ( float ) keyframeIndex * KEYFRAME_DURATION_MS;
+			float swingAngle = 40.f * SinDegrees( 0.18f * timeMs + jointPhase );
+
+			channel.m_positionCurve.m_keyframes.push_back( { timeMs, Vec3( 10.f + SinDegrees( 0.06f * timeMs + jointPhase ), 0.f, 0.f ) } );
+			channel.m_rotationCurve.m_keyframes.push_back( { timeMs, Quaternion::MakeFromAxisOfRotationAndAngleDegrees( swingAxis, swingAngle ) } );
+			channel.m_scaleCurve.m_keyframes.push_back( { timeMs, Vec3( 1.f, 1.f, 1.f ) } );
+		}
+	}
+	clip.CalculateTimeStamps();
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+std::vector<AnimWorldBenchmarkResult> RunAnimWorldBenchmark( AnimWorldBenchmarkSettings const& settings )
+{
+	// one chain of joints, like a spine running into an arm
+	std::vector<SkeletonJoint> joints( settings.m_numJoints );
+	for ( int jointId = 0; jointId < settings.m_numJoints; jointId++ )
+	{
+		joints[ jointId ].m_name		= Stringf( "Joint%d", jointId );
+		joints[ jointId ].m_parentIndex = jointId - 1;
+	}
+	std::shared_ptr<Skeleton const> skeleton = std::make_shared<Skeleton const>( joints );
+
+	// the world only reads the clips, so they have to outlive it
+	AnimClip walkClip;
+	AnimClip runClip;
+	BuildBenchmarkClip( walkClip, settings.m_numJoints, 0.f );
+	BuildBenchmarkClip( runClip, settings.m_numJoints, 90.f );
+
+	AnimWorld world;
+	for ( int characterIndex = 0; characterIndex < settings.m_numCharacters; characterIndex++ )
+	{
+		AnimCrossfadeController* crossfadeController		   = new AnimCrossfadeController();
+		crossfadeController->m_currentAnimation				   = &walkClip;
+		crossfadeController->m_currentSampledPose			   = AnimPose( skeleton );
+		crossfadeController->m_currentPlaybackTimeMilliseconds = 37.f * ( float ) characterIndex;
+
+		// every other character blends two clips, with a fade that never finishes
+		if ( characterIndex % 2 == 1 )
+		{
+			AnimCrossFadeTarget target;
+			target.m_targetAnimation		  = &runClip;
+			target.m_sampledPose			  = AnimPose( skeleton );
+			target.m_fadeDurationMilliseconds = 1.0e9f;
+			crossfadeController->m_targets.push_back( target );
+		}
+
+		world.AddCharacter( crossfadeController );
+	}
+
+	// 1, 2, 4 ... threads, and every one of them last
+	std::vector<int> threadCounts;
+	int				 maxNumThreads = GetMaxParallelForParticipants();
+	for ( int numThreads = 1; numThreads < maxNumThreads; numThreads *= 2 )
+	{
+		threadCounts.push_back( numThreads );
+	}
+	threadCounts.push_back( maxNumThreads );
+
+	constexpr float DELTA_SECONDS = 1.f / 60.f;
+
+	std::vector<AnimWorldBenchmarkResult> results;
+	for ( int numThreads : threadCounts )
+	{
+		for ( int updateIndex = 0; updateIndex < settings.m_numWarmUpUpdates; updateIndex++ )
+		{
+			world.Update( DELTA_SECONDS, numThreads );
+		}
+
+		double startSeconds = GetCurrentTimeSeconds();
+		for ( int updateIndex = 0; updateIndex < settings.m_numTimedUpdates; updateIndex++ )
+		{
+			world.Update( DELTA_SECONDS, numThreads );
+		}
+		double elapsedSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+		AnimWorldBenchmarkResult result;
+		result.m_numThreads				  = numThreads;
+		result.m_millisecondsPerUpdate	  = elapsedSeconds * 1000.0 / ( double ) settings.m_numTimedUpdates;
+		result.m_charactersPerMillisecond = result.m_millisecondsPerUpdate > 0.0 ? ( double ) settings.m_numCharacters / result.m_millisecondsPerUpdate : 0.0;
+		results.push_back( result );
+	}
+
+	return results;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+bool Command_AnimWorldBench( EventArgs& args )
+{
+	AnimWorldBenchmarkSettings settings;
+	settings.m_numCharacters   = args.GetValue( "Characters", settings.m_numCharacters );
+	settings.m_numJoints	   = args.GetValue( "Joints", settings.m_numJoints );
+	settings.m_numTimedUpdates = args.GetValue( "Updates", settings.m_numTimedUpdates );
+	if ( settings.m_numCharacters < 1 || settings.m_numJoints < 1 || settings.m_numTimedUpdates < 1 )
+	{
+		LogToDevConsole( DevConsole::ERROR_COLOR, "AnimWorldBench: Characters, Joints and Updates have to be at least 1" );
+		return true;
+	}
+
+	std::vector<AnimWorldBenchmarkResult> results = RunAnimWorldBenchmark( settings );
+
+	LogToDevConsole( DevConsole::INFO_MAJOR_COLOR, Stringf( "AnimWorldBench: %d characters of %d joints, %d updates per thread count",
+		settings.m_numCharacters, settings.m_numJoints, settings.m_numTimedUpdates ) );
+	for ( AnimWorldBenchmarkResult const& result : results )
+	{
+		double speedUp = result.m_charactersPerMillisecond / results[ 0 ].m_charactersPerMillisecond;
+		LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "  %2d threads: %.3f ms per update, %.1f characters/ms, %.2fx",
+			result.m_numThreads, result.m_millisecondsPerUpdate, result.m_charactersPerMillisecond, speedUp ) );
+	}
+	return true;
+}
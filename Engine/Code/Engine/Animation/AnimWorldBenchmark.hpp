@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------------
+struct AnimWorldBenchmarkSettings
+{
+	int m_numCharacters	   = 512;
+	int m_numJoints		   = 60;
+	int m_numWarmUpUpdates = 5;
+	int m_numTimedUpdates  = 60;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct AnimWorldBenchmarkResult
+{
+	int	   m_numThreads				  = 0; // the calling thread plus m_numThreads - 1 COMPUTATION workers
+	double m_millisecondsPerUpdate	  = 0.0;
+	double m_charactersPerMillisecond = 0.0;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// How AnimWorld::Update() scales with threads. Builds a world of synthetic characters sharing one
+// skeleton and two looping clips, half of them mid-crossfade, and times its updates on 1, 2, 4 ...
+// threads, up to every COMPUTATION worker of g_theJobSystem plus the calling thread.
+// Call it from the main thread while nothing else keeps the workers busy.
+std::vector<AnimWorldBenchmarkResult> RunAnimWorldBenchmark( AnimWorldBenchmarkSettings const& settings );
+
+// "AnimWorldBench Characters=512 Joints=60 Updates=60"; logs characters per millisecond for each thread count.
+// DevConsole::Startup() subscribes it
+bool Command_AnimWorldBench( EventArgs& args );
@@ -0,0 +1,552 @@
+#include "Engine/Animation/CompressedAnimClip.hpp"
+#include "Engine/Animation/AnimClip.hpp"
+#include "Engine/Animation/AnimPose.hpp"
+#include "Engine/Animation/AnimUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <math.h>
+#include <string.h>
+
+
+//----------------------------------------------------------------------------------------------------------
+constexpr float SMALLEST_THREE_COMPONENT_LIMIT = 0.70710678f; // the three smaller components of a unit quaternion are within +-1/sqrt(2)
+
+
+//----------------------------------------------------------------------------------------------------------
+static int GetNumBytesPerFrame( CompressedTrackFormat format, bool isRotation )
+{
+	switch ( format )
+	{
+	case CompressedTrackFormat::QUANTIZED_8:		return 3;
+	case CompressedTrackFormat::QUANTIZED_16:		return 6;
+	case CompressedTrackFormat::RAW_FLOAT:			return isRotation ? 16 : 12;
+	case CompressedTrackFormat::SMALLEST_THREE_32:	return 4;
+	case CompressedTrackFormat::SMALLEST_THREE_48:	return 6;
+	default:										return 0;
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static unsigned int QuantizeFloat( float value, float rangeMin, float rangeExtent, int numBits )
+{
+	unsigned int maxQuantizedValue = ( 1u << numBits ) - 1;
+	float		 fraction		   = rangeExtent > 0.f ? GetClampedZeroToOne( ( value - rangeMin ) / rangeExtent ) : 0.f;
+	return ( unsigned int ) ( fraction * ( float ) maxQuantizedValue + 0.5f );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static float DequantizeFloat( unsigned int quantizedValue, float rangeMin, float rangeExtent, int numBits )
+{
+	unsigned int maxQuantizedValue = ( 1u << numBits ) - 1;
+	return rangeMin + rangeExtent * ( ( float ) quantizedValue / ( float ) maxQuantizedValue );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static void WriteVec3( unsigned char* out, Vec3 const& value, CompressedTrack const& track )
+{
+	float const components[]  = { value.x, value.y, value.z };
+	float const rangeMins[]	  = { track.m_rangeMin.x, track.m_rangeMin.y, track.m_rangeMin.z };
+	float const rangeExtents[] = { track.m_rangeExtent.x, track.m_rangeExtent.y, track.m_rangeExtent.z };
+
+	for ( int componentIndex = 0; componentIndex < 3; componentIndex++ )
+	{
+		if ( track.m_format == CompressedTrackFormat::QUANTIZED_8 )
+		{
+			out[ componentIndex ] = ( unsigned char ) QuantizeFloat( components[ componentIndex ], rangeMins[ componentIndex ], rangeExtents[ componentIndex ], 8 );
+		}
+		else if ( track.m_format == CompressedTrackFormat::QUANTIZED_16 )
+		{
+			unsigned short quantizedValue = ( unsigned short ) QuantizeFloat( components[ componentIndex ], rangeMins[ componentIndex ], rangeExtents[ componentIndex ], 16 );
+			memcpy( out + componentIndex * 2, &quantizedValue, 2 );
+		}
+		else
+		{
+			memcpy( out + componentIndex * 4, &components[ componentIndex ], 4 );
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static Vec3 ReadVec3( unsigned char const* in, CompressedTrack const& track )
+{
+	Vec3 value;
+	if ( track.m_format == CompressedTrackFormat::QUANTIZED_8 )
+	{
+		value.x = DequantizeFloat( in[ 0 ], track.m_rangeMin.x, track.m_rangeExtent.x, 8 );
+		value.y = DequantizeFloat( in[ 1 ], track.m_rangeMin.y, track.m_rangeExtent.y, 8 );
+		value.z = DequantizeFloat( in[ 2 ], track.m_rangeMin.z, track.m_rangeExtent.z, 8 );
+	}
+	else if ( track.m_format == CompressedTrackFormat::QUANTIZED_16 )
+	{
+		unsigned short quantizedValues[ 3 ];
+		memcpy( quantizedValues, in, 6 );
+		value.x = DequantizeFloat( quantizedValues[ 0 ], track.m_rangeMin.x, track.m_rangeExtent.x, 16 );
+		value.y = DequantizeFloat( quantizedValues[ 1 ], track.m_rangeMin.y, track.m_rangeExtent.y, 16 );
+		value.z = DequantizeFloat( quantizedValues[ 2 ], track.m_rangeMin.z, track.m_rangeExtent.z, 16 );
+	}
+	else
+	{
+		memcpy( &value.x, in, 4 );
+		memcpy( &value.y, in + 4, 4 );
+		memcpy( &value.z, in + 8, 4 );
+	}
+	return value;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Smallest three: the largest component is dropped and rebuilt from the unit length,
+// its index goes in the top 2 bits, the other three follow in numBits each
+static void WriteRotation( unsigned char* out, Quaternion const& rotation, CompressedTrackFormat format )
+{
+	Quaternion normalizedRotation = rotation;
+	normalizedRotation.Normalize();
+	float components[] = { normalizedRotation.x, normalizedRotation.y, normalizedRotation.z, normalizedRotation.w };
+
+	if ( format == CompressedTrackFormat::RAW_FLOAT )
+	{
+		memcpy( out, components, 16 );
+		return;
+	}
+
+	int largestIndex = 0;
+	for ( int componentIndex = 1; componentIndex < 4; componentIndex++ )
+	{
+		if ( fabsf( components[ componentIndex ] ) > fabsf( components[ largestIndex ] ) )
+		{
+			largestIndex = componentIndex;
+		}
+	}
+
+	// q and -q are the same rotation, so keep the dropped component positive
+	float sign = components[ largestIndex ] < 0.f ? -1.f : 1.f;
+
+	int				   numBits = format == CompressedTrackFormat::SMALLEST_THREE_32 ? 10 : 15;
+	unsigned long long packed  = ( unsigned long long ) largestIndex;
+	for ( int componentIndex = 0; componentIndex < 4; componentIndex++ )
+	{
+		if ( componentIndex != largestIndex )
+		{
+			unsigned int quantizedValue = QuantizeFloat( components[ componentIndex ] * sign, -SMALLEST_THREE_COMPONENT_LIMIT, 2.f * SMALLEST_THREE_COMPONENT_LIMIT, numBits );
+			packed						= ( packed << numBits ) | quantizedValue;
+		}
+	}
+
+	int numBytes = GetNumBytesPerFrame( format, true );
+	for ( int byteIndex = 0; byteIndex < numBytes; byteIndex++ )
+	{
+		out[ byteIndex ] = ( unsigned char ) ( packed >> ( 8 * byteIndex ) );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static Quaternion ReadRotation( unsigned char const* in, CompressedTrackFormat format )
+{
+	if ( format == CompressedTrackFormat::RAW_FLOAT )
+	{
+		Quaternion rotation;
+		memcpy( &rotation.x, in, 4 );
+		memcpy( &rotation.y, in + 4, 4 );
+		memcpy( &rotation.z, in + 8, 4 );
+		memcpy( &rotation.w, in + 12, 4 );
+		return rotation;
+	}
+
+	int				   numBits	= format == CompressedTrackFormat::SMALLEST_THREE_32 ? 10 : 15;
+	int				   numBytes = GetNumBytesPerFrame( format, true );
+	unsigned long long packed	= 0;
+	for ( int byteIndex = 0; byteIndex < numBytes; byteIndex++ )
+	{
+		packed |= ( unsigned long long ) in[ byteIndex ] << ( 8 * byteIndex );
+	}
+
+	unsigned long long mask = ( 1ull << numBits ) - 1;
+	float			   smallestThree[ 3 ];
+	for ( int smallIndex = 2; smallIndex >= 0; smallIndex-- )
+	{
+		smallestThree[ smallIndex ] = DequantizeFloat( ( unsigned int ) ( packed & mask ), -SMALLEST_THREE_COMPONENT_LIMIT, 2.f * SMALLEST_THREE_COMPONENT_LIMIT, numBits );
+		packed >>= numBits;
+	}
+	int largestIndex = ( int ) ( packed & 3 );
+
+	float components[ 4 ];
+	float sumOfSquares = 0.f;
+	int	  smallIndex   = 0;
+	for ( int componentIndex = 0; componentIndex < 4; componentIndex++ )
+	{
+		if ( componentIndex != largestIndex )
+		{
+			components[ componentIndex ] = smallestThree[ smallIndex++ ];
+			sumOfSquares += components[ componentIndex ] * components[ componentIndex ];
+		}
+	}
+	components[ largestIndex ] = sqrtf( sumOfSquares < 1.f ? 1.f - sumOfSquares : 0.f );
+
+	return Quaternion( components[ 0 ], components[ 1 ], components[ 2 ], components[ 3 ] );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// from the distance between the two on the same hemisphere, |a - b| = 2 sin( angle / 4 ); acos of a dot
+// product this close to 1 is only good to a few hundredths of a degree in floats
+static float GetRotationErrorDegrees( Quaternion const& a, Quaternion const& b )
+{
+	Vec4 aVec4 = a.GetAsVec4();
+	Vec4 bVec4 = b.GetAsVec4();
+	if ( DotProduct4D( aVec4, bVec4 ) < 0.f )
+	{
+		bVec4 *= -1.f;
+	}
+	Vec4  difference = aVec4 - bVec4;
+	float halfLength = 0.5f * sqrtf( DotProduct4D( difference, difference ) );
+	return 4.f * ConvertRadiansToDegrees( asinf( halfLength < 1.f ? halfLength : 1.f ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Constant if every frame is within the budget of the middle of the range, otherwise the smallest format that is
+static void ChooseVec3TrackFormat( CompressedTrack& track, std::vector<Vec3> const& frameValues, float maxError )
+{
+	Vec3 rangeMin = frameValues[ 0 ];
+	Vec3 rangeMax = frameValues[ 0 ];
+	for ( Vec3 const& value : frameValues )
+	{
+		rangeMin = Vec3( value.x < rangeMin.x ? value.x : rangeMin.x, value.y < rangeMin.y ? value.y : rangeMin.y, value.z < rangeMin.z ? value.z : rangeMin.z );
+		rangeMax = Vec3( value.x > rangeMax.x ? value.x : rangeMax.x, value.y > rangeMax.y ? value.y : rangeMax.y, value.z > rangeMax.z ? value.z : rangeMax.z );
+	}
+
+	track.m_rangeMin	= rangeMin;
+	track.m_rangeExtent = rangeMax - rangeMin;
+	if ( ( track.m_rangeExtent * 0.5f ).GetLength() <= maxError )
+	{
+		track.m_format	 = CompressedTrackFormat::CONSTANT;
+		track.m_rangeMin = rangeMin + track.m_rangeExtent * 0.5f;
+		return;
+	}
+
+	for ( CompressedTrackFormat format : { CompressedTrackFormat::QUANTIZED_8, CompressedTrackFormat::QUANTIZED_16 } )
+	{
+		track.m_format = format;
+
+		float maxQuantizationError = 0.f;
+		for ( Vec3 const& value : frameValues )
+		{
+			unsigned char encodedValue[ 12 ];
+			WriteVec3( encodedValue, value, track );
+			float error			 = ( ReadVec3( encodedValue, track ) - value ).GetLength();
+			maxQuantizationError = error > maxQuantizationError ? error : maxQuantizationError;
+		}
+
+		if ( maxQuantizationError <= maxError )
+		{
+			return;
+		}
+	}
+
+	track.m_format = CompressedTrackFormat::RAW_FLOAT;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static void ChooseRotationTrackFormat( CompressedTrack& track, std::vector<Quaternion> const& frameValues, float maxErrorDegrees )
+{
+	bool isConstant = true;
+	for ( Quaternion const& value : frameValues )
+	{
+		isConstant = isConstant && GetRotationErrorDegrees( value, frameValues[ 0 ] ) <= maxErrorDegrees;
+	}
+	if ( isConstant )
+	{
+		track.m_format			 = CompressedTrackFormat::CONSTANT;
+		track.m_constantRotation = frameValues[ 0 ];
+		return;
+	}
+
+	for ( CompressedTrackFormat format : { CompressedTrackFormat::SMALLEST_THREE_32, CompressedTrackFormat::SMALLEST_THREE_48 } )
+	{
+		track.m_format = format;
+
+		float maxQuantizationErrorDegrees = 0.f;
+		for ( Quaternion const& value : frameValues )
+		{
+			unsigned char encodedValue[ 16 ];
+			WriteRotation( encodedValue, value, format );
+			float errorDegrees			= GetRotationErrorDegrees( ReadRotation( encodedValue, format ), value );
+			maxQuantizationErrorDegrees = errorDegrees > maxQuantizationErrorDegrees ? errorDegrees : maxQuantizationErrorDegrees;
+		}
+
+		if ( maxQuantizationErrorDegrees <= maxErrorDegrees )
+		{
+			return;
+		}
+	}
+
+	track.m_format = CompressedTrackFormat::RAW_FLOAT;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+AnimCompressionReport CompressedAnimClip::Compress( AnimClip const& sourceClip, AnimCompressionSettings const& settings )
+{
+	GUARANTEE_OR_DIE( settings.m_sampleRateHz > 0.f, "AnimCompressionSettings needs a sample rate above 0 Hz" );
+
+	AnimCompressionReport report;
+
+	m_name				  = sourceClip.m_name;
+	m_isLooping			  = sourceClip.m_isLooping;
+	m_removeRootMotion	  = sourceClip.m_removeRootMotion;
+	m_endTimeMilliseconds = sourceClip.GetEndTime();
+	m_channels.clear();
+	m_frameData.clear();
+	m_frameStride = 0;
+
+	// at least the requested rate, spread evenly so the last frame lands exactly on the end time
+	float requestedFrameDurationMs = 1000.f / settings.m_sampleRateHz;
+	m_numFrames					   = ( int ) ceilf( m_endTimeMilliseconds / requestedFrameDurationMs ) + 1;
+	m_frameDurationMs			   = m_numFrames > 1 ? m_endTimeMilliseconds / ( float ) ( m_numFrames - 1 ) : requestedFrameDurationMs;
+
+	// 1. resample every curve at the fixed rate and pick the format of each track
+	int								   numChannels = ( int ) sourceClip.m_animChannels.size();
+	std::vector<std::vector<Vec3>>	   positionFrames( numChannels );
+	std::vector<std::vector<Quaternion>> rotationFrames( numChannels );
+	std::vector<std::vector<Vec3>>	   scaleFrames( numChannels );
+	std::vector<float>				   jointErrorScales( numChannels, 1.f );
+
+	for ( int channelIndex = 0; channelIndex < numChannels; channelIndex++ )
+	{
+		AnimChannel const&	   sourceChannel = sourceClip.m_animChannels[ channelIndex ];
+		CompressedAnimChannel channel;
+		channel.m_jointId = sourceChannel.m_jointId;
+
+		int jointId = sourceChannel.m_jointId;
+		if ( jointId >= 0 && jointId < ( int ) settings.m_jointErrorScales.size() )
+		{
+			jointErrorScales[ channelIndex ] = settings.m_jointErrorScales[ jointId ];
+		}
+		float errorScale = jointErrorScales[ channelIndex ];
+
+		for ( int frameIndex = 0; frameIndex < m_numFrames; frameIndex++ )
+		{
+			float frameTime = GetClamped( ( float ) frameIndex * m_frameDurationMs, 0.f, m_endTimeMilliseconds );
+			if ( !sourceChannel.m_positionCurve.IsEmpty() )
+			{
+				positionFrames[ channelIndex ].push_back( sourceChannel.m_positionCurve.Sample( frameTime, m_isLooping ) );
+			}
+			if ( !sourceChannel.m_rotationCurve.IsEmpty() )
+			{
+				rotationFrames[ channelIndex ].push_back( sourceChannel.m_rotationCurve.Sample( frameTime, m_isLooping ) );
+			}
+			if ( !sourceChannel.m_scaleCurve.IsEmpty() )
+			{
+				scaleFrames[ channelIndex ].push_back( sourceChannel.m_scaleCurve.Sample( frameTime, m_isLooping ) );
+			}
+		}
+
+		if ( !positionFrames[ channelIndex ].empty() )
+		{
+			ChooseVec3TrackFormat( channel.m_positionTrack, positionFrames[ channelIndex ], settings.m_maxPositionError * errorScale );
+		}
+		if ( !rotationFrames[ channelIndex ].empty() )
+		{
+			ChooseRotationTrackFormat( channel.m_rotationTrack, rotationFrames[ channelIndex ], settings.m_maxRotationErrorDegrees * errorScale );
+		}
+		if ( !scaleFrames[ channelIndex ].empty() )
+		{
+			ChooseVec3TrackFormat( channel.m_scaleTrack, scaleFrames[ channelIndex ], settings.m_maxScaleError * errorScale );
+		}
+
+		// 2. lay out the animated tracks one after another in every frame
+		for ( CompressedTrack* track : { &channel.m_positionTrack, &channel.m_rotationTrack, &channel.m_scaleTrack } )
+		{
+			if ( track->m_format != CompressedTrackFormat::NONE )
+			{
+				report.m_numTracks++;
+			}
+			if ( track->m_format == CompressedTrackFormat::CONSTANT )
+			{
+				report.m_numConstantTracks++;
+			}
+
+			track->m_frameOffset = m_frameStride;
+			m_frameStride		+= GetNumBytesPerFrame( track->m_format, track == &channel.m_rotationTrack );
+		}
+
+		report.m_rawBytes += sourceChannel.m_positionCurve.m_keyframes.size() * sizeof( Vector3Keyframe );
+		report.m_rawBytes += sourceChannel.m_rotationCurve.m_keyframes.size() * sizeof( QuaternionKeyframe );
+		report.m_rawBytes += sourceChannel.m_scaleCurve.m_keyframes.size() * sizeof( Vector3Keyframe );
+
+		m_channels.push_back( channel );
+	}
+
+	// 3. encode
+	m_frameData.resize( ( size_t ) m_frameStride * m_numFrames );
+	for ( int channelIndex = 0; channelIndex < numChannels; channelIndex++ )
+	{
+		CompressedAnimChannel const& channel = m_channels[ channelIndex ];
+		for ( int frameIndex = 0; frameIndex < m_numFrames; frameIndex++ )
+		{
+			unsigned char* frame = m_frameData.data() + ( size_t ) frameIndex * m_frameStride;
+			if ( GetNumBytesPerFrame( channel.m_positionTrack.m_format, false ) > 0 )
+			{
+				WriteVec3( frame + channel.m_positionTrack.m_frameOffset, positionFrames[ channelIndex ][ frameIndex ], channel.m_positionTrack );
+			}
+			if ( GetNumBytesPerFrame( channel.m_rotationTrack.m_format, true ) > 0 )
+			{
+				WriteRotation( frame + channel.m_rotationTrack.m_frameOffset, rotationFrames[ channelIndex ][ frameIndex ], channel.m_rotationTrack.m_format );
+			}
+			if ( GetNumBytesPerFrame( channel.m_scaleTrack.m_format, false ) > 0 )
+			{
+				WriteVec3( frame + channel.m_scaleTrack.m_frameOffset, scaleFrames[ channelIndex ][ frameIndex ], channel.m_scaleTrack );
+			}
+		}
+	}
+
+	// 4. measure against the source on and between the frames
+	for ( int channelIndex = 0; channelIndex < numChannels; channelIndex++ )
+	{
+		AnimChannel const&			 sourceChannel = sourceClip.m_animChannels[ channelIndex ];
+		CompressedAnimChannel const& channel	   = m_channels[ channelIndex ];
+
+		float maxPositionError		  = 0.f;
+		float maxRotationErrorDegrees = 0.f;
+		float maxScaleError			  = 0.f;
+		for ( int halfFrameIndex = 0; halfFrameIndex < 2 * m_numFrames - 1; halfFrameIndex++ )
+		{
+			float sampleTime = GetClamped( 0.5f * ( float ) halfFrameIndex * m_frameDurationMs, 0.f, m_endTimeMilliseconds );
+			int	  frameIndex = halfFrameIndex / 2;
+			float fraction	 = ( halfFrameIndex % 2 ) ? 0.5f : 0.f;
+			int	  nextFrame	 = frameIndex + 1 < m_numFrames ? frameIndex + 1 : frameIndex;
+
+			Vec3	   position;
+			Quaternion rotation;
+			Vec3	   scale;
+			SampleChannel( channel, frameIndex, nextFrame, fraction, position, rotation, scale );
+
+			if ( !sourceChannel.m_positionCurve.IsEmpty() )
+			{
+				float error		 = ( position - sourceChannel.m_positionCurve.Sample( sampleTime, m_isLooping ) ).GetLength();
+				maxPositionError = error > maxPositionError ? error : maxPositionError;
+			}
+			if ( !sourceChannel.m_rotationCurve.IsEmpty() )
+			{
+				float errorDegrees		= GetRotationErrorDegrees( rotation, sourceChannel.m_rotationCurve.Sample( sampleTime, m_isLooping ) );
+				maxRotationErrorDegrees = errorDegrees > maxRotationErrorDegrees ? errorDegrees : maxRotationErrorDegrees;
+			}
+			if ( !sourceChannel.m_scaleCurve.IsEmpty() )
+			{
+				float error	  = ( scale - sourceChannel.m_scaleCurve.Sample( sampleTime, m_isLooping ) ).GetLength();
+				maxScaleError = error > maxScaleError ? error : maxScaleError;
+			}
+		}
+
+		float errorScale = jointErrorScales[ channelIndex ];
+		if ( maxPositionError > settings.m_maxPositionError * errorScale || maxRotationErrorDegrees > settings.m_maxRotationErrorDegrees * errorScale ||
+			 maxScaleError > settings.m_maxScaleError * errorScale )
+		{
+			report.m_numJointsOverBudget++;
+		}
+
+		report.m_maxPositionError		 = maxPositionError > report.m_maxPositionError ? maxPositionError : report.m_maxPositionError;
+		report.m_maxRotationErrorDegrees = maxRotationErrorDegrees > report.m_maxRotationErrorDegrees ? maxRotationErrorDegrees : report.m_maxRotationErrorDegrees;
+		report.m_maxScaleError			 = maxScaleError > report.m_maxScaleError ? maxScaleError : report.m_maxScaleError;
+	}
+
+	report.m_numFrames		 = m_numFrames;
+	report.m_compressedBytes = GetNumBytes();
+	return report;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+float CompressedAnimClip::Sample( float sampleTimeMilliSeconds, AnimPose& outPose ) const
+{
+	AnimPlaybackType playbackType		= m_isLooping ? AnimPlaybackType::LOOP : AnimPlaybackType::ONCE;
+	float			 adjustedSampleTime = AdjustSampleTimeToFitInsideRange( sampleTimeMilliSeconds, 0.f, m_endTimeMilliseconds, playbackType );
+	if ( m_numFrames == 0 )
+	{
+		return adjustedSampleTime;
+	}
+
+	// the frames around the sample time, no search
+	float frameTime	 = adjustedSampleTime / m_frameDurationMs;
+	int	  frameIndex = ( int ) GetClamped( floorf( frameTime ), 0.f, ( float ) ( m_numFrames - 1 ) );
+	int	  nextFrame	 = frameIndex + 1 < m_numFrames ? frameIndex + 1 : frameIndex;
+	float fraction	 = GetClampedZeroToOne( frameTime - ( float ) frameIndex );
+
+	for ( int channelIndex = 0; channelIndex < ( int ) m_channels.size(); channelIndex++ )
+	{
+		CompressedAnimChannel const& channel = m_channels[ channelIndex ];
+
+		Transform localTransform = outPose.GetLocalTransformOfJoint( channel.m_jointId );
+		SampleChannel( channel, frameIndex, nextFrame, fraction, localTransform.m_position, localTransform.m_rotation, localTransform.m_scale );
+
+		if ( channelIndex == 0 && m_removeRootMotion && channel.m_positionTrack.m_format != CompressedTrackFormat::NONE )
+		{
+			localTransform.m_position.x = 0.f;
+			localTransform.m_position.y = 0.f;
+		}
+
+		outPose.SetLocalTransformOfJoint( localTransform, channel.m_jointId );
+	}
+
+	return adjustedSampleTime;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Tracks without keyframes leave the out values alone
+void CompressedAnimClip::SampleChannel( CompressedAnimChannel const& channel, int frameIndex, int nextFrameIndex, float fractionToNextFrame, Vec3& out_position,
+	Quaternion& out_rotation, Vec3& out_scale ) const
+{
+	unsigned char const* frame	   = m_frameData.data() + ( size_t ) frameIndex * m_frameStride;
+	unsigned char const* nextFrame = m_frameData.data() + ( size_t ) nextFrameIndex * m_frameStride;
+
+	CompressedTrack const& positionTrack = channel.m_positionTrack;
+	if ( positionTrack.m_format == CompressedTrackFormat::CONSTANT )
+	{
+		out_position = positionTrack.m_rangeMin;
+	}
+	else if ( positionTrack.m_format != CompressedTrackFormat::NONE )
+	{
+		out_position = Lerp( ReadVec3( frame + positionTrack.m_frameOffset, positionTrack ), ReadVec3( nextFrame + positionTrack.m_frameOffset, positionTrack ), fractionToNextFrame );
+	}
+
+	CompressedTrack const& rotationTrack = channel.m_rotationTrack;
+	if ( rotationTrack.m_format == CompressedTrackFormat::CONSTANT )
+	{
+		out_rotation = rotationTrack.m_constantRotation;
+	}
+	else if ( rotationTrack.m_format != CompressedTrackFormat::NONE )
+	{
+		Quaternion rotation		= ReadRotation( frame + rotationTrack.m_frameOffset, rotationTrack.m_format );
+		Quaternion nextRotation = ReadRotation( nextFrame + rotationTrack.m_frameOffset, rotationTrack.m_format );
+		if ( DotProduct4D( rotation.GetAsVec4(), nextRotation.GetAsVec4() ) < 0.f )
+		{
+			nextRotation = -nextRotation;
+		}
+		out_rotation = NormalizedLerp( rotation, nextRotation, fractionToNextFrame );
+	}
+
+	CompressedTrack const& scaleTrack = channel.m_scaleTrack;
+	if ( scaleTrack.m_format == CompressedTrackFormat::CONSTANT )
+	{
+		out_scale = scaleTrack.m_rangeMin;
+	}
+	else if ( scaleTrack.m_format != CompressedTrackFormat::NONE )
+	{
+		out_scale = Lerp( ReadVec3( frame + scaleTrack.m_frameOffset, scaleTrack ), ReadVec3( nextFrame + scaleTrack.m_frameOffset, scaleTrack ), fractionToNextFrame );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+size_t CompressedAnimClip::GetNumBytes() const
+{
+	return m_frameData.size() + m_channels.size() * sizeof( CompressedAnimChannel );
+}
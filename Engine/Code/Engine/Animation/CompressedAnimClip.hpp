@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Engine/Math/Quaternion.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <string>
+#include <vector>
+
+
+class AnimClip;
+class AnimPose;
+
+
+//----------------------------------------------------------------------------------------------------------
+// How far a compressed clip may drift from the source clip.
+// The tolerances are per joint; m_jointErrorScales tightens or loosens them for single joints
+// (hands and the root usually want less error than fingers)
+struct AnimCompressionSettings
+{
+	float			   m_sampleRateHz			 = 30.f;				// at least, and above 0; frames are spread evenly over the clip
+	float			   m_maxPositionError		 = 0.01f;
+	float			   m_maxRotationErrorDegrees = 0.1f;
+	float			   m_maxScaleError			 = 0.001f;
+	std::vector<float> m_jointErrorScales; // by joint id; joints past the end use 1
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Measured against the source clip at every frame and halfway between frames
+struct AnimCompressionReport
+{
+	size_t m_rawBytes				 = 0; // keyframes of the source clip
+	size_t m_compressedBytes		 = 0;
+	int	   m_numFrames				 = 0;
+	int	   m_numTracks				 = 0; // position, rotation and scale of every channel that has keyframes
+	int	   m_numConstantTracks		 = 0;
+	float  m_maxPositionError		 = 0.f;
+	float  m_maxRotationErrorDegrees = 0.f;
+	float  m_maxScaleError			 = 0.f;
+	int	   m_numJointsOverBudget	 = 0; // only from resampling keys that fall between frames; raise the sample rate
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+enum class CompressedTrackFormat : unsigned char
+{
+	NONE,		  // no keyframes in the source, the pose keeps its value
+	CONSTANT,	  // the same value on every frame, no per-frame data
+	QUANTIZED_8,  // per component, over the track's range
+	QUANTIZED_16, // per component, over the track's range
+	RAW_FLOAT,
+	SMALLEST_THREE_32, // rotation: index of the largest component and the other three in 10 bits each
+	SMALLEST_THREE_48, // rotation: same with 15 bits each
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct CompressedTrack
+{
+	CompressedTrackFormat m_format		   = CompressedTrackFormat::NONE;
+	int					  m_frameOffset	   = 0; // bytes into every frame
+	Vec3				  m_rangeMin;			// or the value of a CONSTANT position or scale
+	Vec3				  m_rangeExtent;
+	Quaternion			  m_constantRotation;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct CompressedAnimChannel
+{
+	int				m_jointId = -1;
+	CompressedTrack m_positionTrack;
+	CompressedTrack m_rotationTrack;
+	CompressedTrack m_scaleTrack;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// An AnimClip resampled at a fixed rate and quantized track by track.
+// Sampling indexes the two frames around the sample time directly instead of searching keyframes,
+// and every frame of every animated track sits in one block of m_frameStride bytes.
+class CompressedAnimClip
+{
+public:
+	CompressedAnimClip() = default;
+
+	AnimCompressionReport Compress( AnimClip const& sourceClip, AnimCompressionSettings const& settings );
+
+	float Sample( float sampleTimeMilliSeconds, AnimPose& outPose ) const; // same as AnimClip::Sample()
+	float GetStartTime() const { return 0.f; }
+	float GetEndTime() const { return m_endTimeMilliseconds; }
+
+	size_t GetNumBytes() const;
+
+	std::string m_name = "UNKOWN ANIMATION CLIP";
+	bool		m_isLooping		   = false;
+	bool		m_removeRootMotion = false;
+
+protected:
+	void SampleChannel( CompressedAnimChannel const& channel, int frameIndex, int nextFrameIndex, float fractionToNextFrame, Vec3& out_position,
+		Quaternion& out_rotation, Vec3& out_scale ) const;
+
+	std::vector<CompressedAnimChannel> m_channels;
+	std::vector<unsigned char>		   m_frameData; // m_numFrames frames of m_frameStride bytes
+	int								   m_frameStride		 = 0;
+	int								   m_numFrames			 = 0;
+	float							   m_frameDurationMs	 = 0.f;
+	float							   m_endTimeMilliseconds = 0.f;
+};
@@ -0,0 +1,155 @@
+#include "Engine/Animation/CompressedAnimClipBenchmark.hpp"
+#include "Engine/Animation/AnimClip.hpp"
+#include "Engine/Animation/AnimPose.hpp"
+#include "Engine/Animation/Skeleton.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <math.h>
+#include <memory>
+
+
+//----------------------------------------------------------------------------------------------------------
+static void LogToDevConsole( Rgba8 const& color, std::string const& text )
+{
+	if ( g_theDevConsole )
+	{
+		g_theDevConsole->AddLine( color, text );
+	}
+	else
+	{
+		DebuggerPrintf( "%s\n", text.c_str() );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static void BuildBenchmarkClip( AnimClip& clip, CompressedAnimClipBenchmarkSettings const& settings )
+{
+	int	  numKeyframes		 = ( int ) ( settings.m_clipSeconds * settings.m_keyframeRateHz ) + 1;
+	float keyframeDurationMs = 1000.f / settings.m_keyframeRateHz;
+	Vec3  swingAxis			 = Vec3( 0.f, 0.6f, 0.8f );
+
+	clip.m_name		 = "AnimCompressBench";
+	clip.m_isLooping = true;
+	for ( int jointId = 0; jointId < settings.m_numJoints; jointId++ )
+	{
+		AnimChannel& channel = clip.CreateOrGetAnimChannel( jointId );
+		for ( int keyframeIndex = 0; keyframeIndex < numKeyframes; keyframeIndex++ )
+		{
+			float timeMs  = ( float ) keyframeIndex * keyframeDurationMs;
+			float seconds = timeMs / 1000.f;
+
+			Vec3 position = Vec3( 10.f, 0.f, 0.f );
+			if ( jointId == 0 )
+			{
+				position = Vec3( 200.f * seconds, 3.f * sinf( 6.f * seconds ), 90.f + 2.f * sinf( 12.f * seconds ) );
+			}
+			else if ( jointId % 3 == 0 )
+			{
+				position = Vec3( 10.f + 0.2f * sinf( 2.f * seconds + ( float ) jointId ), 0.f, 0.f );
+			}
+
+			Quaternion rotation = Quaternion::IDENTITY;
+			if ( jointId % 5 != 4 )
+			{
+				rotation = Quaternion::MakeFromAxisOfRotationAndAngleDegrees( swingAxis, 40.f * sinf( 3.f * seconds + 0.3f * ( float ) jointId ) );
+			}
+
+			channel.m_positionCurve.m_keyframes.push_back( { timeMs, position } );
+			channel.m_rotationCurve.m_keyframes.push_back( { timeMs, rotation } );
+			channel.m_scaleCurve.m_keyframes.push_back( { timeMs, Vec3( 1.f, 1.f, 1.f ) } );
+		}
+	}
+	clip.CalculateTimeStamps();
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+CompressedAnimClipBenchmarkResult RunCompressedAnimClipBenchmark( CompressedAnimClipBenchmarkSettings const& settings )
+{
+	std::vector<SkeletonJoint> joints( settings.m_numJoints );
+	for ( int jointId = 0; jointId < settings.m_numJoints; jointId++ )
+	{
+		joints[ jointId ].m_name		= Stringf( "Joint%d", jointId );
+		joints[ jointId ].m_parentIndex = jointId - 1;
+	}
+	std::shared_ptr<Skeleton const> skeleton = std::make_shared<Skeleton const>( joints );
+
+	AnimClip clip;
+	BuildBenchmarkClip( clip, settings );
+
+	AnimCompressionSettings compressionSettings;
+	compressionSettings.m_jointErrorScales.assign( settings.m_numJoints, 1.f );
+	compressionSettings.m_jointErrorScales[ 0 ] = 0.1f;
+
+	CompressedAnimClipBenchmarkResult result;
+	CompressedAnimClip				  compressedClip;
+	double							  startSeconds = GetCurrentTimeSeconds();
+	result.m_report								   = compressedClip.Compress( clip, compressionSettings );
+	result.m_compressMilliseconds				   = ( GetCurrentTimeSeconds() - startSeconds ) * 1000.0;
+
+	// a little over 60Hz apart, so the samples don't land on the same keyframes every loop
+	constexpr float SAMPLE_STEP_MS = 1.37f * 1000.f / 60.f;
+
+	AnimPose	   pose( skeleton );
+	AnimClipCursor cursor;
+	for ( int timingIndex = 0; timingIndex < 3; timingIndex++ )
+	{
+		startSeconds = GetCurrentTimeSeconds();
+		for ( int sampleIndex = 0; sampleIndex < settings.m_numSamples; sampleIndex++ )
+		{
+			float sampleTimeMs = ( float ) sampleIndex * SAMPLE_STEP_MS;
+			if ( timingIndex == 0 )
+			{
+				clip.Sample( sampleTimeMs, pose );
+			}
+			else if ( timingIndex == 1 )
+			{
+				clip.Sample( sampleTimeMs, pose, &cursor );
+			}
+			else
+			{
+				compressedClip.Sample( sampleTimeMs, pose );
+			}
+		}
+		double microsecondsPerPose = ( GetCurrentTimeSeconds() - startSeconds ) * 1.0e6 / ( double ) settings.m_numSamples;
+
+		double& out_microsecondsPerPose = timingIndex == 0 ? result.m_rawMicrosecondsPerPose
+										: timingIndex == 1 ? result.m_rawCursorMicrosecondsPerPose
+														   : result.m_compressedMicrosecondsPerPose;
+		out_microsecondsPerPose			= microsecondsPerPose;
+	}
+	return result;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+bool Command_AnimCompressBench( EventArgs& args )
+{
+	CompressedAnimClipBenchmarkSettings settings;
+	settings.m_numJoints   = args.GetValue( "Joints", settings.m_numJoints );
+	settings.m_clipSeconds = args.GetValue( "Seconds", settings.m_clipSeconds );
+	if ( settings.m_numJoints < 1 || settings.m_clipSeconds <= 0.f )
+	{
+		LogToDevConsole( DevConsole::ERROR_COLOR, "AnimCompressBench: Joints has to be at least 1 and Seconds above 0" );
+		return true;
+	}
+
+	CompressedAnimClipBenchmarkResult result = RunCompressedAnimClipBenchmark( settings );
+	AnimCompressionReport const&	  report = result.m_report;
+
+	LogToDevConsole( DevConsole::INFO_MAJOR_COLOR, Stringf( "AnimCompressBench: %d joints, %.1f seconds keyed at %.0fHz", settings.m_numJoints,
+		settings.m_clipSeconds, settings.m_keyframeRateHz ) );
+	LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "  %zu -> %zu bytes (%.1fx), %d frames, %d of %d tracks constant, compressed in %.1f ms",
+		report.m_rawBytes, report.m_compressedBytes, ( double ) report.m_rawBytes / ( double ) report.m_compressedBytes, report.m_numFrames,
+		report.m_numConstantTracks, report.m_numTracks, result.m_compressMilliseconds ) );
+	LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "  max error: position %.4f, rotation %.4f degrees, scale %.5f; %d joints over budget",
+		report.m_maxPositionError, report.m_maxRotationErrorDegrees, report.m_maxScaleError, report.m_numJointsOverBudget ) );
+	LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "  us per pose: %.2f raw, %.2f raw with a cursor, %.2f compressed",
+		result.m_rawMicrosecondsPerPose, result.m_rawCursorMicrosecondsPerPose, result.m_compressedMicrosecondsPerPose ) );
+	return true;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Engine/Animation/CompressedAnimClip.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------
+struct CompressedAnimClipBenchmarkSettings
+{
+	int	  m_numJoints	   = 60;
+	float m_clipSeconds	   = 10.f;
+	float m_keyframeRateHz = 30.f;
+	int	  m_numSamples	   = 3000; // poses sampled per timing, at times spread over the loop
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct CompressedAnimClipBenchmarkResult
+{
+	AnimCompressionReport m_report;
+	double				  m_compressMilliseconds		  = 0.0;
+	double				  m_rawMicrosecondsPerPose		  = 0.0; // AnimClip::Sample() without a cursor
+	double				  m_rawCursorMicrosecondsPerPose  = 0.0;
+	double				  m_compressedMicrosecondsPerPose = 0.0;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Size, error and sampling speed of a CompressedAnimClip against the AnimClip it came from.
+// The clip is a looping walk-like motion: a root moving forward, a third of the joints sliding along
+// their bone, most of them swinging and every fifth one still; the root gets a tenth of the error budget
+CompressedAnimClipBenchmarkResult RunCompressedAnimClipBenchmark( CompressedAnimClipBenchmarkSettings const& settings );
+
+// "AnimCompressBench Joints=60 Seconds=10"; logs the compression report and microseconds per pose
+// DevConsole::Startup() subscribes it
+bool Command_AnimCompressBench( EventArgs& args );
@@ -13,7 +13,7 @@
 float	   SCALE_OF_THE_FB_SCENE = 70.f;
 //float	   SCALE_OF_THE_FB_SCENE = 1.f;
 
-void	   AddJointNodeToPose( FbxNode* fbxNode, int parentIndex, AnimPose& pose );
+void	   AddJointNodeToSkeleton( FbxNode* fbxNode, int parentIndex, std::vector<SkeletonJoint>& skeletonJoints );
 void	   AddJointNodeAnimData( FbxNode* fbxNode, int jointId, /*FbxAnimStack* fbxAnimStack,*/ FbxAnimLayer* fbxAnimLayer, AnimClip* animClip );
 FbxAMatrix CalculateFbxTransformMatrixOfFbxNode( FbxNode* fbxNode );
 Rgba8	   GetDiffuseColorForPolygon( FbxLayerElementArrayTemplate<int>* materialIndices, int polygonIndex, FbxNode* fbxNode );
@@ -138,15 +138,15 @@ void FbxFileImporter::LoadAnimClipFromFile( char const* filename, AnimClip& outC
 		}
 	}
 
-	AnimPose pose;
+	std::vector<SkeletonJoint> skeletonJoints;
 
 	// child skeletal joints
 	while ( !jointQueue.empty() )
 	{
 		// skeletal data
 		Joint& joint = jointQueue.front();
-		AddJointNodeToPose( joint.m_fbxNode, joint.m_parentIndex, pose );
-		joint.m_jointId = pose.GetNumberOfJoints() - 1;
+		AddJointNodeToSkeleton( joint.m_fbxNode, joint.m_parentIndex, skeletonJoints );
+		joint.m_jointId = ( int ) skeletonJoints.size() - 1;
 
 		// animation data
 		AddJointNodeAnimData( joint.m_fbxNode, joint.m_jointId, fbxAnimlayer, &outClip );
@@ -238,12 +238,13 @@ void FbxFileImporter::LoadRestPoseFromFile( char const* filename, AnimPose& outP
 	}
 
 	// child skeletal joints
+	std::vector<SkeletonJoint> skeletonJoints;
 	while ( !jointQueue.empty() )
 	{
 		// skeletal data
 		Joint& joint = jointQueue.front();
-		AddJointNodeToPose( joint.m_fbxNode, joint.m_parentIndex, outPose );
-		joint.m_jointId = outPose.GetNumberOfJoints() - 1;
+		AddJointNodeToSkeleton( joint.m_fbxNode, joint.m_parentIndex, skeletonJoints );
+		joint.m_jointId = ( int ) skeletonJoints.size() - 1;
 
 		for ( int index = 0; index < joint.m_fbxNode->GetChildCount(); index++ )
 		{
@@ -259,6 +260,8 @@ void FbxFileImporter::LoadRestPoseFromFile( char const* filename, AnimPose& outP
 		jointQueue.pop();
 	}
 
+	outPose = AnimPose( std::make_shared<Skeleton const>( skeletonJoints ) );
+
 	fbxScene->Destroy();
 	fbxManager->Destroy();
 }
@@ -426,12 +429,13 @@ void FbxFileImporter::LoadRestPoseAndAnimationData( char const* file )
 	}
 
 	// child skeletal joints
+	std::vector<SkeletonJoint> skeletonJoints;
 	while ( !jointQueue.empty() )
 	{
 		// skeletal joint data
 		Joint& joint = jointQueue.front();
-		AddJointNodeToPose( joint.m_fbxNode, joint.m_parentIndex, m_restPose );
-		joint.m_jointId = m_restPose.GetNumberOfJoints() - 1;
+		AddJointNodeToSkeleton( joint.m_fbxNode, joint.m_parentIndex, skeletonJoints );
+		joint.m_jointId = ( int ) skeletonJoints.size() - 1;
 
 		// animation data
 		AddJointNodeAnimData( joint.m_fbxNode, joint.m_jointId, fbxAnimlayer, m_animClip );
@@ -450,6 +454,7 @@ void FbxFileImporter::LoadRestPoseAndAnimationData( char const* file )
 		jointQueue.pop();
 	}
 
+	m_restPose = AnimPose( std::make_shared<Skeleton const>( skeletonJoints ) );
 	m_animClip->CalculateTimeStamps();
 
 	fbxScene->Destroy();
@@ -458,14 +463,18 @@ void FbxFileImporter::LoadRestPoseAndAnimationData( char const* file )
 
 
 //----------------------------------------------------------------------------------------------------------
-void AddJointNodeToPose( FbxNode* fbxNode, int parentIndex, AnimPose& pose )
+void AddJointNodeToSkeleton( FbxNode* fbxNode, int parentIndex, std::vector<SkeletonJoint>& skeletonJoints )
 {
 	FbxAMatrix	  fbxTransform			= fbxNode->EvaluateLocalTransform();
 	FbxVector4	  fbxPosition			= fbxTransform.GetT();
 	FbxQuaternion fbxQuaternionRotation = fbxTransform.GetQ();
 	FbxVector4	  fbxScale				= fbxTransform.GetS();
 
-	Transform	  localTransform;
+	SkeletonJoint joint;
+	joint.m_name		= fbxNode->GetName();
+	joint.m_parentIndex = parentIndex;
+
+	Transform&	  localTransform = joint.m_bindLocalTransform;
 	localTransform.m_position.x = ( float ) fbxPosition[ 0 ];
 	localTransform.m_position.y = ( float ) fbxPosition[ 1 ];
 	localTransform.m_position.z = ( float ) fbxPosition[ 2 ];
@@ -479,7 +488,7 @@ void AddJointNodeToPose( FbxNode* fbxNode, int parentIndex, AnimPose& pose )
 	localTransform.m_scale.y	= ( float ) fbxScale[ 1 ];
 	localTransform.m_scale.z	= ( float ) fbxScale[ 2 ];
 
-	pose.AddJoint( localTransform, parentIndex, fbxNode->GetName());
+	skeletonJoints.push_back( joint );
 }
 
 
@@ -0,0 +1,139 @@
+#include "Engine/Animation/Skeleton.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------
+Skeleton::Skeleton( std::vector<SkeletonJoint> const& joints )
+{
+	int numJoints = ( int ) joints.size();
+	m_parentJointIndices.reserve( numJoints );
+	m_jointNames.reserve( numJoints );
+	m_bindLocalTransforms.reserve( numJoints );
+	m_jointIndicesByName.reserve( numJoints );
+
+	for ( int jointIndex = 0; jointIndex < numJoints; jointIndex++ )
+	{
+		SkeletonJoint const& joint = joints[ jointIndex ];
+		m_parentJointIndices.push_back( joint.m_parentIndex );
+		m_jointNames.push_back( joint.m_name );
+		m_bindLocalTransforms.push_back( joint.m_bindLocalTransform );
+
+		// the first joint of a name wins, same as a linear search would find
+		m_jointIndicesByName.emplace( joint.m_name, jointIndex );
+	}
+
+	CalculateEvaluationOrder();
+	CalculateGlobalInverseBindPoseMatrices();
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int Skeleton::GetJointIndex( std::string const& jointName ) const
+{
+	auto found = m_jointIndicesByName.find( jointName );
+	if ( found == m_jointIndicesByName.end() )
+	{
+		return -1;
+	}
+	return found->second;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+bool Skeleton::IsJointUnderRootHierarchy( int jointId, int rootId ) const
+{
+	if ( jointId == rootId )
+	{
+		return true;
+	}
+
+	// bubble up and find root
+	int parentJointId = m_parentJointIndices[ jointId ];
+	while ( parentJointId >= 0 )
+	{
+		if ( parentJointId == rootId )
+		{
+			return true;
+		}
+		parentJointId = m_parentJointIndices[ parentJointId ];
+	}
+
+	return false;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void Skeleton::CalculateEvaluationOrder()
+{
+	int	 numJoints		= GetNumberOfJoints();
+	bool isParentsFirst = true;
+	for ( int jointIndex = 0; jointIndex < numJoints; jointIndex++ )
+	{
+		isParentsFirst = isParentsFirst && m_parentJointIndices[ jointIndex ] < jointIndex;
+	}
+
+	// importers add parents first, so normally there is nothing to do
+	if ( isParentsFirst )
+	{
+		return;
+	}
+
+	// otherwise order by depth; a parent is always one level above its children
+	std::vector<int> jointDepths( numJoints, -1 );
+	int				 maxDepth = 0;
+	for ( int jointIndex = 0; jointIndex < numJoints; jointIndex++ )
+	{
+		int depth		= 0;
+		int parentIndex = m_parentJointIndices[ jointIndex ];
+		while ( parentIndex >= 0 && parentIndex < numJoints )
+		{
+			++depth;
+			parentIndex = m_parentJointIndices[ parentIndex ];
+		}
+		jointDepths[ jointIndex ] = depth;
+		maxDepth				  = depth > maxDepth ? depth : maxDepth;
+	}
+
+	m_evaluationOrder.reserve( numJoints );
+	for ( int depth = 0; depth <= maxDepth; depth++ )
+	{
+		for ( int jointIndex = 0; jointIndex < numJoints; jointIndex++ )
+		{
+			if ( jointDepths[ jointIndex ] == depth )
+			{
+				m_evaluationOrder.push_back( jointIndex );
+			}
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void Skeleton::CalculateGlobalInverseBindPoseMatrices()
+{
+	int					   numJoints = GetNumberOfJoints();
+	std::vector<Transform> jointGlobalTransforms( numJoints );
+	for ( int orderIndex = 0; orderIndex < numJoints; orderIndex++ )
+	{
+		int jointIndex	= m_evaluationOrder.empty() ? orderIndex : m_evaluationOrder[ orderIndex ];
+		int parentIndex = m_parentJointIndices[ jointIndex ];
+		if ( parentIndex < 0 )
+		{
+			jointGlobalTransforms[ jointIndex ] = m_bindLocalTransforms[ jointIndex ];
+		}
+		else
+		{
+			jointGlobalTransforms[ jointIndex ] = Transform::ApplyChildToParentTransform( m_bindLocalTransforms[ jointIndex ], jointGlobalTransforms[ parentIndex ] );
+		}
+	}
+
+	m_globalInverseBindPoseMatrices.reserve( numJoints );
+	for ( int jointIndex = 0; jointIndex < numJoints; jointIndex++ )
+	{
+		Transform jointGlobalTransform	 = jointGlobalTransforms[ jointIndex ];
+		jointGlobalTransform.m_scale	 = Vec3( 1.f, 1.f, 1.f );
+		Mat44 jointGlobalTransformMatrix = Mat44::CreateFromTransform( jointGlobalTransform );
+		Mat44 jointGlobalInverseBindPoseMatrix = jointGlobalTransformMatrix.GetOrthonormalInverse();
+
+		m_globalInverseBindPoseMatrices.push_back( jointGlobalInverseBindPoseMatrix );
+	}
+}
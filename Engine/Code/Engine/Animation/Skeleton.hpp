@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Engine/Math/Transform.hpp"
+#include "Engine/Math/Mat44.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------------
+// One joint as the importer finds it, in the order the skeleton will index it
+struct SkeletonJoint
+{
+	std::string m_name;
+	int			m_parentIndex = -1;
+	Transform	m_bindLocalTransform;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// The joint hierarchy of a character: topology, names, bind pose and inverse bind matrices.
+// Built once from the imported joints and never changed after, so every pose, clip instance
+// and blend node of the character shares one through a std::shared_ptr<Skeleton const>.
+class Skeleton
+{
+public:
+	explicit Skeleton( std::vector<SkeletonJoint> const& joints );
+
+	int				   GetNumberOfJoints() const { return ( int ) m_parentJointIndices.size(); }
+	int				   GetParentOfJoint( int jointId ) const { return m_parentJointIndices[ jointId ]; }
+	std::string const& GetJointName( int jointId ) const { return m_jointNames[ jointId ]; }
+	int				   GetJointIndex( std::string const& jointName ) const; // -1 if there is no such joint
+	bool			   IsJointUnderRootHierarchy( int jointId, int rootId ) const;
+
+	Transform const& GetBindLocalTransformOfJoint( int jointId ) const { return m_bindLocalTransforms[ jointId ]; }
+	Mat44 const&	 GetGlobalInverseBindPoseMatrixOfJoint( int jointId ) const { return m_globalInverseBindPoseMatrices[ jointId ]; }
+
+	// joints ordered parents before children; empty while every parent already comes before its children
+	std::vector<int> const& GetEvaluationOrder() const { return m_evaluationOrder; }
+
+private:
+	void CalculateEvaluationOrder();
+	void CalculateGlobalInverseBindPoseMatrices();
+
+	std::vector<int>					 m_parentJointIndices;
+	std::vector<std::string>			 m_jointNames;
+	std::unordered_map<std::string, int> m_jointIndicesByName;
+	std::vector<Transform>				 m_bindLocalTransforms;
+	std::vector<Mat44>					 m_globalInverseBindPoseMatrices;
+	std::vector<int>					 m_evaluationOrder;
+};
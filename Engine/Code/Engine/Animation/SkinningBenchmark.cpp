@@ -0,0 +1,176 @@
+#include "Engine/Animation/SkinningBenchmark.hpp"
+#include "Engine/Animation/AnimPose.hpp"
+#include "Engine/Animation/SkinningUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+
+#include <math.h>
+#include <memory>
+
+
+//----------------------------------------------------------------------------------------------------------
+static void LogToDevConsole( Rgba8 const& color, std::string const& text )
+{
+	if ( g_theDevConsole )
+	{
+		g_theDevConsole->AddLine( color, text );
+	}
+	else
+	{
+		DebuggerPrintf( "%s\n", text.c_str() );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// A binary tree of joints, each turned a little from its parent, posed away from the bind pose
+static std::shared_ptr<Skeleton const> CreateBenchmarkPose( int numJoints, AnimPose& out_pose )
+{
+	std::vector<SkeletonJoint> joints( numJoints );
+	for ( int jointId = 0; jointId < numJoints; jointId++ )
+	{
+		Quaternion bindRotation				   = Quaternion::MakeFromAxisOfRotationAndAngleDegrees( Vec3( 0.f, 0.f, 1.f ), 5.f * ( float ) jointId );
+		joints[ jointId ].m_name			   = Stringf( "Joint%d", jointId );
+		joints[ jointId ].m_parentIndex		   = jointId == 0 ? -1 : ( jointId - 1 ) / 2;
+		joints[ jointId ].m_bindLocalTransform = Transform( Vec3( 1.f, 0.2f, 0.f ), bindRotation, Vec3( 1.f, 1.f, 1.f ) );
+	}
+	std::shared_ptr<Skeleton const> skeleton = std::make_shared<Skeleton const>( joints );
+
+	out_pose = AnimPose( skeleton );
+	for ( int jointId = 0; jointId < numJoints; jointId++ )
+	{
+		Transform localTransform  = out_pose.GetLocalTransformOfJoint( jointId );
+		localTransform.m_rotation = Quaternion::MakeFromAxisOfRotationAndAngleDegrees( Vec3( 0.f, 0.6f, 0.8f ), 30.f + ( float ) jointId ) * localTransform.m_rotation;
+		out_pose.SetLocalTransformOfJoint( localTransform, jointId );
+	}
+	return skeleton;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+SkinningBenchmarkResult RunSkinningBenchmark( SkinningBenchmarkSettings const& settings )
+{
+	AnimPose						pose;
+	std::shared_ptr<Skeleton const> skeleton = CreateBenchmarkPose( settings.m_numJoints, pose );
+
+	RandomNumberGenerator rng;
+	rng.SetSeed( settings.m_seed );
+
+	std::vector<Vertex_PCUTBN>						vertexes( settings.m_numVertexes );
+	std::vector<std::vector<std::pair<int, float>>> jointAndWeightsMapping( settings.m_numVertexes );
+	for ( int vertexIndex = 0; vertexIndex < settings.m_numVertexes; vertexIndex++ )
+	{
+		vertexes[ vertexIndex ].m_position = Vec3( rng.RollRandomFloatLessThan( 10.f ), rng.RollRandomFloatLessThan( 10.f ), rng.RollRandomFloatLessThan( 10.f ) );
+		vertexes[ vertexIndex ].m_normal   = Vec3( rng.RollRandomFloatInRange( -0.5f, 0.5f ), rng.RollRandomFloatInRange( -0.5f, 0.5f ), rng.RollRandomFloatInRange( 0.1f, 1.1f ) ).GetNormalized();
+
+		int numVertexJoints = vertexIndex % 7 == 0 ? 1 : rng.RollRandomIntInRange( 1, 5 );
+		for ( int vertexJointIndex = 0; vertexJointIndex < numVertexJoints; vertexJointIndex++ )
+		{
+			jointAndWeightsMapping[ vertexIndex ].push_back( { rng.RollRandomIntLessThan( settings.m_numJoints ), rng.RollRandomFloatInRange( 0.01f, 1.01f ) } );
+		}
+	}
+
+	std::vector<Vertex_Skeletal> skeletalVertexes;
+	CreateSkeletalVertexes( vertexes, jointAndWeightsMapping, skeletalVertexes );
+
+	std::vector<Mat44>					globalMatrices;
+	std::vector<Mat44>					skinningMatrices;
+	std::vector<SkinningDualQuaternion> skinningDualQuaternions;
+	pose.GetGlobalMatrices( globalMatrices );
+	CalculateSkinningMatrices( pose, globalMatrices, skinningMatrices );
+	CalculateSkinningDualQuaternions( skinningMatrices, skinningDualQuaternions );
+
+	SkinningBenchmarkResult result;
+	double					millionVertexes = ( double ) settings.m_numVertexes * ( double ) settings.m_numRepeats / 1.0e6;
+
+	// how the engine skinned on the CPU before Vertex_Skeletal: every weight of the importer's mapping
+	std::vector<Vec3> scalarPositions( settings.m_numVertexes );
+	std::vector<Vec3> scalarNormals( settings.m_numVertexes );
+	double			  startSeconds = GetCurrentTimeSeconds();
+	for ( int repeatIndex = 0; repeatIndex < settings.m_numRepeats; repeatIndex++ )
+	{
+		for ( int vertexIndex = 0; vertexIndex < settings.m_numVertexes; vertexIndex++ )
+		{
+			float totalWeight = 0.f;
+			for ( std::pair<int, float> const& jointAndWeight : jointAndWeightsMapping[ vertexIndex ] )
+			{
+				totalWeight += jointAndWeight.second;
+			}
+
+			Vec3 position = Vec3::ZERO;
+			Vec3 normal	  = Vec3::ZERO;
+			for ( std::pair<int, float> const& jointAndWeight : jointAndWeightsMapping[ vertexIndex ] )
+			{
+				Mat44 const& skinningMatrix = skinningMatrices[ jointAndWeight.first ];
+				float		 weight			= jointAndWeight.second / totalWeight;
+				position += skinningMatrix.TransformPosition3D( vertexes[ vertexIndex ].m_position ) * weight;
+				normal += skinningMatrix.TransformVectorQuantity3D( vertexes[ vertexIndex ].m_normal ) * weight;
+			}
+			scalarPositions[ vertexIndex ] = position;
+			scalarNormals[ vertexIndex ]   = normal.GetNormalized();
+		}
+	}
+	result.m_scalarMillionVertexesPerSecond = millionVertexes / ( GetCurrentTimeSeconds() - startSeconds );
+
+	std::vector<Vec3> linearBlendPositions;
+	std::vector<Vec3> linearBlendNormals;
+	startSeconds = GetCurrentTimeSeconds();
+	for ( int repeatIndex = 0; repeatIndex < settings.m_numRepeats; repeatIndex++ )
+	{
+		SkinVertexesLinearBlend( skeletalVertexes, skinningMatrices, linearBlendPositions, &linearBlendNormals );
+	}
+	result.m_linearBlendMillionVertexesPerSecond = millionVertexes / ( GetCurrentTimeSeconds() - startSeconds );
+
+	std::vector<Vec3> dualQuaternionPositions;
+	std::vector<Vec3> dualQuaternionNormals;
+	startSeconds = GetCurrentTimeSeconds();
+	for ( int repeatIndex = 0; repeatIndex < settings.m_numRepeats; repeatIndex++ )
+	{
+		SkinVertexesDualQuaternion( skeletalVertexes, skinningDualQuaternions, dualQuaternionPositions, &dualQuaternionNormals );
+	}
+	result.m_dualQuaternionMillionVertexesPerSecond = millionVertexes / ( GetCurrentTimeSeconds() - startSeconds );
+
+	for ( int vertexIndex = 0; vertexIndex < settings.m_numVertexes; vertexIndex++ )
+	{
+		std::vector<std::pair<int, float>> const& jointAndWeights = jointAndWeightsMapping[ vertexIndex ];
+		if ( jointAndWeights.size() <= MAX_JOINTS_PER_SKINNED_VERTEX )
+		{
+			float difference				  = ( linearBlendPositions[ vertexIndex ] - scalarPositions[ vertexIndex ] ).GetLength();
+			result.m_maxLinearBlendDifference = fmaxf( result.m_maxLinearBlendDifference, difference );
+		}
+		if ( jointAndWeights.size() == 1 )
+		{
+			float difference						  = ( dualQuaternionPositions[ vertexIndex ] - scalarPositions[ vertexIndex ] ).GetLength();
+			result.m_maxRigidDualQuaternionDifference = fmaxf( result.m_maxRigidDualQuaternionDifference, difference );
+		}
+	}
+	return result;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+bool Command_SkinBench( EventArgs& args )
+{
+	SkinningBenchmarkSettings settings;
+	settings.m_numJoints   = args.GetValue( "Joints", settings.m_numJoints );
+	settings.m_numVertexes = args.GetValue( "Vertexes", settings.m_numVertexes );
+	if ( settings.m_numJoints < 1 || settings.m_numVertexes < 1 )
+	{
+		LogToDevConsole( DevConsole::ERROR_COLOR, "SkinBench: Joints and Vertexes have to be at least 1" );
+		return true;
+	}
+
+	SkinningBenchmarkResult result = RunSkinningBenchmark( settings );
+	LogToDevConsole( DevConsole::INFO_MAJOR_COLOR, Stringf( "SkinBench: %d joints, %d vertexes; million vertexes per second with normals:", settings.m_numJoints,
+		settings.m_numVertexes ) );
+	LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "  scalar Mat44 %.1f, linear blend %.1f, dual quaternion %.1f", result.m_scalarMillionVertexesPerSecond,
+		result.m_linearBlendMillionVertexesPerSecond, result.m_dualQuaternionMillionVertexesPerSecond ) );
+	LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "  max position difference: linear blend %.4f from scalar, dual quaternion %.6f on rigid vertexes",
+		result.m_maxLinearBlendDifference, result.m_maxRigidDualQuaternionDifference ) );
+	return true;
+}
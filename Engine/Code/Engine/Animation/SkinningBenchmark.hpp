@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------
+struct SkinningBenchmarkSettings
+{
+	int			 m_numJoints   = 60;
+	int			 m_numVertexes = 50000; // one in seven moved by one joint, the rest by one to five
+	int			 m_numRepeats  = 100;
+	unsigned int m_seed		   = 7;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct SkinningBenchmarkResult
+{
+	double m_scalarMillionVertexesPerSecond			= 0.0; // a Mat44 transform per joint weight, from the unpacked weights
+	double m_linearBlendMillionVertexesPerSecond	= 0.0;
+	double m_dualQuaternionMillionVertexesPerSecond	= 0.0;
+	float  m_maxLinearBlendDifference				= 0.0f; // from the scalar positions, on vertexes of four joints or fewer; weights are bytes
+	float  m_maxRigidDualQuaternionDifference		= 0.0f; // from the skinning matrix, on vertexes of one joint
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Positions and normals per second for a posed skeleton, skinned the way the engine did before
+// Vertex_Skeletal, with SkinVertexesLinearBlend() and with SkinVertexesDualQuaternion()
+SkinningBenchmarkResult RunSkinningBenchmark( SkinningBenchmarkSettings const& settings );
+
+// "SkinBench Joints=60 Vertexes=50000"; logs millions of vertexes per second
+// DevConsole::Startup() subscribes it
+bool Command_SkinBench( EventArgs& args );
@@ -0,0 +1,178 @@
+#include "Engine/Animation/SkinningUtils.hpp"
+#include "Engine/Animation/AnimPose.hpp"
+#include "Engine/Core/ParallelFor.hpp"
+#include "Engine/Math/MathSIMD.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------
+void CalculateSkinningMatrices( AnimPose const& pose, std::vector<Mat44> const& globalMatrices, std::vector<Mat44>& out_skinningMatrices )
+{
+	int numJoints = ( int ) globalMatrices.size();
+	out_skinningMatrices.resize( numJoints );
+	if ( numJoints > 0 )
+	{
+		Mat44::AppendEach( globalMatrices.data(), &pose.GetGlobalInverseBindPoseMatrixOfJoint( 0 ), out_skinningMatrices.data(), numJoints );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void CalculateSkinningDualQuaternions( std::vector<Mat44> const& skinningMatrices, std::vector<SkinningDualQuaternion>& out_skinningDualQuaternions )
+{
+	int numJoints = ( int ) skinningMatrices.size();
+	out_skinningDualQuaternions.resize( numJoints );
+	for ( int jointIndex = 0; jointIndex < numJoints; jointIndex++ )
+	{
+		// take the scale out so only the rotation goes into the quaternion
+		Mat44 const& skinningMatrix = skinningMatrices[ jointIndex ];
+		Mat44		 rotationMatrix;
+		rotationMatrix.SetIJK3D( skinningMatrix.GetIBasis3D().GetNormalized(), skinningMatrix.GetJBasis3D().GetNormalized(), skinningMatrix.GetKBasis3D().GetNormalized() );
+
+		Quaternion rotation	   = Quaternion::MakeFromMatrix( rotationMatrix ).GetNormalized();
+		Vec3	   translation = skinningMatrix.GetTranslation3D();
+
+		// 0.5 * ( translation, 0 ) * rotation
+		SkinningDualQuaternion& dualQuaternion = out_skinningDualQuaternions[ jointIndex ];
+		dualQuaternion.m_real				   = rotation;
+		dualQuaternion.m_dual				   = Quaternion( translation.x, translation.y, translation.z, 0.f ) * rotation * 0.5f;
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Blends the columns of the vertex's skinning matrices, then transforms by the blended matrix
+void SkinVertexRangeLinearBlend( Vertex_Skeletal const* vertexes, int beginIndex, int endIndex, Mat44 const* skinningMatrices, Vec3* out_positions, Vec3* out_normals )
+{
+	for ( int vertexIndex = beginIndex; vertexIndex < endIndex; vertexIndex++ )
+	{
+		Vertex_Skeletal const& vertex = vertexes[ vertexIndex ];
+
+		__m128 iBasis	   = _mm_setzero_ps();
+		__m128 jBasis	   = _mm_setzero_ps();
+		__m128 kBasis	   = _mm_setzero_ps();
+		__m128 translation = _mm_setzero_ps();
+
+		// weights are sorted heaviest first, so the first 0 ends the vertex's joints
+		for ( int slot = 0; slot < MAX_JOINTS_PER_SKINNED_VERTEX && vertex.m_jointWeights[ slot ] != 0; slot++ )
+		{
+			float const* matrixValues = skinningMatrices[ vertex.m_jointIndices[ slot ] ].m_values;
+			__m128		 weight		  = _mm_set1_ps( vertex.GetJointWeight( slot ) );
+
+			iBasis		= _mm_add_ps( iBasis, _mm_mul_ps( weight, _mm_loadu_ps( matrixValues + Mat44::Ix ) ) );
+			jBasis		= _mm_add_ps( jBasis, _mm_mul_ps( weight, _mm_loadu_ps( matrixValues + Mat44::Jx ) ) );
+			kBasis		= _mm_add_ps( kBasis, _mm_mul_ps( weight, _mm_loadu_ps( matrixValues + Mat44::Kx ) ) );
+			translation = _mm_add_ps( translation, _mm_mul_ps( weight, _mm_loadu_ps( matrixValues + Mat44::Tx ) ) );
+		}
+
+		Vec3 const& position		= vertex.m_position;
+		__m128		skinnedPosition = SIMDTransformByColumns( iBasis, jBasis, kBasis, translation, position.x, position.y, position.z, 1.f );
+		SIMDStoreVec3( out_positions[ vertexIndex ], skinnedPosition );
+
+		if ( out_normals != nullptr )
+		{
+			// the blended matrix isn't orthonormal, so renormalize; non uniform joint scale would need the inverse transpose
+			Vec3 const& normal		  = vertex.m_normal;
+			__m128		skinnedNormal = _mm_add_ps( _mm_add_ps( _mm_mul_ps( iBasis, _mm_set1_ps( normal.x ) ), _mm_mul_ps( jBasis, _mm_set1_ps( normal.y ) ) ),
+					 _mm_mul_ps( kBasis, _mm_set1_ps( normal.z ) ) );
+			skinnedNormal			  = _mm_and_ps( skinnedNormal, _mm_castsi128_ps( _mm_set_epi32( 0, -1, -1, -1 ) ) );
+			SIMDStoreVec3( out_normals[ vertexIndex ], SIMDNormalize3( skinnedNormal ) );
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Blends the vertex's dual quaternions on the hemisphere of the heaviest one, normalizes, then
+// rotates and translates; bends keep their volume where linear blending collapses them
+void SkinVertexRangeDualQuaternion( Vertex_Skeletal const* vertexes, int beginIndex, int endIndex, SkinningDualQuaternion const* skinningDualQuaternions, Vec3* out_positions,
+	Vec3* out_normals )
+{
+	for ( int vertexIndex = beginIndex; vertexIndex < endIndex; vertexIndex++ )
+	{
+		Vertex_Skeletal const& vertex = vertexes[ vertexIndex ];
+
+		SkinningDualQuaternion const& heaviest	   = skinningDualQuaternions[ vertex.m_jointIndices[ 0 ] ];
+		__m128						  heaviestReal = _mm_loadu_ps( &heaviest.m_real.x );
+		__m128						  real		   = _mm_mul_ps( heaviestReal, _mm_set1_ps( vertex.GetJointWeight( 0 ) ) );
+		__m128						  dual		   = _mm_mul_ps( _mm_loadu_ps( &heaviest.m_dual.x ), _mm_set1_ps( vertex.GetJointWeight( 0 ) ) );
+
+		for ( int slot = 1; slot < MAX_JOINTS_PER_SKINNED_VERTEX && vertex.m_jointWeights[ slot ] != 0; slot++ )
+		{
+			SkinningDualQuaternion const& dualQuaternion = skinningDualQuaternions[ vertex.m_jointIndices[ slot ] ];
+			__m128						  jointReal		 = _mm_loadu_ps( &dualQuaternion.m_real.x );
+
+			// q and -q are the same rotation, flip the weight of joints on the other hemisphere
+			__m128 weight	 = _mm_set1_ps( vertex.GetJointWeight( slot ) );
+			__m128 isFlipped = _mm_cmplt_ps( SIMDDotProduct4( heaviestReal, jointReal ), _mm_setzero_ps() );
+			weight			 = _mm_xor_ps( weight, _mm_and_ps( isFlipped, _mm_set1_ps( -0.f ) ) );
+
+			real = _mm_add_ps( real, _mm_mul_ps( weight, jointReal ) );
+			dual = _mm_add_ps( dual, _mm_mul_ps( weight, _mm_loadu_ps( &dualQuaternion.m_dual.x ) ) );
+		}
+
+		__m128 inverseLength = _mm_div_ps( _mm_set1_ps( 1.f ), _mm_sqrt_ps( SIMDDotProduct4( real, real ) ) );
+		real				 = _mm_mul_ps( real, inverseLength );
+		dual				 = _mm_mul_ps( dual, inverseLength );
+
+		// translation = 2 * ( real.w * dual.xyz - dual.w * real.xyz + real.xyz x dual.xyz )
+		__m128 xyzMask		= _mm_castsi128_ps( _mm_set_epi32( 0, -1, -1, -1 ) );
+		__m128 realW		= SIMDSplatW( real );
+		__m128 dualW		= SIMDSplatW( dual );
+		__m128 realXYZ		= _mm_and_ps( real, xyzMask );
+		__m128 dualXYZ		= _mm_and_ps( dual, xyzMask );
+		__m128 translation	= _mm_add_ps( _mm_sub_ps( _mm_mul_ps( realW, dualXYZ ), _mm_mul_ps( dualW, realXYZ ) ), SIMDCrossProduct3( realXYZ, dualXYZ ) );
+		translation			= _mm_add_ps( translation, translation );
+
+		__m128 skinnedPosition = _mm_add_ps( SIMDRotateByUnitQuaternion( real, SIMDLoadVec3( vertex.m_position ) ), translation );
+		SIMDStoreVec3( out_positions[ vertexIndex ], skinnedPosition );
+
+		if ( out_normals != nullptr )
+		{
+			SIMDStoreVec3( out_normals[ vertexIndex ], SIMDRotateByUnitQuaternion( real, SIMDLoadVec3( vertex.m_normal ) ) );
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void SkinVertexesLinearBlend( std::vector<Vertex_Skeletal> const& vertexes, std::vector<Mat44> const& skinningMatrices, std::vector<Vec3>& out_positions,
+	std::vector<Vec3>* out_normals )
+{
+	int numVertexes = ( int ) vertexes.size();
+	int numChunks	= ( numVertexes + SKINNING_VERTEXES_PER_PARALLEL_CHUNK - 1 ) / SKINNING_VERTEXES_PER_PARALLEL_CHUNK;
+	out_positions.resize( numVertexes );
+	if ( out_normals != nullptr )
+	{
+		out_normals->resize( numVertexes );
+	}
+
+	Vec3* normals = out_normals != nullptr ? out_normals->data() : nullptr;
+	ParallelFor( 0, numChunks, 1, [ & ]( int chunkIndex )
+		{
+			int beginIndex = chunkIndex * SKINNING_VERTEXES_PER_PARALLEL_CHUNK;
+			int endIndex   = beginIndex + SKINNING_VERTEXES_PER_PARALLEL_CHUNK < numVertexes ? beginIndex + SKINNING_VERTEXES_PER_PARALLEL_CHUNK : numVertexes;
+			SkinVertexRangeLinearBlend( vertexes.data(), beginIndex, endIndex, skinningMatrices.data(), out_positions.data(), normals );
+		} );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void SkinVertexesDualQuaternion( std::vector<Vertex_Skeletal> const& vertexes, std::vector<SkinningDualQuaternion> const& skinningDualQuaternions,
+	std::vector<Vec3>& out_positions, std::vector<Vec3>* out_normals )
+{
+	int numVertexes = ( int ) vertexes.size();
+	int numChunks	= ( numVertexes + SKINNING_VERTEXES_PER_PARALLEL_CHUNK - 1 ) / SKINNING_VERTEXES_PER_PARALLEL_CHUNK;
+	out_positions.resize( numVertexes );
+	if ( out_normals != nullptr )
+	{
+		out_normals->resize( numVertexes );
+	}
+
+	Vec3* normals = out_normals != nullptr ? out_normals->data() : nullptr;
+	ParallelFor( 0, numChunks, 1, [ & ]( int chunkIndex )
+		{
+			int beginIndex = chunkIndex * SKINNING_VERTEXES_PER_PARALLEL_CHUNK;
+			int endIndex   = beginIndex + SKINNING_VERTEXES_PER_PARALLEL_CHUNK < numVertexes ? beginIndex + SKINNING_VERTEXES_PER_PARALLEL_CHUNK : numVertexes;
+			SkinVertexRangeDualQuaternion( vertexes.data(), beginIndex, endIndex, skinningDualQuaternions.data(), out_positions.data(), normals );
+		} );
+}
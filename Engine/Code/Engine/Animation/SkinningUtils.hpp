@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Engine/Animation/Vertex_Skeletal.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Quaternion.hpp"
+
+#include <vector>
+
+
+class AnimPose;
+
+
+//----------------------------------------------------------------------------------------------------------
+// CPU skinning, for the places that need skinned positions without a GPU (hit boxes on a server,
+// ray casts against characters). Both kernels transform one vertex at a time with SSE2, and every
+// vertex only writes its own outputs, so vertex ranges can run on any number of threads.
+//
+//	pose.GetGlobalMatrices( globalMatrices );
+//	CalculateSkinningMatrices( pose, globalMatrices, skinningMatrices );
+//	SkinVertexesLinearBlend( skeletalVertexes, skinningMatrices, positions, &normals );
+//----------------------------------------------------------------------------------------------------------
+constexpr int SKINNING_VERTEXES_PER_PARALLEL_CHUNK = 1024;
+
+
+//----------------------------------------------------------------------------------------------------------
+// The rigid part of a skinning matrix; dual quaternion skinning ignores joint scale
+struct SkinningDualQuaternion
+{
+	Quaternion m_real; // rotation
+	Quaternion m_dual = Quaternion( 0.f, 0.f, 0.f, 0.f ); // half the translation times the rotation
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// globalMatrices as AnimPose::GetGlobalMatrices() or GetMatrixArray() give them; each result is the
+// global matrix of the joint times its inverse bind pose matrix. The outputs are resized
+void CalculateSkinningMatrices( AnimPose const& pose, std::vector<Mat44> const& globalMatrices, std::vector<Mat44>& out_skinningMatrices );
+void CalculateSkinningDualQuaternions( std::vector<Mat44> const& skinningMatrices, std::vector<SkinningDualQuaternion>& out_skinningDualQuaternions );
+
+// One range of vertexes, for callers that split the work themselves; the outputs are indexed like
+// the vertexes and out_normals may be nullptr
+void SkinVertexRangeLinearBlend( Vertex_Skeletal const* vertexes, int beginIndex, int endIndex, Mat44 const* skinningMatrices, Vec3* out_positions, Vec3* out_normals );
+void SkinVertexRangeDualQuaternion( Vertex_Skeletal const* vertexes, int beginIndex, int endIndex, SkinningDualQuaternion const* skinningDualQuaternions, Vec3* out_positions,
+	Vec3* out_normals );
+
+// Every vertex, spread over ParallelFor() in chunks of SKINNING_VERTEXES_PER_PARALLEL_CHUNK; the outputs are resized
+void SkinVertexesLinearBlend( std::vector<Vertex_Skeletal> const& vertexes, std::vector<Mat44> const& skinningMatrices, std::vector<Vec3>& out_positions,
+	std::vector<Vec3>* out_normals = nullptr );
+void SkinVertexesDualQuaternion( std::vector<Vertex_Skeletal> const& vertexes, std::vector<SkinningDualQuaternion> const& skinningDualQuaternions,
+	std::vector<Vec3>& out_positions, std::vector<Vec3>* out_normals = nullptr );
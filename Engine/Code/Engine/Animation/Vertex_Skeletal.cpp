@@ -1,4 +1,9 @@
 #include "Engine/Animation/Vertex_Skeletal.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+
+#include <algorithm>
+#include <math.h>
 
 
 //----------------------------------------------------------------------------------------------------------
@@ -9,6 +14,69 @@ Vertex_Skeletal::Vertex_Skeletal()
 
 //----------------------------------------------------------------------------------------------------------
 Vertex_Skeletal::Vertex_Skeletal( Vec3 const& position, Rgba8 color, Vec2 uvTexCoords, Vec3 const& tangent, Vec3 const& biTangent, Vec3 const& normal, int jointId )
-	: m_position( position ), m_color( color ), m_uvTexCoords( uvTexCoords ), m_tangent( tangent ), m_bitangent( biTangent ), m_normal( normal ), m_jointId( jointId )
+	: m_position( position ), m_color( color ), m_uvTexCoords( uvTexCoords ), m_tangent( tangent ), m_bitangent( biTangent ), m_normal( normal )
+{
+	m_jointIndices[ 0 ] = ( unsigned short ) jointId;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+Vertex_Skeletal::Vertex_Skeletal( Vertex_PCUTBN const& vertex, std::vector<std::pair<int, float>> const& jointAndWeights )
+	: m_position( vertex.m_position ), m_color( vertex.m_color ), m_uvTexCoords( vertex.m_uvTexCoords ), m_tangent( vertex.m_tangent ), m_bitangent( vertex.m_bitangent ), m_normal( vertex.m_normal )
+{
+	SetJointWeights( jointAndWeights );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void Vertex_Skeletal::SetJointWeights( std::vector<std::pair<int, float>> const& jointAndWeights )
+{
+	std::pair<int, float> heaviest[ MAX_JOINTS_PER_SKINNED_VERTEX ];
+	int					  numJoints = ( int ) std::min( jointAndWeights.size(), ( size_t ) MAX_JOINTS_PER_SKINNED_VERTEX );
+	std::partial_sort_copy( jointAndWeights.begin(), jointAndWeights.end(), heaviest, heaviest + numJoints,
+		[]( std::pair<int, float> const& a, std::pair<int, float> const& b ) { return a.second > b.second; } );
+
+	float totalWeight = 0.f;
+	for ( int slot = 0; slot < numJoints; slot++ )
+	{
+		totalWeight += heaviest[ slot ].second;
+	}
+
+	for ( int slot = 0; slot < MAX_JOINTS_PER_SKINNED_VERTEX; slot++ )
+	{
+		m_jointIndices[ slot ] = 0;
+		m_jointWeights[ slot ] = 0;
+	}
+	if ( numJoints == 0 || totalWeight <= 0.f )
+	{
+		m_jointIndices[ 0 ] = numJoints == 0 ? 0 : ( unsigned short ) heaviest[ 0 ].first;
+		m_jointWeights[ 0 ] = 255;
+		return;
+	}
+
+	// rounding may leave the bytes a little off 255; the heaviest joint takes up the difference
+	int quantizedTotal = 0;
+	for ( int slot = 0; slot < numJoints; slot++ )
+	{
+		GUARANTEE_OR_DIE( heaviest[ slot ].first >= 0 && heaviest[ slot ].first <= 0xFFFF, "Skinned vertex joint index out of range" );
+		int quantizedWeight	   = ( int ) floorf( heaviest[ slot ].second / totalWeight * 255.f + 0.5f );
+		m_jointIndices[ slot ] = ( unsigned short ) heaviest[ slot ].first;
+		m_jointWeights[ slot ] = ( unsigned char ) quantizedWeight;
+		quantizedTotal += quantizedWeight;
+	}
+	m_jointWeights[ 0 ] = ( unsigned char ) ( m_jointWeights[ 0 ] + 255 - quantizedTotal );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void CreateSkeletalVertexes( std::vector<Vertex_PCUTBN> const& vertexes, std::vector<std::vector<std::pair<int, float>>> const& jointAndWeightsMapping,
+	std::vector<Vertex_Skeletal>& out_skeletalVertexes )
 {
+	GUARANTEE_OR_DIE( vertexes.size() == jointAndWeightsMapping.size(), "Every vertex needs its joints and weights" );
+
+	out_skeletalVertexes.reserve( out_skeletalVertexes.size() + vertexes.size() );
+	for ( size_t vertexIndex = 0; vertexIndex < vertexes.size(); vertexIndex++ )
+	{
+		out_skeletalVertexes.emplace_back( vertexes[ vertexIndex ], jointAndWeightsMapping[ vertexIndex ] );
+	}
 }
@@ -3,20 +3,45 @@
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Core/Rgba8.hpp"
 
+#include <utility>
+#include <vector>
+
+
+class Vertex_PCUTBN;
+
+
+//----------------------------------------------------------------------------------------------------------
+constexpr int MAX_JOINTS_PER_SKINNED_VERTEX = 4;
+
 
 //----------------------------------------------------------------------------------------------------------
-// Similar to Vertex_PCUTBN but with additional data to allow skinning
+// Similar to Vertex_PCUTBN but with additional data to allow skinning.
+// Up to MAX_JOINTS_PER_SKINNED_VERTEX joints move each vertex; their weights are quantized to bytes
+// that add up to 255, heaviest first, and unused slots have a weight of 0
 class Vertex_Skeletal
 {
 public:
-	Vec3  m_position	= Vec3::ZERO;
-	Rgba8 m_color		= Rgba8::WHITE;
-	Vec2  m_uvTexCoords = Vec2::ZERO;
-	Vec3  m_tangent		= Vec3::ZERO;
-	Vec3  m_bitangent	= Vec3::ZERO;
-	Vec3  m_normal		= Vec3::ZERO;
-	int	  m_jointId		= 0;
+	Vec3		   m_position										= Vec3::ZERO;
+	Rgba8		   m_color											= Rgba8::WHITE;
+	Vec2		   m_uvTexCoords									= Vec2::ZERO;
+	Vec3		   m_tangent										= Vec3::ZERO;
+	Vec3		   m_bitangent										= Vec3::ZERO;
+	Vec3		   m_normal											= Vec3::ZERO;
+	unsigned short m_jointIndices[ MAX_JOINTS_PER_SKINNED_VERTEX ]  = {};
+	unsigned char  m_jointWeights[ MAX_JOINTS_PER_SKINNED_VERTEX ]  = { 255, 0, 0, 0 };
 
 	explicit Vertex_Skeletal();
-	explicit Vertex_Skeletal( Vec3 const& position, Rgba8 color, Vec2 uvTexCoords, Vec3 const& tangent, Vec3 const& biTangent, Vec3 const& normal, int jointId );
-};
\ No newline at end of file
+	explicit Vertex_Skeletal( Vec3 const& position, Rgba8 color, Vec2 uvTexCoords, Vec3 const& tangent, Vec3 const& biTangent, Vec3 const& normal, int jointId ); // moved by jointId alone
+	explicit Vertex_Skeletal( Vertex_PCUTBN const& vertex, std::vector<std::pair<int, float>> const& jointAndWeights );
+
+	// keeps the MAX_JOINTS_PER_SKINNED_VERTEX heaviest and scales them to add up to 1; no joints means joint 0
+	void  SetJointWeights( std::vector<std::pair<int, float>> const& jointAndWeights );
+	float GetJointWeight( int slot ) const { return ( float ) m_jointWeights[ slot ] * ( 1.f / 255.f ); }
+};
+static_assert( sizeof( Vertex_Skeletal ) == 72, "Vertex_Skeletal changed; update Renderer::CreateShaderFromInputLayout_Skeletal() to match" );
+
+
+//----------------------------------------------------------------------------------------------------------
+// Packs what FbxFileImporter::LoadPreRiggedAndPreSkinnedMeshBindPoseFromFile() gives, one vertex each
+void CreateSkeletalVertexes( std::vector<Vertex_PCUTBN> const& vertexes, std::vector<std::vector<std::pair<int, float>>> const& jointAndWeightsMapping,
+	std::vector<Vertex_Skeletal>& out_skeletalVertexes );
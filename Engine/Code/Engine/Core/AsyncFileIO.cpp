@@ -0,0 +1,178 @@
+#include "Engine/Core/AsyncFileIO.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/JobSystem.hpp"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+
+//-------------------------------------------------------------------------
+constexpr ULONG_PTR ASYNC_FILE_IO_QUIT_KEY	  = 1;
+constexpr DWORD		ASYNC_FILE_IO_CHUNK_BYTES = 1 << 30; // ReadFile() takes a DWORD count
+
+
+//-------------------------------------------------------------------------
+struct PendingFileRead
+{
+	OVERLAPPED	   m_overlapped	  = {}; // first, so the OVERLAPPED* a completion hands back is the PendingFileRead*
+	HANDLE		   m_fileHandle	  = INVALID_HANDLE_VALUE;
+	AsyncFileRead* m_read		  = nullptr;
+	Job*		   m_jobToResume  = nullptr;
+	size_t		   m_numBytesRead = 0;
+};
+
+
+//-------------------------------------------------------------------------
+AsyncFileIO::AsyncFileIO( JobSystem* jobSystem )
+	: m_jobSystem( jobSystem )
+{
+	m_completionPort = CreateIoCompletionPort( INVALID_HANDLE_VALUE, nullptr, 0, 1 );
+	GUARANTEE_OR_DIE( m_completionPort != nullptr, "AsyncFileIO: unable to create I/O completion port" );
+
+	m_completionThread = new std::thread( &AsyncFileIO::CompletionThreadMain, this );
+}
+
+
+//-------------------------------------------------------------------------
+AsyncFileIO::~AsyncFileIO()
+{
+	while ( m_numReadsInFlight.load( std::memory_order_acquire ) > 0 )
+	{
+		std::this_thread::yield();
+	}
+
+	PostQueuedCompletionStatus( m_completionPort, 0, ASYNC_FILE_IO_QUIT_KEY, nullptr );
+	m_completionThread->join();
+	delete m_completionThread;
+	m_completionThread = nullptr;
+
+	CloseHandle( m_completionPort );
+	m_completionPort = nullptr;
+}
+
+
+//-------------------------------------------------------------------------
+void AsyncFileIO::StartRead( AsyncFileRead& read, Job* jobToResume )
+{
+	m_numReadsInFlight.fetch_add( 1, std::memory_order_relaxed );
+
+	PendingFileRead* pendingRead = new PendingFileRead();
+	pendingRead->m_read			 = &read;
+	pendingRead->m_jobToResume	 = jobToResume;
+
+	read.m_succeeded = false;
+	read.m_buffer.clear();
+
+	pendingRead->m_fileHandle = CreateFileA( read.m_filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+	if ( pendingRead->m_fileHandle == INVALID_HANDLE_VALUE )
+	{
+		DebuggerPrintf( "AsyncFileIO: unable to open file. file: %s\n", read.m_filename.c_str() );
+		FinishRead( pendingRead, false );
+		return;
+	}
+
+	LARGE_INTEGER fileSize = {};
+	if ( !GetFileSizeEx( pendingRead->m_fileHandle, &fileSize ) || CreateIoCompletionPort( pendingRead->m_fileHandle, m_completionPort, 0, 0 ) == nullptr )
+	{
+		DebuggerPrintf( "AsyncFileIO: unable to start reading file. file: %s\n", read.m_filename.c_str() );
+		FinishRead( pendingRead, false );
+		return;
+	}
+
+	read.m_buffer.resize( ( size_t ) fileSize.QuadPart );
+	if ( read.m_buffer.empty() )
+	{
+		FinishRead( pendingRead, true );
+		return;
+	}
+
+	ReadNextChunk( pendingRead );
+}
+
+
+//-------------------------------------------------------------------------
+void AsyncFileIO::ReadNextChunk( PendingFileRead* pendingRead )
+{
+	std::vector<uint8_t>& buffer = pendingRead->m_read->m_buffer;
+
+	size_t numBytesLeft	  = buffer.size() - pendingRead->m_numBytesRead;
+	DWORD  numBytesToRead = numBytesLeft > ASYNC_FILE_IO_CHUNK_BYTES ? ASYNC_FILE_IO_CHUNK_BYTES : ( DWORD ) numBytesLeft;
+
+	pendingRead->m_overlapped			 = {};
+	pendingRead->m_overlapped.Offset	 = ( DWORD ) ( pendingRead->m_numBytesRead & 0xFFFFFFFFull );
+	pendingRead->m_overlapped.OffsetHigh = ( DWORD ) ( ( unsigned long long ) pendingRead->m_numBytesRead >> 32 );
+
+	// even a read that completes right away queues its completion, so only a real error is handled here
+	if ( !ReadFile( pendingRead->m_fileHandle, buffer.data() + pendingRead->m_numBytesRead, numBytesToRead, nullptr, &pendingRead->m_overlapped ) &&
+		 GetLastError() != ERROR_IO_PENDING )
+	{
+		DebuggerPrintf( "AsyncFileIO: read failed. file: %s\n", pendingRead->m_read->m_filename.c_str() );
+		FinishRead( pendingRead, false );
+	}
+}
+
+
+//-------------------------------------------------------------------------
+void AsyncFileIO::CompletionThreadMain()
+{
+	for ( ;; )
+	{
+		DWORD		numBytesTransferred = 0;
+		ULONG_PTR	completionKey		= 0;
+		OVERLAPPED* overlapped			= nullptr;
+		BOOL		succeeded			= GetQueuedCompletionStatus( m_completionPort, &numBytesTransferred, &completionKey, &overlapped, INFINITE );
+
+		if ( overlapped == nullptr )
+		{
+			if ( completionKey == ASYNC_FILE_IO_QUIT_KEY || !succeeded )
+			{
+				return;
+			}
+			continue;
+		}
+
+		PendingFileRead* pendingRead = reinterpret_cast<PendingFileRead*>( overlapped );
+		if ( !succeeded || numBytesTransferred == 0 )
+		{
+			DebuggerPrintf( "AsyncFileIO: read failed. file: %s\n", pendingRead->m_read->m_filename.c_str() );
+			FinishRead( pendingRead, false );
+			continue;
+		}
+
+		pendingRead->m_numBytesRead += numBytesTransferred;
+		if ( pendingRead->m_numBytesRead < pendingRead->m_read->m_buffer.size() )
+		{
+			ReadNextChunk( pendingRead );
+		}
+		else
+		{
+			FinishRead( pendingRead, true );
+		}
+	}
+}
+
+
+//-------------------------------------------------------------------------
+void AsyncFileIO::FinishRead( PendingFileRead* pendingRead, bool succeeded )
+{
+	if ( pendingRead->m_fileHandle != INVALID_HANDLE_VALUE )
+	{
+		CloseHandle( pendingRead->m_fileHandle );
+	}
+
+	AsyncFileRead& read = *pendingRead->m_read;
+	read.m_succeeded	= succeeded;
+	if ( !succeeded )
+	{
+		read.m_buffer.clear();
+	}
+
+	Job* jobToResume = pendingRead->m_jobToResume;
+	delete pendingRead;
+
+	m_jobSystem->ResumeJob( jobToResume );
+
+	// only after the resume, so the destructor can't return while a job is still being handed back
+	m_numReadsInFlight.fetch_sub( 1, std::memory_order_release );
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+class Job;
+class JobSystem;
+struct PendingFileRead;
+
+
+//-------------------------------------------------------------------------
+// One whole-file read started by JobSystem::SuspendForFileRead(); owned by the job that
+// asked for it, which must keep it alive until it is resumed
+struct AsyncFileRead
+{
+	std::string			 m_filename;
+	std::vector<uint8_t> m_buffer;
+	bool				 m_succeeded = false;
+};
+
+
+//-------------------------------------------------------------------------
+// Overlapped file reads on an I/O completion port.
+// No thread is held while the disk works, so any number of reads can be in flight at once;
+// a single completion thread picks up finished reads and has the JobSystem resume the job
+// that was waiting for each of them.
+class AsyncFileIO
+{
+public:
+	explicit AsyncFileIO( JobSystem* jobSystem );
+	~AsyncFileIO(); // waits for the reads in flight, resuming their jobs
+
+	AsyncFileIO( AsyncFileIO const& copy ) = delete;
+	AsyncFileIO& operator=( AsyncFileIO const& copyFrom ) = delete;
+
+	void StartRead( AsyncFileRead& read, Job* jobToResume ); // jobToResume must already be suspended
+	int	 GetNumReadsInFlight() const { return m_numReadsInFlight.load( std::memory_order_relaxed ); }
+
+private:
+	void CompletionThreadMain();
+	void ReadNextChunk( PendingFileRead* pendingRead );
+	void FinishRead( PendingFileRead* pendingRead, bool succeeded );
+
+	JobSystem*		 m_jobSystem		= nullptr;
+	void*			 m_completionPort	= nullptr; // HANDLE
+	std::thread*	 m_completionThread = nullptr;
+	std::atomic<int> m_numReadsInFlight = 0;
+};
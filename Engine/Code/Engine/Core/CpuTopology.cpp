@@ -0,0 +1,185 @@
+#include "Engine/Core/CpuTopology.hpp"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include <thread>
+
+
+//-------------------------------------------------------------------------
+void CpuTopology::Discover()
+{
+	m_logicalProcessors.clear();
+	m_numCores	   = 0;
+	m_numNumaNodes = 0;
+
+	DWORD numBytes = 0;
+	GetLogicalProcessorInformationEx( RelationAll, nullptr, &numBytes );
+	if ( GetLastError() != ERROR_INSUFFICIENT_BUFFER )
+	{
+		DiscoverFallback();
+		return;
+	}
+
+	std::vector<unsigned char> buffer( numBytes );
+	if ( !GetLogicalProcessorInformationEx( RelationAll, reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>( buffer.data() ), &numBytes ) )
+	{
+		DiscoverFallback();
+		return;
+	}
+
+	// nodes first, so every logical processor can look its node up; node numbers get packed to 0..n-1
+	std::vector<GROUP_AFFINITY> nodeMasks;
+	for ( DWORD offset = 0; offset < numBytes; )
+	{
+		SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX const* entry = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX const*>( buffer.data() + offset );
+		if ( entry->Relationship == RelationNumaNode )
+		{
+			nodeMasks.push_back( entry->NumaNode.GroupMask );
+		}
+		offset += entry->Size;
+	}
+	m_numNumaNodes = nodeMasks.empty() ? 1 : ( int ) nodeMasks.size();
+
+	for ( DWORD offset = 0; offset < numBytes; )
+	{
+		SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX const* entry = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX const*>( buffer.data() + offset );
+		offset += entry->Size;
+		if ( entry->Relationship != RelationProcessorCore )
+		{
+			continue;
+		}
+
+		int coreIndex	= m_numCores++;
+		int indexOnCore = 0;
+		for ( WORD groupIndex = 0; groupIndex < entry->Processor.GroupCount; ++groupIndex )
+		{
+			GROUP_AFFINITY const& groupMask = entry->Processor.GroupMask[ groupIndex ];
+			for ( int bitIndex = 0; bitIndex < ( int ) sizeof( KAFFINITY ) * 8; ++bitIndex )
+			{
+				KAFFINITY bit = ( KAFFINITY ) 1 << bitIndex;
+				if ( ( groupMask.Mask & bit ) == 0 )
+				{
+					continue;
+				}
+
+				LogicalProcessor logicalProcessor;
+				logicalProcessor.m_group		= groupMask.Group;
+				logicalProcessor.m_indexInGroup = ( unsigned char ) bitIndex;
+				logicalProcessor.m_coreIndex	= coreIndex;
+				logicalProcessor.m_indexOnCore	= indexOnCore++;
+
+				for ( int nodeIndex = 0; nodeIndex < nodeMasks.size(); ++nodeIndex )
+				{
+					if ( nodeMasks[ nodeIndex ].Group == groupMask.Group && ( nodeMasks[ nodeIndex ].Mask & bit ) != 0 )
+					{
+						logicalProcessor.m_numaNode = nodeIndex;
+						break;
+					}
+				}
+
+				m_logicalProcessors.push_back( logicalProcessor );
+			}
+		}
+	}
+
+	if ( m_logicalProcessors.empty() )
+	{
+		DiscoverFallback();
+	}
+}
+
+
+//-------------------------------------------------------------------------
+void CpuTopology::DiscoverFallback()
+{
+	m_logicalProcessors.clear();
+
+	int numLogicalProcessors = ( int ) std::thread::hardware_concurrency();
+	if ( numLogicalProcessors < 1 )
+	{
+		numLogicalProcessors = 1;
+	}
+
+	for ( int index = 0; index < numLogicalProcessors; ++index )
+	{
+		LogicalProcessor logicalProcessor;
+		logicalProcessor.m_group		= ( unsigned short ) ( index / 64 );
+		logicalProcessor.m_indexInGroup = ( unsigned char ) ( index % 64 );
+		logicalProcessor.m_coreIndex	= index;
+		m_logicalProcessors.push_back( logicalProcessor );
+	}
+
+	m_numCores	   = numLogicalProcessors;
+	m_numNumaNodes = 1;
+}
+
+
+//-------------------------------------------------------------------------
+std::vector<int> CpuTopology::GetWorkerPlacementOrder( bool avoidSmtSiblings ) const
+{
+	// hardware threads of every core by their index on it, and cores by node
+	std::vector<std::vector<int>> logicalProcessorsByCore( m_numCores );
+	int							  maxIndexOnCore = 0;
+	int							  mainThreadCore = -1;
+	for ( int index = 0; index < m_logicalProcessors.size(); ++index )
+	{
+		LogicalProcessor const& logicalProcessor = m_logicalProcessors[ index ];
+		logicalProcessorsByCore[ logicalProcessor.m_coreIndex ].push_back( index );
+		maxIndexOnCore = logicalProcessor.m_indexOnCore > maxIndexOnCore ? logicalProcessor.m_indexOnCore : maxIndexOnCore;
+
+		if ( logicalProcessor.m_group == 0 && logicalProcessor.m_indexInGroup == 0 )
+		{
+			mainThreadCore = logicalProcessor.m_coreIndex;
+		}
+	}
+
+	std::vector<std::vector<int>> coresByNode( m_numNumaNodes );
+	int							  maxCoresPerNode = 0;
+	for ( int coreIndex = 0; coreIndex < m_numCores; ++coreIndex )
+	{
+		if ( logicalProcessorsByCore[ coreIndex ].empty() || ( coreIndex == mainThreadCore && m_numCores > 1 ) )
+		{
+			continue;
+		}
+
+		std::vector<int>& nodeCores = coresByNode[ m_logicalProcessors[ logicalProcessorsByCore[ coreIndex ][ 0 ] ].m_numaNode ];
+		nodeCores.push_back( coreIndex );
+		maxCoresPerNode = ( int ) nodeCores.size() > maxCoresPerNode ? ( int ) nodeCores.size() : maxCoresPerNode;
+	}
+
+	std::vector<int> placementOrder;
+	int				 lastIndexOnCore = avoidSmtSiblings ? 0 : maxIndexOnCore;
+	for ( int indexOnCore = 0; indexOnCore <= lastIndexOnCore; ++indexOnCore )
+	{
+		for ( int rankInNode = 0; rankInNode < maxCoresPerNode; ++rankInNode )
+		{
+			for ( int nodeIndex = 0; nodeIndex < m_numNumaNodes; ++nodeIndex )
+			{
+				if ( rankInNode >= coresByNode[ nodeIndex ].size() )
+				{
+					continue;
+				}
+
+				std::vector<int> const& coreLogicalProcessors = logicalProcessorsByCore[ coresByNode[ nodeIndex ][ rankInNode ] ];
+				if ( indexOnCore < coreLogicalProcessors.size() )
+				{
+					placementOrder.push_back( coreLogicalProcessors[ indexOnCore ] );
+				}
+			}
+		}
+	}
+
+	return placementOrder;
+}
+
+
+//-------------------------------------------------------------------------
+bool CpuTopology::PinCurrentThread( LogicalProcessor const& logicalProcessor )
+{
+	GROUP_AFFINITY affinity = {};
+	affinity.Group			= logicalProcessor.m_group;
+	affinity.Mask			= ( KAFFINITY ) 1 << logicalProcessor.m_indexInGroup;
+
+	return SetThreadGroupAffinity( GetCurrentThread(), &affinity, nullptr ) != 0;
+}
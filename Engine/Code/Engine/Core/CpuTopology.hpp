@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+
+
+//-------------------------------------------------------------------------
+struct LogicalProcessor
+{
+	unsigned short m_group		  = 0; // Windows processor group, at most 64 logical processors each
+	unsigned char  m_indexInGroup = 0;
+	int			   m_coreIndex	  = 0;
+	int			   m_indexOnCore  = 0; // 0 for the first hardware thread of a core, 1 and up for its SMT siblings
+	int			   m_numaNode	  = 0;
+};
+
+
+//-------------------------------------------------------------------------
+// Cores, SMT siblings and NUMA nodes of the machine, for placing and pinning worker threads.
+// Falls back to one node of hardware_concurrency() single-threaded cores if the OS won't tell.
+class CpuTopology
+{
+public:
+	void Discover();
+
+	int GetNumLogicalProcessors() const { return ( int ) m_logicalProcessors.size(); }
+	int GetNumCores() const { return m_numCores; }
+	int GetNumNumaNodes() const { return m_numNumaNodes; }
+
+	LogicalProcessor const& GetLogicalProcessor( int index ) const { return m_logicalProcessors[ index ]; }
+
+	// Logical processors to pin workers to, best first: the first hardware thread of every core,
+	// alternating between NUMA nodes, then the SMT siblings the same way unless avoided.
+	// The core of logical processor 0 is left for the main thread while there are others.
+	std::vector<int> GetWorkerPlacementOrder( bool avoidSmtSiblings ) const;
+
+	static bool PinCurrentThread( LogicalProcessor const& logicalProcessor );
+
+	std::vector<LogicalProcessor> m_logicalProcessors;
+	int							  m_numCores	 = 0;
+	int							  m_numNumaNodes = 0;
+
+private:
+	void DiscoverFallback();
+};
@@ -2,7 +2,16 @@
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Input/InputSystem.hpp"
+#include "Engine/Animation/AnimAssetCacheBenchmark.hpp"
+#include "Engine/Animation/AnimBlendTreeBenchmark.hpp"
+#include "Engine/Animation/AnimCurveBenchmark.hpp"
+#include "Engine/Animation/AnimWorldBenchmark.hpp"
+#include "Engine/Animation/CompressedAnimClipBenchmark.hpp"
+#include "Engine/Animation/SkinningBenchmark.hpp"
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/BVHRaycastTest.hpp"
+#include "Engine/Math/RaycastPacketBenchmark.hpp"
+#include "Engine/Math/SpatialHashGrid2Benchmark.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/Stopwatch.hpp"
 #include "Engine/Core/EventSystem.hpp"
@@ -78,6 +87,15 @@ void DevConsole::SubscribeToEvents()
 	g_theEventSystem->SubscribeToEvent("CharInput", EventHandler_CharInput);
 	g_theEventSystem->SubscribeToEvent(CLEAR_COMMAND, EventHandler_ClearTextCommand);
 	g_theEventSystem->SubscribeToEvent(HELP_COMMAND, EventHandler_HelpCommand);
+	g_theEventSystem->SubscribeToEvent("AnimCacheBench", Command_AnimCacheBench);
+	g_theEventSystem->SubscribeToEvent("AnimCurveBench", Command_AnimCurveBench);
+	g_theEventSystem->SubscribeToEvent("AnimWorldBench", Command_AnimWorldBench);
+	g_theEventSystem->SubscribeToEvent("AnimCompressBench", Command_AnimCompressBench);
+	g_theEventSystem->SubscribeToEvent("SkinBench", Command_SkinBench);
+	g_theEventSystem->SubscribeToEvent("AnimTreeBench", Command_AnimTreeBench);
+	g_theEventSystem->SubscribeToEvent("BVHRaycastTest", Command_BVHRaycastTest);
+	g_theEventSystem->SubscribeToEvent("RayPacketBench", Command_RayPacketBench);
+	g_theEventSystem->SubscribeToEvent("SpatialHashBench", Command_SpatialHashBench);
 	//g_theEventSystem->SubscribeToEvent("eventLog", EventHandler_EventLogger);
 }
 
@@ -110,6 +128,15 @@ void DevConsole::UnsubscribeFromEvents()
 	g_theEventSystem->UnsubscribeFromEvent("CharInput", EventHandler_CharInput);
 	g_theEventSystem->UnsubscribeFromEvent(CLEAR_COMMAND, EventHandler_ClearTextCommand);
 	g_theEventSystem->UnsubscribeFromEvent(HELP_COMMAND, EventHandler_HelpCommand);
+	g_theEventSystem->UnsubscribeFromEvent("AnimCacheBench", Command_AnimCacheBench);
+	g_theEventSystem->UnsubscribeFromEvent("AnimCurveBench", Command_AnimCurveBench);
+	g_theEventSystem->UnsubscribeFromEvent("AnimWorldBench", Command_AnimWorldBench);
+	g_theEventSystem->UnsubscribeFromEvent("AnimCompressBench", Command_AnimCompressBench);
+	g_theEventSystem->UnsubscribeFromEvent("SkinBench", Command_SkinBench);
+	g_theEventSystem->UnsubscribeFromEvent("AnimTreeBench", Command_AnimTreeBench);
+	g_theEventSystem->UnsubscribeFromEvent("BVHRaycastTest", Command_BVHRaycastTest);
+	g_theEventSystem->UnsubscribeFromEvent("RayPacketBench", Command_RayPacketBench);
+	g_theEventSystem->UnsubscribeFromEvent("SpatialHashBench", Command_SpatialHashBench);
 	//g_theEventSystem->UnsubscribeFromEvent("eventLog", EventHandler_EventLogger);
 }
 
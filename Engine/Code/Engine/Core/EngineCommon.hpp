@@ -79,11 +79,6 @@ const std::string HELP_EVENT_ARGS = "events";
 const std::string ECHO_COMMAND	  = "Echo";
 
 
-//-------------------------------------------------------------------------
-// Multi-threading
-constexpr int NUM_DISK_IO_THREADS = 1;
-
-
 //----------------------------------------------------------------------------------------------------------
 // Renderer
 struct LightConstants
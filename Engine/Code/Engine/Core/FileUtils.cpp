@@ -94,3 +94,35 @@ int FileReadToString(std::string& outString, const std::string& filename)
 
 	return false;
 }
+
+int FileWriteFromBuffer(std::vector<uint8_t> const& buffer, const std::string& filename)
+{
+	FILE* fileStream = nullptr;
+	char const* mode = "wb";
+
+	errno_t error;
+	error = fopen_s(&fileStream, filename.c_str(), mode);
+
+	if (error || fileStream == nullptr)
+	{
+		ERROR_RECOVERABLE(Stringf("Unable to open file for writing. file: %s", filename.c_str()));
+		return false;
+	}
+
+	size_t numBytesWritten = fwrite(buffer.data(), 1, buffer.size(), fileStream);
+	fclose(fileStream);
+
+	if (numBytesWritten != buffer.size())
+	{
+		ERROR_RECOVERABLE(Stringf("Unable to write whole file. file: %s", filename.c_str()));
+		return false;
+	}
+
+	return true;
+}
+
+int FileWriteFromString(std::string const& string, const std::string& filename)
+{
+	std::vector<uint8_t> buffer(string.begin(), string.end());
+	return FileWriteFromBuffer(buffer, filename);
+}
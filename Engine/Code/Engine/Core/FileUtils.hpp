@@ -9,4 +9,10 @@
 int FileReadToBuffer(std::vector<uint8_t>& outbuffer, const std::string& filename);
 
 // Read the contents of filename, as a binary file, to outBuffer
-int FileReadToString(std::string& outString, const std::string& filename);
\ No newline at end of file
+int FileReadToString(std::string& outString, const std::string& filename);
+
+// Write the contents of buffer, as a binary file, to filename; replaces the file if it exists
+int FileWriteFromBuffer(std::vector<uint8_t> const& buffer, const std::string& filename);
+
+// Write string, as a binary file, to filename; replaces the file if it exists
+int FileWriteFromString(std::string const& string, const std::string& filename);
@@ -0,0 +1,180 @@
+#include "Engine/Core/JobPool.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <new>
+
+
+//-------------------------------------------------------------------------
+JobPool::~JobPool()
+{
+	int numBlocks = m_numBlocks.load( std::memory_order_acquire );
+	for ( int blockIndex = 0; blockIndex < numBlocks; blockIndex++ )
+	{
+		delete m_blocks[ blockIndex ].load( std::memory_order_relaxed );
+		m_blocks[ blockIndex ].store( nullptr, std::memory_order_relaxed );
+	}
+	m_numBlocks.store( 0, std::memory_order_relaxed );
+}
+
+
+//-------------------------------------------------------------------------
+JobPool& JobPool::GetInstance()
+{
+	static JobPool s_jobPool;
+	return s_jobPool;
+}
+
+
+//-------------------------------------------------------------------------
+void* JobPool::Allocate( size_t numBytes )
+{
+	m_numAllocations.fetch_add( 1, std::memory_order_relaxed );
+
+	if ( numBytes > JOB_POOL_MAX_OBJECT_SIZE )
+	{
+		CountHeapAllocation();
+		return ::operator new( numBytes );
+	}
+
+	unsigned int slotIndex = 0;
+	while ( !TryPopFreeSlot( slotIndex ) )
+	{
+		AddBlock( true );
+	}
+
+	unsigned char* slot					   = GetSlot( slotIndex );
+	*reinterpret_cast<unsigned int*>( slot ) = slotIndex;
+	return slot + JOB_POOL_SLOT_HEADER;
+}
+
+
+//-------------------------------------------------------------------------
+void JobPool::Free( void* memory, size_t numBytes )
+{
+	if ( memory == nullptr )
+	{
+		return;
+	}
+
+	if ( numBytes > JOB_POOL_MAX_OBJECT_SIZE )
+	{
+		::operator delete( memory );
+		return;
+	}
+
+	unsigned char* slot		 = static_cast<unsigned char*>( memory ) - JOB_POOL_SLOT_HEADER;
+	unsigned int   slotIndex = *reinterpret_cast<unsigned int*>( slot );
+	PushFreeSlots( slotIndex, slotIndex );
+}
+
+
+//-------------------------------------------------------------------------
+void JobPool::Reserve( int numSlots )
+{
+	while ( m_numBlocks.load( std::memory_order_acquire ) * JOB_POOL_SLOTS_PER_BLOCK < numSlots )
+	{
+		AddBlock( false );
+	}
+}
+
+
+//-------------------------------------------------------------------------
+JobMemoryStats JobPool::GetStats() const
+{
+	JobMemoryStats stats;
+	stats.m_numAllocations	   = m_numAllocations.load( std::memory_order_relaxed );
+	stats.m_numHeapAllocations = m_numHeapAllocations.load( std::memory_order_relaxed );
+	return stats;
+}
+
+
+//-------------------------------------------------------------------------
+unsigned char* JobPool::GetSlot( unsigned int slotIndex ) const
+{
+	Block* block = m_blocks[ slotIndex / JOB_POOL_SLOTS_PER_BLOCK ].load( std::memory_order_acquire );
+	return block->m_slots[ slotIndex % JOB_POOL_SLOTS_PER_BLOCK ];
+}
+
+
+//-------------------------------------------------------------------------
+std::atomic<unsigned int>& JobPool::GetNextFreeSlot( unsigned int slotIndex ) const
+{
+	Block* block = m_blocks[ slotIndex / JOB_POOL_SLOTS_PER_BLOCK ].load( std::memory_order_acquire );
+	return block->m_nextFreeSlots[ slotIndex % JOB_POOL_SLOTS_PER_BLOCK ];
+}
+
+
+//-------------------------------------------------------------------------
+bool JobPool::TryPopFreeSlot( unsigned int& out_slotIndex )
+{
+	unsigned long long head = m_freeSlotsHead.load( std::memory_order_acquire );
+	for ( ;; )
+	{
+		unsigned int firstFreeSlot = ( unsigned int ) ( head & 0xFFFFFFFFull );
+		if ( firstFreeSlot == 0 )
+		{
+			return false;
+		}
+
+		// may read a stale link if the slot was popped meanwhile; the tag makes the CAS fail then
+		unsigned int	   slotIndex = firstFreeSlot - 1;
+		unsigned int	   nextSlot	 = GetNextFreeSlot( slotIndex ).load( std::memory_order_relaxed );
+		unsigned long long newHead	 = ( ( ( head >> 32 ) + 1 ) << 32 ) | nextSlot;
+
+		if ( m_freeSlotsHead.compare_exchange_weak( head, newHead, std::memory_order_acquire, std::memory_order_acquire ) )
+		{
+			out_slotIndex = slotIndex;
+			return true;
+		}
+	}
+}
+
+
+//-------------------------------------------------------------------------
+// firstSlotIndex..lastSlotIndex must already be linked to each other
+void JobPool::PushFreeSlots( unsigned int firstSlotIndex, unsigned int lastSlotIndex )
+{
+	std::atomic<unsigned int>& lastSlotLink = GetNextFreeSlot( lastSlotIndex );
+
+	unsigned long long head = m_freeSlotsHead.load( std::memory_order_relaxed );
+	for ( ;; )
+	{
+		lastSlotLink.store( ( unsigned int ) ( head & 0xFFFFFFFFull ), std::memory_order_relaxed );
+		unsigned long long newHead = ( ( ( head >> 32 ) + 1 ) << 32 ) | ( firstSlotIndex + 1 );
+
+		if ( m_freeSlotsHead.compare_exchange_weak( head, newHead, std::memory_order_release, std::memory_order_relaxed ) )
+		{
+			return;
+		}
+	}
+}
+
+
+//-------------------------------------------------------------------------
+void JobPool::AddBlock( bool onlyWhenOutOfSlots )
+{
+	std::lock_guard<std::mutex> growLock( m_growMutex );
+
+	// somebody else may have grown the pool or freed slots while we waited for the lock
+	if ( onlyWhenOutOfSlots && ( m_freeSlotsHead.load( std::memory_order_acquire ) & 0xFFFFFFFFull ) != 0 )
+	{
+		return;
+	}
+
+	int blockIndex = m_numBlocks.load( std::memory_order_relaxed );
+	GUARANTEE_OR_DIE( blockIndex < JOB_POOL_MAX_BLOCKS, "JobPool: too many jobs alive at once" );
+
+	Block* block = new Block();
+	CountHeapAllocation();
+
+	unsigned int firstSlotIndex = ( unsigned int ) ( blockIndex * JOB_POOL_SLOTS_PER_BLOCK );
+	for ( int index = 0; index < JOB_POOL_SLOTS_PER_BLOCK - 1; index++ )
+	{
+		block->m_nextFreeSlots[ index ].store( firstSlotIndex + index + 2, std::memory_order_relaxed );
+	}
+
+	m_blocks[ blockIndex ].store( block, std::memory_order_release );
+	m_numBlocks.store( blockIndex + 1, std::memory_order_release );
+
+	PushFreeSlots( firstSlotIndex, firstSlotIndex + JOB_POOL_SLOTS_PER_BLOCK - 1 );
+}
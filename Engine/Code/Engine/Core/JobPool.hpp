@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+
+//-------------------------------------------------------------------------
+constexpr int JOB_POOL_SLOT_SIZE	   = 256;
+constexpr int JOB_POOL_SLOT_HEADER	   = 16; // slot index in front of every allocation, keeps the object 16-byte aligned
+constexpr int JOB_POOL_MAX_OBJECT_SIZE = JOB_POOL_SLOT_SIZE - JOB_POOL_SLOT_HEADER;
+constexpr int JOB_POOL_SLOTS_PER_BLOCK = 1024;
+constexpr int JOB_POOL_MAX_BLOCKS	   = 4096; // 4M jobs alive at once
+
+
+//-------------------------------------------------------------------------
+struct JobMemoryStats
+{
+	long long m_numAllocations	   = 0; // every job (or other job-sized object) allocated through the pool
+	long long m_numHeapAllocations = 0; // global heap allocations made on behalf of jobs (pool growth, oversized jobs, containers jobs own)
+};
+
+
+//-------------------------------------------------------------------------
+// Fixed-size slot allocator behind Job::operator new / delete.
+// Freed slots go back on a lock-free free list and are handed out again without touching the
+// global heap; the pool only ever grows, a whole block of slots at a time. Objects bigger than
+// JOB_POOL_MAX_OBJECT_SIZE fall back to the global heap.
+// One pool is shared by every JobSystem and outlives them, so jobs may be created before
+// Startup() and deleted after Shutdown().
+class JobPool
+{
+public:
+	JobPool() = default;
+	~JobPool();
+
+	JobPool( JobPool const& copy ) = delete;
+	JobPool& operator=( JobPool const& copyFrom ) = delete;
+
+	static JobPool& GetInstance();
+
+	void* Allocate( size_t numBytes );
+	void  Free( void* memory, size_t numBytes );
+	void  Reserve( int numSlots ); // grow up front so the first frames don't pay for it
+
+	void		   CountHeapAllocation() { m_numHeapAllocations.fetch_add( 1, std::memory_order_relaxed ); }
+	JobMemoryStats GetStats() const;
+
+private:
+	struct Block
+	{
+		alignas( 64 ) unsigned char m_slots[ JOB_POOL_SLOTS_PER_BLOCK ][ JOB_POOL_SLOT_SIZE ];
+		std::atomic<unsigned int> m_nextFreeSlots[ JOB_POOL_SLOTS_PER_BLOCK ]; // free list links, slot index + 1 so 0 ends the list
+	};
+
+	unsigned char*			   GetSlot( unsigned int slotIndex ) const;
+	std::atomic<unsigned int>& GetNextFreeSlot( unsigned int slotIndex ) const;
+	bool					   TryPopFreeSlot( unsigned int& out_slotIndex );
+	void					   PushFreeSlots( unsigned int firstSlotIndex, unsigned int lastSlotIndex );
+	void					   AddBlock( bool onlyWhenOutOfSlots );
+
+	// low 32 bits: first free slot index + 1, high 32 bits: tag bumped on every change so a
+	// slot popped and pushed back between our load and CAS can't be mistaken for no change
+	alignas( 64 ) std::atomic<unsigned long long> m_freeSlotsHead = 0;
+
+	std::atomic<Block*> m_blocks[ JOB_POOL_MAX_BLOCKS ] = {};
+	std::atomic<int>	m_numBlocks						= 0;
+	std::mutex			m_growMutex;
+
+	std::atomic<long long> m_numAllocations		= 0;
+	std::atomic<long long> m_numHeapAllocations = 0;
+};
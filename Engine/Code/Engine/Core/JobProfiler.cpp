@@ -0,0 +1,372 @@
+#include "Engine/Core/JobProfiler.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+
+//-------------------------------------------------------------------------
+static char const* GetJobTypeName( JobType type )
+{
+	switch ( type )
+	{
+	case JobType::DISK_IO:		return "DISK_IO";
+	case JobType::COMPUTATION:	return "COMPUTATION";
+	default:					return "UNKNOWN";
+	}
+}
+
+
+//-------------------------------------------------------------------------
+static char const* GetJobPriorityName( JobPriority priority )
+{
+	switch ( priority )
+	{
+	case JobPriority::FRAME_CRITICAL:	return "FRAME_CRITICAL";
+	case JobPriority::NORMAL:			return "NORMAL";
+	case JobPriority::BACKGROUND:		return "BACKGROUND";
+	default:							return "UNKNOWN";
+	}
+}
+
+
+//-------------------------------------------------------------------------
+// Job names are whatever the caller gave; quotes, backslashes and control characters would end
+// the JSON string early or make it invalid
+static std::string EscapeJsonString( char const* text )
+{
+	std::string escaped;
+	for ( char const* character = text; *character != '\0'; character++ )
+	{
+		switch ( *character )
+		{
+		case '"':	escaped += "\\\""; break;
+		case '\\':	escaped += "\\\\"; break;
+		case '\n':	escaped += "\\n"; break;
+		case '\r':	escaped += "\\r"; break;
+		case '\t':	escaped += "\\t"; break;
+		default:
+			if ( ( unsigned char ) *character < 0x20 )
+			{
+				escaped += Stringf( "\\u%04x", ( unsigned char ) *character );
+			}
+			else
+			{
+				escaped += *character;
+			}
+			break;
+		}
+	}
+	return escaped;
+}
+
+
+//-------------------------------------------------------------------------
+static void LogToDevConsole( Rgba8 const& color, std::string const& text )
+{
+	if ( g_theDevConsole )
+	{
+		g_theDevConsole->AddLine( color, text );
+	}
+	else
+	{
+		DebuggerPrintf( "%s\n", text.c_str() );
+	}
+}
+
+
+//-------------------------------------------------------------------------
+bool JobProfiler::TimingRecordRing::Push( JobTimingRecord const& record )
+{
+	unsigned int writeIndex = m_writeIndex.load( std::memory_order_relaxed );
+	unsigned int readIndex	= m_readIndex.load( std::memory_order_acquire );
+	if ( writeIndex - readIndex >= JOB_PROFILER_RECORDS_PER_THREAD )
+	{
+		return false;
+	}
+
+	m_records[ writeIndex & ( JOB_PROFILER_RECORDS_PER_THREAD - 1 ) ] = record;
+	m_writeIndex.store( writeIndex + 1, std::memory_order_release );
+	return true;
+}
+
+
+//-------------------------------------------------------------------------
+JobProfiler::JobProfiler( std::vector<JobType> const& workerTypes )
+	: m_workerTypes( workerTypes )
+{
+	for ( int threadId = 0; threadId < m_workerTypes.size(); threadId++ )
+	{
+		m_workerRings.push_back( new TimingRecordRing() );
+	}
+	m_otherThreadsRing = new TimingRecordRing();
+
+	m_lastFrameStats.m_workerUtilization.resize( m_workerTypes.size() + 1 );
+	m_lastEndFrameSeconds = GetCurrentTimeSeconds();
+}
+
+
+//-------------------------------------------------------------------------
+JobProfiler::~JobProfiler()
+{
+	for ( int threadId = 0; threadId < m_workerRings.size(); threadId++ )
+	{
+		delete m_workerRings[ threadId ];
+		m_workerRings[ threadId ] = nullptr;
+	}
+	m_workerRings.clear();
+
+	delete m_otherThreadsRing;
+	m_otherThreadsRing = nullptr;
+}
+
+
+//-------------------------------------------------------------------------
+void JobProfiler::SetEnabled( bool isEnabled )
+{
+	m_isEnabled.store( isEnabled, std::memory_order_relaxed );
+}
+
+
+//-------------------------------------------------------------------------
+void JobProfiler::OnJobQueued()
+{
+	int queueDepth	   = m_queueDepth.fetch_add( 1, std::memory_order_relaxed ) + 1;
+	int peakQueueDepth = m_peakQueueDepth.load( std::memory_order_relaxed );
+	while ( queueDepth > peakQueueDepth && !m_peakQueueDepth.compare_exchange_weak( peakQueueDepth, queueDepth, std::memory_order_relaxed ) )
+	{
+	}
+}
+
+
+//-------------------------------------------------------------------------
+void JobProfiler::OnJobStarted()
+{
+	m_queueDepth.fetch_sub( 1, std::memory_order_relaxed );
+}
+
+
+//-------------------------------------------------------------------------
+void JobProfiler::RecordJob( JobTimingRecord const& record )
+{
+	bool wasRecorded = false;
+	if ( record.m_threadId >= 0 && record.m_threadId < m_workerRings.size() )
+	{
+		wasRecorded = m_workerRings[ record.m_threadId ]->Push( record );
+	}
+	else
+	{
+		std::lock_guard<std::mutex> otherThreadsLock( m_otherThreadsMutex );
+		wasRecorded = m_otherThreadsRing->Push( record );
+	}
+
+	if ( !wasRecorded )
+	{
+		m_numDroppedRecords.fetch_add( 1, std::memory_order_relaxed );
+	}
+}
+
+
+//-------------------------------------------------------------------------
+void JobProfiler::EndFrame()
+{
+	double now = GetCurrentTimeSeconds();
+
+	JobFrameStats& stats = m_lastFrameStats;
+	stats.m_frameSeconds		  = now - m_lastEndFrameSeconds;
+	stats.m_numJobsExecuted		  = 0;
+	stats.m_maxWaitSeconds		  = 0.0;
+	stats.m_maxExecuteSeconds	  = 0.0;
+	stats.m_queueDepth			  = m_queueDepth.load( std::memory_order_relaxed );
+	stats.m_peakQueueDepth		  = m_peakQueueDepth.exchange( stats.m_queueDepth, std::memory_order_relaxed );
+	stats.m_numDroppedRecords	  = m_numDroppedRecords.exchange( 0, std::memory_order_relaxed );
+	m_lastEndFrameSeconds		  = now;
+
+	std::vector<double> busySecondsByThread( m_workerRings.size() + 1, 0.0 );
+	double				totalWaitSeconds	= 0.0;
+	double				totalExecuteSeconds = 0.0;
+
+	for ( int threadId = 0; threadId < m_workerRings.size(); threadId++ )
+	{
+		DrainRing( *m_workerRings[ threadId ], busySecondsByThread, totalWaitSeconds, totalExecuteSeconds );
+	}
+	{
+		std::lock_guard<std::mutex> otherThreadsLock( m_otherThreadsMutex );
+		DrainRing( *m_otherThreadsRing, busySecondsByThread, totalWaitSeconds, totalExecuteSeconds );
+	}
+
+	stats.m_averageWaitSeconds	  = stats.m_numJobsExecuted > 0 ? totalWaitSeconds / stats.m_numJobsExecuted : 0.0;
+	stats.m_averageExecuteSeconds = stats.m_numJobsExecuted > 0 ? totalExecuteSeconds / stats.m_numJobsExecuted : 0.0;
+	for ( int threadIndex = 0; threadIndex < busySecondsByThread.size(); threadIndex++ )
+	{
+		stats.m_workerUtilization[ threadIndex ] = stats.m_frameSeconds > 0.0 ? ( float ) ( busySecondsByThread[ threadIndex ] / stats.m_frameSeconds ) : 0.f;
+	}
+
+	if ( m_numTraceFramesLeft > 0 )
+	{
+		--m_numTraceFramesLeft;
+		if ( m_numTraceFramesLeft == 0 )
+		{
+			if ( WriteChromeTrace( m_traceFileName ) )
+			{
+				LogToDevConsole( DevConsole::INFO_MAJOR_COLOR, Stringf( "JobTrace: wrote %d jobs to %s", ( int ) m_traceRecords.size(), m_traceFileName.c_str() ) );
+			}
+			m_traceRecords.clear();
+			m_traceRecords.shrink_to_fit();
+			SetEnabled( m_wasEnabledBeforeTrace );
+		}
+	}
+}
+
+
+//-------------------------------------------------------------------------
+void JobProfiler::DrainRing( TimingRecordRing& ring, std::vector<double>& busySecondsByThread, double& totalWaitSeconds, double& totalExecuteSeconds )
+{
+	JobFrameStats& stats = m_lastFrameStats;
+
+	unsigned int readIndex	= ring.m_readIndex.load( std::memory_order_relaxed );
+	unsigned int writeIndex = ring.m_writeIndex.load( std::memory_order_acquire );
+	for ( ; readIndex != writeIndex; ++readIndex )
+	{
+		JobTimingRecord const& record = ring.m_records[ readIndex & ( JOB_PROFILER_RECORDS_PER_THREAD - 1 ) ];
+
+		double waitSeconds	  = record.m_startSeconds - record.m_enqueueSeconds;
+		double executeSeconds = record.m_endSeconds - record.m_startSeconds;
+
+		++stats.m_numJobsExecuted;
+		totalWaitSeconds += waitSeconds;
+		totalExecuteSeconds += executeSeconds;
+		stats.m_maxWaitSeconds	  = waitSeconds > stats.m_maxWaitSeconds ? waitSeconds : stats.m_maxWaitSeconds;
+		stats.m_maxExecuteSeconds = executeSeconds > stats.m_maxExecuteSeconds ? executeSeconds : stats.m_maxExecuteSeconds;
+
+		bool isWorker = record.m_threadId >= 0 && record.m_threadId < m_workerRings.size();
+		busySecondsByThread[ isWorker ? record.m_threadId : m_workerRings.size() ] += executeSeconds;
+
+		if ( m_numTraceFramesLeft > 0 && m_traceRecords.size() < JOB_PROFILER_MAX_TRACE_RECORDS )
+		{
+			m_traceRecords.push_back( record );
+		}
+	}
+
+	ring.m_readIndex.store( writeIndex, std::memory_order_release );
+}
+
+
+//-------------------------------------------------------------------------
+void JobProfiler::LogStats() const
+{
+	JobFrameStats const& stats = m_lastFrameStats;
+
+	LogToDevConsole( DevConsole::INFO_MAJOR_COLOR, Stringf( "JobStats: %d jobs in %.2f ms, queue depth %d (peak %d), %d records dropped",
+		stats.m_numJobsExecuted, stats.m_frameSeconds * 1000.0, stats.m_queueDepth, stats.m_peakQueueDepth, stats.m_numDroppedRecords ) );
+	LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "  wait    avg %.3f ms, max %.3f ms", stats.m_averageWaitSeconds * 1000.0, stats.m_maxWaitSeconds * 1000.0 ) );
+	LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "  execute avg %.3f ms, max %.3f ms", stats.m_averageExecuteSeconds * 1000.0, stats.m_maxExecuteSeconds * 1000.0 ) );
+
+	for ( int threadId = 0; threadId < m_workerTypes.size(); threadId++ )
+	{
+		LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "  worker %d (%s): %.1f%% busy", threadId, GetJobTypeName( m_workerTypes[ threadId ] ), stats.m_workerUtilization[ threadId ] * 100.f ) );
+	}
+	LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "  other threads: %.1f%% busy", stats.m_workerUtilization.back() * 100.f ) );
+}
+
+
+//-------------------------------------------------------------------------
+void JobProfiler::StartTrace( int numFrames, std::string const& fileName )
+{
+	if ( m_numTraceFramesLeft == 0 )
+	{
+		m_wasEnabledBeforeTrace = IsEnabled();
+	}
+
+	m_numTraceFramesLeft = numFrames > 0 ? numFrames : 1;
+	m_traceFileName		 = fileName;
+	m_traceStartSeconds	 = GetCurrentTimeSeconds();
+	m_traceRecords.clear();
+	SetEnabled( true );
+}
+
+
+//-------------------------------------------------------------------------
+// Chrome "Trace Event Format": one complete ("X") event per job, timestamps in microseconds
+bool JobProfiler::WriteChromeTrace( std::string const& fileName ) const
+{
+	std::string json;
+	json.reserve( 256 + m_traceRecords.size() * 160 );
+	json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	for ( int threadId = 0; threadId < m_workerTypes.size(); threadId++ )
+	{
+		json += Stringf( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"worker %d (%s)\"}},\n", threadId, threadId, GetJobTypeName( m_workerTypes[ threadId ] ) );
+	}
+	json += Stringf( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"other threads\"}}", ( int ) m_workerTypes.size() );
+
+	for ( int recordIndex = 0; recordIndex < m_traceRecords.size(); recordIndex++ )
+	{
+		JobTimingRecord const& record = m_traceRecords[ recordIndex ];
+
+		bool		isWorker = record.m_threadId >= 0 && record.m_threadId < m_workerTypes.size();
+		int			tid		 = isWorker ? record.m_threadId : ( int ) m_workerTypes.size();
+		std::string name	 = EscapeJsonString( record.m_name ? record.m_name : GetJobTypeName( record.m_type ) );
+
+		json += Stringf( ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"priority\":\"%s\",\"wait_us\":%.3f}}",
+			name.c_str(), GetJobTypeName( record.m_type ), tid,
+			( record.m_startSeconds - m_traceStartSeconds ) * 1000000.0,
+			( record.m_endSeconds - record.m_startSeconds ) * 1000000.0,
+			GetJobPriorityName( record.m_priority ),
+			( record.m_startSeconds - record.m_enqueueSeconds ) * 1000000.0 );
+	}
+
+	json += "\n]}\n";
+	return FileWriteFromString( json, fileName ) != 0;
+}
+
+
+//-------------------------------------------------------------------------
+bool JobProfiler::Command_JobStats( EventArgs& args )
+{
+	JobProfiler* profiler = g_theJobSystem ? g_theJobSystem->GetProfiler() : nullptr;
+	if ( profiler == nullptr )
+	{
+		LogToDevConsole( DevConsole::ERROR_COLOR, "JobStats: job system is not running" );
+		return true;
+	}
+
+	bool isEnabled = args.GetValue( "Enable", true );
+	if ( !isEnabled )
+	{
+		profiler->SetEnabled( false );
+		LogToDevConsole( DevConsole::INFO_MINOR_COLOR, "JobStats: instrumentation off" );
+		return true;
+	}
+
+	if ( !profiler->IsEnabled() )
+	{
+		profiler->SetEnabled( true );
+		LogToDevConsole( DevConsole::INFO_MINOR_COLOR, "JobStats: instrumentation on, stats start next frame" );
+		return true;
+	}
+
+	profiler->LogStats();
+	return true;
+}
+
+
+//-------------------------------------------------------------------------
+bool JobProfiler::Command_JobTrace( EventArgs& args )
+{
+	JobProfiler* profiler = g_theJobSystem ? g_theJobSystem->GetProfiler() : nullptr;
+	if ( profiler == nullptr )
+	{
+		LogToDevConsole( DevConsole::ERROR_COLOR, "JobTrace: job system is not running" );
+		return true;
+	}
+
+	int			numFrames = args.GetValue( "Frames", 120 );
+	std::string fileName  = args.GetValue( "File", "JobTrace.json" );
+
+	profiler->StartTrace( numFrames, fileName );
+	LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "JobTrace: capturing %d frames", numFrames ) );
+	return true;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+//-------------------------------------------------------------------------
+constexpr int JOB_PROFILER_RECORDS_PER_THREAD = 8192; // per frame, before records get dropped; power of two
+constexpr int JOB_PROFILER_MAX_TRACE_RECORDS  = 1 << 20;
+
+
+//-------------------------------------------------------------------------
+struct JobTimingRecord
+{
+	double		m_enqueueSeconds = 0.0; // when the job became ready to run
+	double		m_startSeconds	 = 0.0;
+	double		m_endSeconds	 = 0.0;
+	char const* m_name			 = nullptr;
+	int			m_threadId		 = -1; // worker thread id, -1 for any other thread helping out
+	JobType		m_type			 = JobType::COMPUTATION;
+	JobPriority m_priority		 = JobPriority::NORMAL;
+};
+
+
+//-------------------------------------------------------------------------
+struct JobFrameStats
+{
+	double m_frameSeconds		   = 0.0;
+	int	   m_numJobsExecuted	   = 0;
+	int	   m_queueDepth			   = 0; // jobs ready but not started at the end of the frame
+	int	   m_peakQueueDepth		   = 0;
+	double m_averageWaitSeconds	   = 0.0;
+	double m_maxWaitSeconds		   = 0.0;
+	double m_averageExecuteSeconds = 0.0;
+	double m_maxExecuteSeconds	   = 0.0;
+	int	   m_numDroppedRecords	   = 0;
+
+	std::vector<float> m_workerUtilization; // busy fraction of the frame, by worker thread id; last entry is every other thread
+};
+
+
+//-------------------------------------------------------------------------
+// Optional instrumentation for the JobSystem.
+// While enabled, every job made ready gets an enqueue timestamp, and the thread running it
+// writes one JobTimingRecord into its own lock-free ring. EndFrame() drains the rings into
+// per-frame stats and, while a trace is being captured, into a Chrome trace
+// (chrome://tracing, ui.perfetto.dev).
+// While disabled the job system only pays one flag check per scheduled job.
+//
+// DevConsole:
+//	JobStats [Enable=false]				 print the last frame's stats; turns instrumentation on if it was off
+//	JobTrace [Frames=120] [File=JobTrace.json]	 capture the next frames and write them as a Chrome trace
+class JobProfiler
+{
+public:
+	JobProfiler( std::vector<JobType> const& workerTypes ); // lane of each worker, by thread id
+	~JobProfiler();
+
+	void EndFrame();
+
+	bool IsEnabled() const { return m_isEnabled.load( std::memory_order_relaxed ); }
+	void SetEnabled( bool isEnabled );
+
+	void OnJobQueued();
+	void OnJobStarted();
+	void RecordJob( JobTimingRecord const& record );
+
+	JobFrameStats const& GetLastFrameStats() const { return m_lastFrameStats; }
+
+	void StartTrace( int numFrames, std::string const& fileName );
+	bool IsTracing() const { return m_numTraceFramesLeft > 0; }
+	bool WriteChromeTrace( std::string const& fileName ) const;
+
+	static bool Command_JobStats( EventArgs& args );
+	static bool Command_JobTrace( EventArgs& args );
+
+private:
+	// one writer, EndFrame() is the only reader
+	struct TimingRecordRing
+	{
+		JobTimingRecord						  m_records[ JOB_PROFILER_RECORDS_PER_THREAD ];
+		alignas( 64 ) std::atomic<unsigned int> m_writeIndex = 0;
+		alignas( 64 ) std::atomic<unsigned int> m_readIndex	 = 0;
+
+		bool Push( JobTimingRecord const& record );
+	};
+
+	void DrainRing( TimingRecordRing& ring, std::vector<double>& busySecondsByThread, double& totalWaitSeconds, double& totalExecuteSeconds );
+	void LogStats() const;
+
+	std::vector<JobType>		   m_workerTypes;
+	std::vector<TimingRecordRing*> m_workerRings; // by worker thread id
+	TimingRecordRing*			   m_otherThreadsRing = nullptr;
+	std::mutex					   m_otherThreadsMutex; // any number of non-worker threads share one ring
+
+	std::atomic<bool> m_isEnabled			   = false;
+	std::atomic<int>  m_queueDepth			   = 0;
+	std::atomic<int>  m_peakQueueDepth		   = 0;
+	std::atomic<int>  m_numDroppedRecords	   = 0;
+	double			  m_lastEndFrameSeconds	   = 0.0;
+	JobFrameStats	  m_lastFrameStats;
+
+	int							 m_numTraceFramesLeft = 0;
+	bool						 m_wasEnabledBeforeTrace = false;
+	double						 m_traceStartSeconds  = 0.0;
+	std::string					 m_traceFileName;
+	std::vector<JobTimingRecord> m_traceRecords;
+};
@@ -0,0 +1,135 @@
+#include "Engine/Core/JobShutdownTest.hpp"
+#include "Engine/Core/AsyncFileIO.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <atomic>
+#include <cstdio>
+
+
+//-------------------------------------------------------------------------
+constexpr char const* JOB_SHUTDOWN_TEST_FILE_NAME = "JobShutdownTest.tmp";
+
+
+//-------------------------------------------------------------------------
+static void LogToDevConsole( Rgba8 const& color, std::string const& text )
+{
+	if ( g_theDevConsole )
+	{
+		g_theDevConsole->AddLine( color, text );
+	}
+	else
+	{
+		DebuggerPrintf( "%s\n", text.c_str() );
+	}
+}
+
+
+//-------------------------------------------------------------------------
+struct JobShutdownTestCounters
+{
+	std::atomic<int> m_numJobsDeleted	 = 0;
+	std::atomic<int> m_numReadsSucceeded = 0;
+	std::atomic<int> m_numReadsFailed	 = 0;
+};
+
+
+//-------------------------------------------------------------------------
+class JobShutdownTestReadJob : public Job
+{
+public:
+	JobShutdownTestReadJob( JobSystem* jobSystem, JobShutdownTestCounters* counters )
+		: m_jobSystem( jobSystem )
+		, m_counters( counters )
+	{
+		m_read.m_filename = JOB_SHUTDOWN_TEST_FILE_NAME;
+	}
+
+	~JobShutdownTestReadJob() { m_counters->m_numJobsDeleted.fetch_add( 1, std::memory_order_relaxed ); }
+
+	void Execute() override
+	{
+		if ( !m_hasRead )
+		{
+			m_hasRead = true;
+			m_jobSystem->SuspendForFileRead( this, m_read );
+			return;
+		}
+
+		std::atomic<int>& counter = m_read.m_succeeded ? m_counters->m_numReadsSucceeded : m_counters->m_numReadsFailed;
+		counter.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+private:
+	JobSystem*				 m_jobSystem = nullptr;
+	JobShutdownTestCounters* m_counters	 = nullptr;
+	AsyncFileRead			 m_read;
+	bool					 m_hasRead = false;
+};
+
+
+//-------------------------------------------------------------------------
+JobShutdownTestResult RunJobShutdownTest( int numJobs, int numWorkers )
+{
+	std::vector<uint8_t> fileContents( 64 * 1024, 0x5A );
+	FileWriteFromBuffer( fileContents, JOB_SHUTDOWN_TEST_FILE_NAME );
+
+	JobSystemConfig config;
+	config.m_preferredNumberOfWorkerThreads = numWorkers;
+	config.m_numDiskIOWorkers				= 0;
+	config.m_subscribeToCommands			= false;
+
+	JobShutdownTestCounters counters;
+	JobSystem*				jobSystem = new JobSystem( config );
+	jobSystem->Startup();
+	for ( int jobIndex = 0; jobIndex < numJobs; jobIndex++ )
+	{
+		jobSystem->PostNewJob( new JobShutdownTestReadJob( jobSystem, &counters ) );
+	}
+	jobSystem->Shutdown();
+	delete jobSystem;
+
+	remove( JOB_SHUTDOWN_TEST_FILE_NAME );
+
+	JobShutdownTestResult result;
+	result.m_numJobs			 = numJobs;
+	result.m_numJobsDeleted		 = counters.m_numJobsDeleted.load();
+	result.m_numReadsSucceeded	 = counters.m_numReadsSucceeded.load();
+	result.m_numReadsFailed		 = counters.m_numReadsFailed.load();
+	result.m_numJobsNeverResumed = numJobs - result.m_numJobsDeleted;
+	return result;
+}
+
+
+//-------------------------------------------------------------------------
+bool Command_JobShutdownTest( EventArgs& args )
+{
+	int numJobs	   = args.GetValue( "Jobs", 2000 );
+	int numWorkers = args.GetValue( "Workers", 4 );
+	int numRuns	   = args.GetValue( "Runs", 20 );
+	if ( numJobs < 1 || numWorkers < 1 || numRuns < 1 )
+	{
+		LogToDevConsole( DevConsole::ERROR_COLOR, "JobShutdownTest: Jobs, Workers and Runs have to be at least 1" );
+		return true;
+	}
+
+	JobShutdownTestResult totals;
+	for ( int runIndex = 0; runIndex < numRuns; runIndex++ )
+	{
+		JobShutdownTestResult result = RunJobShutdownTest( numJobs, numWorkers );
+		totals.m_numJobs			 += result.m_numJobs;
+		totals.m_numJobsDeleted		 += result.m_numJobsDeleted;
+		totals.m_numReadsSucceeded	 += result.m_numReadsSucceeded;
+		totals.m_numReadsFailed		 += result.m_numReadsFailed;
+		totals.m_numJobsNeverResumed += result.m_numJobsNeverResumed;
+	}
+
+	Rgba8 color = totals.m_numJobsNeverResumed == 0 ? DevConsole::INFO_MAJOR_COLOR : DevConsole::ERROR_COLOR;
+	LogToDevConsole( color, Stringf( "JobShutdownTest: %d runs of %d jobs; %d reads succeeded, %d failed at shutdown, %d jobs left suspended",
+		numRuns, numJobs, totals.m_numReadsSucceeded, totals.m_numReadsFailed, totals.m_numJobsNeverResumed ) );
+	return true;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+
+
+//-------------------------------------------------------------------------
+struct JobShutdownTestResult
+{
+	int m_numJobs			  = 0;
+	int m_numJobsDeleted	  = 0; // a job suspended on a read nobody completes is never deleted
+	int m_numReadsSucceeded	  = 0;
+	int m_numReadsFailed	  = 0; // asked for after Shutdown() closed reads
+	int m_numJobsNeverResumed = 0; // suspended on a read, yet never ran again nor was deleted
+};
+
+
+//-------------------------------------------------------------------------
+// Starts a JobSystem of its own, posts numJobs jobs that each suspend on a file read, and shuts it
+// down right away, while most of them are still queued, reading or waiting to resume.
+// Shutdown() has to return with every job deleted; a read started while the file I/O is torn down
+// would crash, or leave its job suspended for good
+JobShutdownTestResult RunJobShutdownTest( int numJobs, int numWorkers );
+
+// "JobShutdownTest Jobs=2000 Workers=4 Runs=20"
+// JobSystem::Startup() subscribes it, next to JobStats and JobTrace
+bool Command_JobShutdownTest( EventArgs& args );
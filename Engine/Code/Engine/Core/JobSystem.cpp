@@ -1,14 +1,88 @@
 #include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/AsyncFileIO.hpp"
+#include "Engine/Core/JobProfiler.hpp"
+#include "Engine/Core/JobShutdownTest.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/Time.hpp"
 
 
 //-------------------------------------------------------------------------
-JobWorkerThread::JobWorkerThread(JobSystem* jobSystem, int threadId, JobType workingJobType) :
+// the worker running on the calling thread, nullptr on the main thread
+static thread_local JobWorkerThread* s_currentWorkerThread = nullptr;
+
+
+//-------------------------------------------------------------------------
+void* Job::operator new(size_t numBytes)
+{
+	return JobPool::GetInstance().Allocate(numBytes);
+}
+
+void Job::operator delete(void* memory, size_t numBytes)
+{
+	JobPool::GetInstance().Free(memory, numBytes);
+}
+
+void Job::AddContinuation(Job* continuation)
+{
+	continuation->m_numPendingDependencies.fetch_add(1, std::memory_order_relaxed);
+
+	if (m_numContinuations < NUM_INLINE_CONTINUATIONS)
+	{
+		m_inlineContinuations[m_numContinuations] = continuation;
+	}
+	else
+	{
+		if (m_overflowContinuations.size() == m_overflowContinuations.capacity())
+		{
+			JobPool::GetInstance().CountHeapAllocation();
+		}
+		m_overflowContinuations.push_back(continuation);
+	}
+	++m_numContinuations;
+}
+
+void Job::Suspend()
+{
+	m_isSuspended = true;
+	m_numSuspensionHolds.store(2, std::memory_order_relaxed);
+}
+
+Job* Job::GetContinuation(int index) const
+{
+	if (index < NUM_INLINE_CONTINUATIONS)
+	{
+		return m_inlineContinuations[index];
+	}
+
+	return m_overflowContinuations[index - NUM_INLINE_CONTINUATIONS];
+}
+
+
+
+
+//-------------------------------------------------------------------------
+CallableJob::~CallableJob()
+{
+	m_destroyCallable(m_callableStorage);
+}
+
+void CallableJob::Execute()
+{
+	m_invokeCallable(m_callableStorage);
+}
+
+
+
+
+//-------------------------------------------------------------------------
+JobWorkerThread::JobWorkerThread(JobSystem* jobSystem, int threadId, JobType workingJobType, int indexInLane) :
 	m_jobSystem(jobSystem),
 	m_threadID(threadId),
-	m_workingJobType(workingJobType)
+	m_workingJobType(workingJobType),
+	m_indexInLane(indexInLane)
 {
-	m_thread = new std::thread(&JobWorkerThread::ThreadMain, this);
 }
 
 JobWorkerThread::~JobWorkerThread()
@@ -16,25 +90,39 @@ JobWorkerThread::~JobWorkerThread()
 	delete m_thread;
 }
 
+void JobWorkerThread::StartThread()
+{
+	m_thread = new std::thread(&JobWorkerThread::ThreadMain, this);
+}
+
 void JobWorkerThread::ThreadMain()
 {
+	s_currentWorkerThread = this;
+
+	if (m_logicalProcessorIndex >= 0)
+	{
+		CpuTopology::PinCurrentThread(m_jobSystem->GetCpuTopology().GetLogicalProcessor(m_logicalProcessorIndex));
+	}
+
+	int numFailedAttempts = 0;
 	while (!m_jobSystem->IsQuitting())
 	{
-		Job* jobToDo = m_jobSystem->GetNewJobToWorkOn(m_workingJobType);
+		Job* jobToDo = m_jobSystem->GetNewJobToWorkOn(*this);
 
 		if (jobToDo)
 		{
-			jobToDo->Execute(); // this will take some time to complete
-
-			m_jobSystem->MarkJobAsComplete(jobToDo);
+			m_jobSystem->ExecuteJob(jobToDo); // this will take some time to complete
+			numFailedAttempts = 0;
 		}
 		else
 		{
-			// sleep
 			// don't hog the CPU, just checking for work
-			std::this_thread::sleep_for(std::chrono::microseconds(1));
+			m_jobSystem->WaitForWork(*this, numFailedAttempts);
+			++numFailedAttempts;
 		}
 	}
+
+	s_currentWorkerThread = nullptr;
 }
 
 
@@ -47,226 +135,986 @@ JobSystem::JobSystem(JobSystemConfig config) : m_config(config)
 
 void JobSystem::Startup()
 {
+	m_cpuTopology.Discover();
+
 	int numWorkers = m_config.m_preferredNumberOfWorkerThreads;
 
 	if (numWorkers < 0)
 	{
 		int numCpuCores = std::thread::hardware_concurrency();
+		if (m_config.m_pinWorkerThreads && m_config.m_avoidSmtSiblings)
+		{
+			numCpuCores = m_cpuTopology.GetNumCores();
+		}
 		numWorkers = numCpuCores - 1;
 	}
 
-	int diskIOWorkeres = NUM_DISK_IO_THREADS;
-	int computationWorkers = numWorkers - diskIOWorkeres;
+	JobPool::GetInstance().Reserve(m_config.m_numPreallocatedJobs);
+
+	int diskIOWorkers = m_config.m_numDiskIOWorkers;
+	if (diskIOWorkers > numWorkers)
+	{
+		diskIOWorkers = numWorkers;
+	}
+	int computationWorkers = numWorkers - diskIOWorkers;
+
+	CreateWorkers(diskIOWorkers, JobType::DISK_IO);
+	CreateWorkers(computationWorkers, JobType::COMPUTATION);
+
+	if (m_config.m_pinWorkerThreads)
+	{
+		PlaceWorkers();
+	}
+	BuildStealOrders();
+
+	for (int priorityIndex = 0; priorityIndex < NUM_JOB_PRIORITIES; ++priorityIndex)
+	{
+		m_numReservedWorkers[priorityIndex] = m_config.m_numReservedWorkers[priorityIndex];
+	}
+	ApplyReservations();
+
+	std::vector<JobType> workerTypes;
+	for (int index = 0; index < m_workers.size(); ++index)
+	{
+		workerTypes.push_back(m_workers[index]->m_workingJobType);
+	}
+	m_profiler = new JobProfiler(workerTypes);
+	m_profiler->SetEnabled(m_config.m_enableInstrumentation);
+
+	m_areFileReadsClosed = false;
+	m_fileIO = new AsyncFileIO(this);
 
-	CreateWorkers(diskIOWorkeres, JobType::DISK_IO, NUM_DISK_IO_THREADS - 1);
-	CreateWorkers(computationWorkers, JobType::COMPUTATION, NUM_DISK_IO_THREADS);
+	if (g_theEventSystem && m_config.m_subscribeToCommands)
+	{
+		g_theEventSystem->SubscribeToEvent("JobStats", JobProfiler::Command_JobStats);
+		g_theEventSystem->SubscribeToEvent("JobTrace", JobProfiler::Command_JobTrace);
+		g_theEventSystem->SubscribeToEvent("JobShutdownTest", Command_JobShutdownTest);
+	}
+
+	// lanes must be fully populated before any worker starts looking for someone to steal from
+	for (int index = 0; index < m_workers.size(); ++index)
+	{
+		m_workers[index]->StartThread();
+	}
 }
 
 void JobSystem::BeginFrame()
 {
+	m_frameDeadlineSeconds.store(GetCurrentTimeSeconds() + m_config.m_frameCriticalDeadlineSeconds, std::memory_order_relaxed);
+
+	Job* nextFrameJob = m_nextFrameJobsHead.exchange(nullptr, std::memory_order_acquire);
+	while (nextFrameJob)
+	{
+		Job* nextNextFrameJob = nextFrameJob->m_nextJob;
+		nextFrameJob->m_nextJob = nullptr;
+		ResumeJob(nextFrameJob);
+		nextFrameJob = nextNextFrameJob;
+	}
 }
 
 void JobSystem::EndFrame()
 {
+	int numMissedDeadlines = m_numMissedDeadlinesThisFrame.exchange(0, std::memory_order_relaxed);
+	double worstMissSeconds = m_worstMissThisFrameSeconds.exchange(0.0, std::memory_order_relaxed);
+	if (numMissedDeadlines > 0)
+	{
+		DebuggerPrintf("JobSystem: %d frame critical job(s) missed their deadline, worst by %.3f ms\n", numMissedDeadlines, worstMissSeconds * 1000.0);
+	}
+
+	if (m_profiler)
+	{
+		m_profiler->EndFrame();
+	}
 }
 
 void JobSystem::Shutdown()
 {
+	if (g_theEventSystem && m_config.m_subscribeToCommands)
+	{
+		g_theEventSystem->UnsubscribeFromEvent("JobStats", JobProfiler::Command_JobStats);
+		g_theEventSystem->UnsubscribeFromEvent("JobTrace", JobProfiler::Command_JobTrace);
+		g_theEventSystem->UnsubscribeFromEvent("JobShutdownTest", Command_JobShutdownTest);
+	}
+
+	// no new reads from here on; pairs with the fence in SuspendForFileRead() so that either it sees
+	// the flag or we see it starting a read, which we then wait for before the reads in flight
+	m_areFileReadsClosed.store(true, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	while (m_numFileReadsStarting.load(std::memory_order_acquire) > 0)
+	{
+		std::this_thread::yield();
+	}
+
+	// reads in flight resume their jobs while the workers are still around to run them
+	delete m_fileIO;
+	m_fileIO = nullptr;
+
 	m_isQuitting = true;
 
+	// wake everybody up so parked workers see the quit flag
+	for (int laneIndex = 0; laneIndex < NUM_JOB_TYPES; ++laneIndex)
+	{
+		JobLane& lane = m_lanes[laneIndex];
+		for (int priorityIndex = 0; priorityIndex < NUM_JOB_PRIORITIES; ++priorityIndex)
+		{
+			lane.m_wakeUpSignals[priorityIndex].Release((int) lane.m_workers.size());
+		}
+	}
+
 	// join all threads
 	for (int index = 0; index < m_workers.size(); ++index)
 	{
 		JobWorkerThread* worker = m_workers[index];
 		worker->m_thread->join();
-
-		delete worker;
-		m_workers[index] = nullptr;
 	}
 
 	// flush and delete all unclaimed jobs
-	while (!m_unclaimedJobsQueue.empty())
+	for (int laneIndex = 0; laneIndex < NUM_JOB_TYPES; ++laneIndex)
 	{
-		Job* job = m_unclaimedJobsQueue.front();
-		m_unclaimedJobsQueue.pop_front();
-		delete job;
+		JobLane& lane = m_lanes[laneIndex];
+
+		for (int priorityIndex = 0; priorityIndex < NUM_JOB_PRIORITIES; ++priorityIndex)
+		{
+			Job* postedJob = lane.m_postedJobsHeads[priorityIndex].exchange(nullptr);
+			while (postedJob)
+			{
+				Job* nextPostedJob = postedJob->m_nextJob;
+				DeleteUnfinishedJob(postedJob);
+				postedJob = nextPostedJob;
+			}
+		}
+
+		for (int workerIndex = 0; workerIndex < lane.m_workers.size(); ++workerIndex)
+		{
+			lane.m_workers[workerIndex] = nullptr;
+		}
+		lane.m_workers.clear();
 	}
 
-	// flush and delete all claimed jobs
-	for (auto iter = m_completedJobsSet.begin(); iter != m_completedJobsSet.end(); iter++)
+	for (int index = 0; index < m_workers.size(); ++index)
 	{
-		Job* job = *iter;
-		delete job;
+		JobWorkerThread* worker = m_workers[index];
+
+		for (int priorityIndex = 0; priorityIndex < NUM_JOB_PRIORITIES; ++priorityIndex)
+		{
+			WorkStealingQueue& localJobs = worker->m_localJobs[priorityIndex];
+
+			Job* localJob = localJobs.Pop();
+			while (localJob)
+			{
+				DeleteUnfinishedJob(localJob);
+				localJob = localJobs.Pop();
+			}
+		}
+
+		delete worker;
+		m_workers[index] = nullptr;
 	}
-	m_completedJobsSet.clear();
+	m_workers.clear();
 
-	// flush and delete all claimed jobs
-	for (auto iter = m_claimedJobsSet.begin(); iter != m_claimedJobsSet.end(); iter++)
+	Job* nextFrameJob = m_nextFrameJobsHead.exchange(nullptr);
+	while (nextFrameJob)
 	{
-		Job* job = *iter;
-		delete job;
+		Job* nextNextFrameJob = nextFrameJob->m_nextJob;
+		DeleteUnfinishedJob(nextFrameJob);
+		nextFrameJob = nextNextFrameJob;
+	}
+
+	// flush and delete all completed jobs
+	for (int typeIndex = 0; typeIndex < NUM_JOB_TYPES; ++typeIndex)
+	{
+		DeleteCompletedJobs(m_completedJobLists[typeIndex]);
 	}
-	m_claimedJobsSet.clear();
+
+	// only now that no worker can record anymore
+	delete m_profiler;
+	m_profiler = nullptr;
 }
 
 
 //-------------------------------------------------------------------------
-void JobSystem::CreateWorkers(int numWorkerThreads, JobType workingJobType, int startingIndex)
+void JobSystem::CreateWorkers(int numWorkerThreads, JobType workingJobType)
 {
-	for (int index = startingIndex; index < numWorkerThreads; ++index)
+	JobLane& lane = m_lanes[(int) workingJobType];
+
+	for (int index = 0; index < numWorkerThreads; ++index)
 	{
-		JobWorkerThread* worker = new JobWorkerThread(this, index, workingJobType);
+		int threadId = (int) m_workers.size();
+		int indexInLane = (int) lane.m_workers.size();
+
+		JobWorkerThread* worker = new JobWorkerThread(this, threadId, workingJobType, indexInLane);
 		m_workers.push_back(worker);
+		lane.m_workers.push_back(worker);
+	}
+}
+
+void JobSystem::PlaceWorkers()
+{
+	std::vector<int> placementOrder = m_cpuTopology.GetWorkerPlacementOrder(m_config.m_avoidSmtSiblings);
+	if (placementOrder.empty())
+	{
+		return;
+	}
+
+	// COMPUTATION workers get the best spots, DISK_IO workers spend most of their time blocked anyway;
+	// with more workers than spots, the extra ones share from the top again
+	int placementIndex = 0;
+	for (int laneIndex = NUM_JOB_TYPES - 1; laneIndex >= 0; --laneIndex)
+	{
+		JobLane& lane = m_lanes[laneIndex];
+		for (int workerIndex = 0; workerIndex < lane.m_workers.size(); ++workerIndex, ++placementIndex)
+		{
+			JobWorkerThread* worker = lane.m_workers[workerIndex];
+			worker->m_logicalProcessorIndex = placementOrder[placementIndex % placementOrder.size()];
+			worker->m_numaNode = m_cpuTopology.GetLogicalProcessor(worker->m_logicalProcessorIndex).m_numaNode;
+		}
+	}
+}
+
+void JobSystem::BuildStealOrders()
+{
+	for (int laneIndex = 0; laneIndex < NUM_JOB_TYPES; ++laneIndex)
+	{
+		JobLane& lane = m_lanes[laneIndex];
+		int numWorkersInLane = (int) lane.m_workers.size();
+
+		for (int workerIndex = 0; workerIndex < numWorkersInLane; ++workerIndex)
+		{
+			JobWorkerThread* thief = lane.m_workers[workerIndex];
+			thief->m_stealOrder.clear();
+
+			// everybody starts right after themselves so thieves don't all pile onto the same victim;
+			// jobs stolen from the same node find their data in the nearer memory and cache
+			for (int pass = 0; pass < 2; ++pass)
+			{
+				for (int offset = 1; offset < numWorkersInLane; ++offset)
+				{
+					int victimIndex = (workerIndex + offset) % numWorkersInLane;
+					bool isSameNode = lane.m_workers[victimIndex]->m_numaNode == thief->m_numaNode;
+					if (isSameNode == (pass == 0))
+					{
+						thief->m_stealOrder.push_back(victimIndex);
+					}
+				}
+			}
+		}
+	}
+}
+
+void JobSystem::ApplyReservations()
+{
+	JobLane& lane = m_lanes[(int) JobType::COMPUTATION];
+	int numWorkersInLane = (int) lane.m_workers.size();
+
+	// hand out reservations in priority order, always leaving one worker that runs everything
+	int numWorkersLeft = numWorkersInLane > 0 ? numWorkersInLane - 1 : 0;
+	int workerIndex = 0;
+	for (int priorityIndex = 0; priorityIndex < (int) JobPriority::BACKGROUND; ++priorityIndex)
+	{
+		int numReserved = m_numReservedWorkers[priorityIndex];
+		if (numReserved > numWorkersLeft)
+		{
+			numReserved = numWorkersLeft;
+		}
+		numWorkersLeft -= numReserved;
+
+		for (int reservedIndex = 0; reservedIndex < numReserved; ++reservedIndex, ++workerIndex)
+		{
+			lane.m_workers[workerIndex]->m_lowestPriority.store((JobPriority) priorityIndex, std::memory_order_relaxed);
+		}
+	}
+
+	for (; workerIndex < numWorkersInLane; ++workerIndex)
+	{
+		lane.m_workers[workerIndex]->m_lowestPriority.store(JobPriority::BACKGROUND, std::memory_order_relaxed);
+	}
+
+	// parked workers may now be in the wrong group; pairs with the fence in ParkWorker()
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	for (int priorityIndex = 0; priorityIndex < NUM_JOB_PRIORITIES; ++priorityIndex)
+	{
+		int numParked = lane.m_numParkedWorkers[priorityIndex].exchange(0, std::memory_order_relaxed);
+		if (numParked > 0)
+		{
+			lane.m_wakeUpSignals[priorityIndex].Release(numParked);
+		}
+	}
+}
+
+void JobSystem::SetNumReservedWorkers(JobPriority priority, int numWorkers)
+{
+	std::lock_guard<std::mutex> reservationLock(m_reservationMutex);
+
+	m_numReservedWorkers[(int) priority] = numWorkers > 0 ? numWorkers : 0;
+	ApplyReservations();
+}
+
+int JobSystem::GetNumReservedWorkers(JobPriority priority) const
+{
+	JobLane const& lane = m_lanes[(int) JobType::COMPUTATION];
+
+	int numReserved = 0;
+	for (int workerIndex = 0; workerIndex < lane.m_workers.size(); ++workerIndex)
+	{
+		if (lane.m_workers[workerIndex]->m_lowestPriority.load(std::memory_order_relaxed) == priority)
+		{
+			++numReserved;
+		}
+	}
+
+	return numReserved;
+}
+
+int JobSystem::GetNumMissedDeadlines() const
+{
+	return m_numMissedDeadlines.load(std::memory_order_relaxed);
+}
+
+void JobSystem::ReportMissedDeadline(double secondsLate)
+{
+	m_numMissedDeadlines.fetch_add(1, std::memory_order_relaxed);
+	m_numMissedDeadlinesThisFrame.fetch_add(1, std::memory_order_relaxed);
+
+	double worstMissSeconds = m_worstMissThisFrameSeconds.load(std::memory_order_relaxed);
+	while (secondsLate > worstMissSeconds && !m_worstMissThisFrameSeconds.compare_exchange_weak(worstMissSeconds, secondsLate, std::memory_order_relaxed))
+	{
+	}
+}
+
+void JobSystem::StampFrameDeadline(Job* job)
+{
+	// a job that suspended keeps a deadline it was given, but not the one of the frame it started in
+	if (job->m_priority == JobPriority::FRAME_CRITICAL && (job->m_deadlineSeconds == 0.0 || job->m_hasFrameDeadline))
+	{
+		job->m_deadlineSeconds = m_frameDeadlineSeconds.load(std::memory_order_relaxed);
+		job->m_hasFrameDeadline = true;
 	}
 }
 
 void JobSystem::PostNewJob(Job* job)
 {
-	// add a new job to unclaimed list
-	//-------------------------------------------------------------------------
-	// lock
-	m_unclaimedJobsMutex.lock();
-	m_unclaimedJobsQueue.push_back(job);
-	m_unclaimedJobsMutex.unlock();
-	// unlock
-	//-------------------------------------------------------------------------
+	StampFrameDeadline(job);
+
+	// drop the "not posted yet" dependency; if nothing else is pending the job is ready to run
+	int numPendingDependencies = job->m_numPendingDependencies.fetch_sub(1, std::memory_order_acq_rel) - 1;
+	if (numPendingDependencies == 0)
+	{
+		ScheduleJob(job);
+	}
 }
 
 
-Job* JobSystem::RetriveOneCompletedJob()
+void JobSystem::ScheduleJob(Job* job)
 {
-	Job* completedJob = nullptr;
+	// once pushed, the job may already be running (and, if self-deleting, gone), so don't touch it afterwards
+	JobType		type = job->GetType();
+	JobPriority priority = job->GetPriority();
+	JobLane&	lane = m_lanes[(int) type];
 
-	//-------------------------------------------------------------------------
-	// lock
-	m_completedJobsMutex.lock();
-	if (!m_completedJobsSet.empty())
+	if (m_profiler && m_profiler->IsEnabled())
 	{
-		completedJob = *m_completedJobsSet.begin();
-		m_completedJobsSet.erase(m_completedJobsSet.begin());
+		job->m_enqueueSeconds = GetCurrentTimeSeconds();
+		m_profiler->OnJobQueued();
 	}
-	m_completedJobsMutex.unlock();
-	// unlock
-	//-------------------------------------------------------------------------
 
-	return completedJob;
+	// a worker scheduling into its own lane keeps the job local, idle workers will steal it if needed
+	JobWorkerThread* currentWorker = s_currentWorkerThread;
+	if (currentWorker && currentWorker->m_jobSystem == this && currentWorker->m_workingJobType == type &&
+		priority <= currentWorker->m_lowestPriority.load(std::memory_order_relaxed))
+	{
+		currentWorker->m_localJobs[(int) priority].Push(job);
+		WakeParkedWorker(lane, priority);
+		return;
+	}
+
+	// everybody else pushes onto the lane's posted jobs stack
+	std::atomic<Job*>& postedJobsHead = lane.m_postedJobsHeads[(int) priority];
+
+	Job* head = postedJobsHead.load(std::memory_order_relaxed);
+	do
+	{
+		job->m_nextJob = head;
+	}
+	while (!postedJobsHead.compare_exchange_weak(head, job, std::memory_order_release, std::memory_order_relaxed));
+
+	WakeParkedWorker(lane, priority);
 }
 
 
-std::unordered_set<Job*> JobSystem::RetrieveAllCompleteJobs()
+void JobSystem::WaitFor(Job* job)
 {
-	std::unordered_set<Job*> completedJobs;
+	// instead of blocking, help out with the jobs of the lane the awaited job runs in
+	while (!job->IsComplete())
+	{
+		if (!TryRunOneJob(job->GetType()))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
 
-	//-------------------------------------------------------------------------
-	// lock
-	m_completedJobsMutex.lock();
 
-	completedJobs = m_completedJobsSet;
-	m_completedJobsSet.clear();
+void JobSystem::ResumeJob(Job* job)
+{
+	if (job->m_numSuspensionHolds.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		StampFrameDeadline(job);
+		ScheduleJob(job);
+	}
+}
 
-	m_completedJobsMutex.unlock();
-	// unlock
-	//-------------------------------------------------------------------------
 
-	return completedJobs;
+void JobSystem::SuspendForFileRead(Job* job, AsyncFileRead& read)
+{
+	job->Suspend();
+
+	m_numFileReadsStarting.fetch_add(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (m_areFileReadsClosed.load(std::memory_order_relaxed))
+	{
+		// shutting down; m_fileIO may already be gone, and nothing would complete the read anyway
+		m_numFileReadsStarting.fetch_sub(1, std::memory_order_release);
+		read.m_succeeded = false;
+		read.m_buffer.clear();
+		ResumeJob(job);
+		return;
+	}
+
+	// counted as in flight once StartRead() returns, so the destructor of m_fileIO waits for it
+	m_fileIO->StartRead(read, job);
+	m_numFileReadsStarting.fetch_sub(1, std::memory_order_release);
 }
 
 
-std::unordered_set<Job*> JobSystem::RetrieveAllCompletedJobsOfType(JobType type)
+void JobSystem::SuspendUntilNextFrame(Job* job)
 {
-	std::unordered_set<Job*> completedJobsOfType;
+	job->Suspend();
+
+	// BeginFrame() resumes everything on here; until then only the running thread's hold keeps it back
+	Job* head = m_nextFrameJobsHead.load(std::memory_order_relaxed);
+	do
+	{
+		job->m_nextJob = head;
+	}
+	while (!m_nextFrameJobsHead.compare_exchange_weak(head, job, std::memory_order_release, std::memory_order_relaxed));
+}
+
+
+int JobSystem::GetNumFileReadsInFlight() const
+{
+	return m_fileIO ? m_fileIO->GetNumReadsInFlight() : 0;
+}
 
-	//-------------------------------------------------------------------------
-	// lock
-	m_completedJobsMutex.lock();
 
-	for (auto iter = m_completedJobsSet.begin(); iter != m_completedJobsSet.end(); iter++)
+bool JobSystem::TryRunOneJob(JobType type)
+{
+	JobLane& lane = m_lanes[(int) type];
+
+	// workers of the lane go through their usual pop/claim/steal, everybody else claims and steals;
+	// claiming matters, jobs scheduled from outside the lane only ever land on its posted stacks,
+	// and a lane without workers has nobody else to run them
+	Job*			 jobToDo	   = nullptr;
+	JobWorkerThread* currentWorker = s_currentWorkerThread;
+	if (currentWorker && currentWorker->m_jobSystem == this && currentWorker->m_workingJobType == type)
 	{
-		Job* job = *iter;
-		if (job->GetType() == type)
+		jobToDo = GetNewJobToWorkOn(*currentWorker);
+	}
+	else
+	{
+		for (int priorityIndex = 0; priorityIndex < NUM_JOB_PRIORITIES && jobToDo == nullptr; ++priorityIndex)
 		{
-			completedJobsOfType.insert(job);
+			jobToDo = ClaimPostedJobFromLane(lane, (JobPriority) priorityIndex);
+			if (jobToDo == nullptr)
+			{
+				jobToDo = StealJobFromLane(lane, 0, (JobPriority) priorityIndex);
+			}
 		}
 	}
 
-	for (auto iter = completedJobsOfType.begin(); iter != completedJobsOfType.end(); iter++)
+	if (jobToDo == nullptr)
+	{
+		return false;
+	}
+
+	ExecuteJob(jobToDo);
+	return true;
+}
+
+
+int JobSystem::RetrieveCompletedJobs(JobType type, Job** out_completedJobs, int maxNumJobs)
+{
+	CompletedJobList& completedJobList = m_completedJobLists[(int) type];
+
+	int numRetrieved = 0;
+	while (numRetrieved < maxNumJobs)
 	{
-		Job* job = *iter;
-		m_completedJobsSet.erase(job);
+		if (completedJobList.m_retrievedJobs == nullptr)
+		{
+			// cheap check first so an empty list costs no read-modify-write
+			if (completedJobList.m_completedJobsHead.load(std::memory_order_relaxed) == nullptr)
+			{
+				break;
+			}
+
+			// take the whole stack at once and flip it to oldest first
+			Job* completedJob = completedJobList.m_completedJobsHead.exchange(nullptr, std::memory_order_acquire);
+			Job* oldestCompletedJob = nullptr;
+			while (completedJob)
+			{
+				Job* olderCompletedJob = completedJob->m_nextJob;
+				completedJob->m_nextJob = oldestCompletedJob;
+				oldestCompletedJob = completedJob;
+				completedJob = olderCompletedJob;
+			}
+			completedJobList.m_retrievedJobs = oldestCompletedJob;
+		}
+
+		Job* job = completedJobList.m_retrievedJobs;
+		completedJobList.m_retrievedJobs = job->m_nextJob;
+		job->m_nextJob = nullptr;
+
+		out_completedJobs[numRetrieved] = job;
+		++numRetrieved;
 	}
 
-	m_completedJobsMutex.unlock();
-	// unlock
-	//-------------------------------------------------------------------------
+	return numRetrieved;
+}
+
+
+int JobSystem::RetrieveCompletedJobs(Job** out_completedJobs, int maxNumJobs)
+{
+	int numRetrieved = 0;
+	for (int typeIndex = 0; typeIndex < NUM_JOB_TYPES; ++typeIndex)
+	{
+		numRetrieved += RetrieveCompletedJobs((JobType) typeIndex, out_completedJobs + numRetrieved, maxNumJobs - numRetrieved);
+	}
+
+	return numRetrieved;
+}
+
+
+Job* JobSystem::RetriveOneCompletedJob()
+{
+	Job* completedJob = nullptr;
+	RetrieveCompletedJobs(&completedJob, 1);
+
+	return completedJob;
+}
+
+
+std::unordered_set<Job*> JobSystem::RetrieveAllCompleteJobs()
+{
+	std::unordered_set<Job*> completedJobs;
+	for (int typeIndex = 0; typeIndex < NUM_JOB_TYPES; ++typeIndex)
+	{
+		RetrieveAllCompletedJobsOfType((JobType) typeIndex, completedJobs);
+	}
+
+	return completedJobs;
+}
+
+
+std::unordered_set<Job*> JobSystem::RetrieveAllCompletedJobsOfType(JobType type)
+{
+	std::unordered_set<Job*> completedJobsOfType;
+	RetrieveAllCompletedJobsOfType(type, completedJobsOfType);
 
 	return completedJobsOfType;
 }
 
 
+void JobSystem::RetrieveAllCompletedJobsOfType(JobType type, std::unordered_set<Job*>& out_completedJobs)
+{
+	constexpr int BATCH_SIZE = 64;
+	Job* completedJobs[BATCH_SIZE];
+
+	int numRetrieved = RetrieveCompletedJobs(type, completedJobs, BATCH_SIZE);
+	while (numRetrieved > 0)
+	{
+		out_completedJobs.insert(completedJobs, completedJobs + numRetrieved);
+		numRetrieved = RetrieveCompletedJobs(type, completedJobs, BATCH_SIZE);
+	}
+}
+
+
 bool JobSystem::IsQuitting()
 {
 	return m_isQuitting;
 }
 
-Job* JobSystem::GetNewJobToWorkOn(JobType jobType)
+int JobSystem::GetNumWorkers(JobType type) const
 {
-	Job* jobToDo = nullptr;
+	return (int) m_lanes[(int) type].m_workers.size();
+}
 
-	// get job from un-claimed list
-	//-------------------------------------------------------------------------
-	// lock
-	m_unclaimedJobsMutex.lock();
+JobMemoryStats JobSystem::GetMemoryStats() const
+{
+	return JobPool::GetInstance().GetStats();
+}
 
-	for (auto iter = m_unclaimedJobsQueue.begin(); iter != m_unclaimedJobsQueue.end(); iter++)
+Job* JobSystem::GetNewJobToWorkOn(JobWorkerThread& worker)
+{
+	// more urgent work always goes first, even if it has to be stolen
+	JobPriority lowestPriority = worker.m_lowestPriority.load(std::memory_order_relaxed);
+	for (int priorityIndex = 0; priorityIndex <= (int) lowestPriority; ++priorityIndex)
 	{
-		Job* job = *iter;
-		if (job->GetType() == jobType)
+		JobPriority priority = (JobPriority) priorityIndex;
+
+		// 1. most recent job of our own
+		Job* jobToDo = worker.m_localJobs[priorityIndex].Pop();
+		if (jobToDo)
+		{
+			return jobToDo;
+		}
+
+		// 2. everything posted to our lane since the last claim
+		jobToDo = ClaimPostedJobs(worker, priority);
+		if (jobToDo)
+		{
+			return jobToDo;
+		}
+
+		// 3. oldest job of another worker in our lane
+		jobToDo = StealJob(worker, priority);
+		if (jobToDo)
 		{
-			jobToDo = job;
-			m_unclaimedJobsQueue.erase(iter);
-			break;
+			return jobToDo;
 		}
 	}
 
-	m_unclaimedJobsMutex.unlock();
-	// unlock
-	//-------------------------------------------------------------------------
+	return nullptr;
+}
 
+Job* JobSystem::ClaimPostedJobs(JobWorkerThread& worker, JobPriority priority)
+{
+	JobLane& lane = m_lanes[(int) worker.m_workingJobType];
+	std::atomic<Job*>& postedJobsHead = lane.m_postedJobsHeads[(int) priority];
+
+	// cheap check first so idle workers don't keep bouncing the cache line
+	if (postedJobsHead.load(std::memory_order_relaxed) == nullptr)
+	{
+		return nullptr;
+	}
 
-	// move to claimed set
-	if (jobToDo)
+	// take the whole stack at once, no ABA problem since nothing is ever popped individually
+	Job* newestPostedJob = postedJobsHead.exchange(nullptr, std::memory_order_acquire);
+	if (newestPostedJob == nullptr)
 	{
-		//-------------------------------------------------------------------------
-		// lock
-		m_claimedJobsMutex.lock();
-		m_claimedJobsSet.insert(jobToDo);
-		m_claimedJobsMutex.unlock();
-		// unlock
-		//-------------------------------------------------------------------------
+		return nullptr;
 	}
 
-	return jobToDo;
+	// the stack is newest first; push onto the local deque newest first so
+	// the owner pops oldest first, and run the oldest one right away
+	WorkStealingQueue& localJobs = worker.m_localJobs[(int) priority];
+
+	Job* postedJob = newestPostedJob;
+	while (postedJob->m_nextJob)
+	{
+		Job* olderPostedJob = postedJob->m_nextJob;
+		postedJob->m_nextJob = nullptr;
+		localJobs.Push(postedJob);
+		postedJob = olderPostedJob;
+	}
+
+	return postedJob;
+}
+
+Job* JobSystem::ClaimPostedJobFromLane(JobLane& lane, JobPriority priority)
+{
+	std::atomic<Job*>& postedJobsHead = lane.m_postedJobsHeads[(int) priority];
+
+	if (postedJobsHead.load(std::memory_order_relaxed) == nullptr)
+	{
+		return nullptr;
+	}
+
+	// no local deque to put the rest in, so take the whole stack, keep the newest job and push the
+	// others back; still no ABA problem since the stack is only ever pushed onto or taken whole.
+	// A helping thread runs jobs in any order anyway, and the newest is the one at hand
+	Job* newestPostedJob = postedJobsHead.exchange(nullptr, std::memory_order_acquire);
+	if (newestPostedJob == nullptr || newestPostedJob->m_nextJob == nullptr)
+	{
+		return newestPostedJob;
+	}
+
+	Job* restOfPostedJobs	   = newestPostedJob->m_nextJob;
+	newestPostedJob->m_nextJob = nullptr;
+
+	// nearly always nothing was posted meanwhile and the rest goes back as it is; otherwise it
+	// goes under what was, which means finding its end
+	Job* head = nullptr;
+	if (!postedJobsHead.compare_exchange_strong(head, restOfPostedJobs, std::memory_order_release, std::memory_order_relaxed))
+	{
+		Job* oldestPostedJob = restOfPostedJobs;
+		while (oldestPostedJob->m_nextJob)
+		{
+			oldestPostedJob = oldestPostedJob->m_nextJob;
+		}
+		do
+		{
+			oldestPostedJob->m_nextJob = head;
+		}
+		while (!postedJobsHead.compare_exchange_weak(head, restOfPostedJobs, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	// workers that looked while the stack was empty may have parked since
+	WakeParkedWorker(lane, priority);
+	return newestPostedJob;
+}
+
+Job* JobSystem::StealJob(JobWorkerThread& thief, JobPriority priority)
+{
+	JobLane& lane = m_lanes[(int) thief.m_workingJobType];
+
+	for (int orderIndex = 0; orderIndex < thief.m_stealOrder.size(); ++orderIndex)
+	{
+		Job* stolenJob = lane.m_workers[thief.m_stealOrder[orderIndex]]->m_localJobs[(int) priority].Steal();
+		if (stolenJob)
+		{
+			return stolenJob;
+		}
+	}
+
+	return nullptr;
+}
+
+Job* JobSystem::StealJobFromLane(JobLane& lane, int firstVictimIndex, JobPriority priority)
+{
+	int numWorkersInLane = (int) lane.m_workers.size();
+	for (int offset = 0; offset < numWorkersInLane; ++offset)
+	{
+		int victimIndex = (firstVictimIndex + offset) % numWorkersInLane;
+
+		Job* stolenJob = lane.m_workers[victimIndex]->m_localJobs[(int) priority].Steal();
+		if (stolenJob)
+		{
+			return stolenJob;
+		}
+	}
+
+	return nullptr;
+}
+
+void JobSystem::ExecuteJob(Job* job)
+{
+	double deadlineSeconds = job->m_deadlineSeconds;
+
+	// only jobs stamped by ScheduleJob() are timed, so toggling the profiler mid-frame keeps the queue depth balanced
+	JobTimingRecord timingRecord;
+	timingRecord.m_enqueueSeconds = job->m_enqueueSeconds;
+	if (timingRecord.m_enqueueSeconds > 0.0)
+	{
+		job->m_enqueueSeconds = 0.0;
+		timingRecord.m_name = job->GetDebugName();
+		timingRecord.m_type = job->GetType();
+		timingRecord.m_priority = job->GetPriority();
+		timingRecord.m_startSeconds = GetCurrentTimeSeconds();
+		m_profiler->OnJobStarted();
+	}
+
+	job->Execute();
+
+	double endSeconds = (deadlineSeconds > 0.0 || timingRecord.m_enqueueSeconds > 0.0) ? GetCurrentTimeSeconds() : 0.0;
+	if (deadlineSeconds > 0.0)
+	{
+		double secondsLate = endSeconds - deadlineSeconds;
+		if (secondsLate > 0.0)
+		{
+			ReportMissedDeadline(secondsLate);
+		}
+	}
+
+	if (timingRecord.m_enqueueSeconds > 0.0)
+	{
+		JobWorkerThread* currentWorker = s_currentWorkerThread;
+		timingRecord.m_endSeconds = endSeconds;
+		timingRecord.m_threadId = (currentWorker && currentWorker->m_jobSystem == this) ? currentWorker->m_threadID : -1;
+		m_profiler->RecordJob(timingRecord);
+	}
+
+	if (job->m_isSuspended)
+	{
+		// once we let go, the job may already be running again elsewhere
+		job->m_isSuspended = false;
+		if (job->m_numSuspensionHolds.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			StampFrameDeadline(job);
+			ScheduleJob(job);
+		}
+		return;
+	}
+
+	// release continuations before the job is handed back, the main thread may delete it right away
+	for (int index = 0; index < job->m_numContinuations; ++index)
+	{
+		Job* continuation = job->GetContinuation(index);
+
+		int numPendingDependencies = continuation->m_numPendingDependencies.fetch_sub(1, std::memory_order_acq_rel) - 1;
+		if (numPendingDependencies == 0)
+		{
+			ScheduleJob(continuation);
+		}
+	}
+
+	if (job->m_deleteWhenComplete)
+	{
+		delete job;
+		return;
+	}
+
+	job->m_isComplete.store(true, std::memory_order_release);
+	MarkJobAsComplete(job);
 }
 
 void JobSystem::MarkJobAsComplete(Job* job)
 {
-	// removed from claimed set
-	//-------------------------------------------------------------------------
-	// lock
-	m_claimedJobsMutex.lock();
-	m_claimedJobsSet.erase(job);
-	m_claimedJobsMutex.unlock();
-	//unlock
-	//-------------------------------------------------------------------------
+	// move completed job to completed list; release pairs with the acquire exchange in RetrieveCompletedJobs()
+	std::atomic<Job*>& completedJobsHead = m_completedJobLists[(int) job->GetType()].m_completedJobsHead;
 
+	Job* head = completedJobsHead.load(std::memory_order_relaxed);
+	do
+	{
+		job->m_nextJob = head;
+	}
+	while (!completedJobsHead.compare_exchange_weak(head, job, std::memory_order_release, std::memory_order_relaxed));
+}
 
-	// move completed job to claimed list
-	//-------------------------------------------------------------------------
-	// lock
-	m_completedJobsMutex.lock();
-	m_completedJobsSet.insert(job);
-	m_completedJobsMutex.unlock();
-	// unlock
-	//-------------------------------------------------------------------------
+void JobSystem::DeleteCompletedJobs(CompletedJobList& completedJobList)
+{
+	Job* completedJob = completedJobList.m_completedJobsHead.exchange(nullptr, std::memory_order_acquire);
+	while (completedJob)
+	{
+		Job* nextCompletedJob = completedJob->m_nextJob;
+		delete completedJob;
+		completedJob = nextCompletedJob;
+	}
+
+	Job* retrievedJob = completedJobList.m_retrievedJobs;
+	while (retrievedJob)
+	{
+		Job* nextRetrievedJob = retrievedJob->m_nextJob;
+		delete retrievedJob;
+		retrievedJob = nextRetrievedJob;
+	}
+	completedJobList.m_retrievedJobs = nullptr;
 }
 
+void JobSystem::DeleteUnfinishedJob(Job* job)
+{
+	// continuations that were only waiting on this job can never run either; the last
+	// predecessor to let go of a continuation deletes it, so shared continuations go exactly once
+	for (int index = 0; index < job->m_numContinuations; ++index)
+	{
+		Job* continuation = job->GetContinuation(index);
+
+		int numPendingDependencies = continuation->m_numPendingDependencies.fetch_sub(1, std::memory_order_acq_rel) - 1;
+		if (numPendingDependencies == 0)
+		{
+			DeleteUnfinishedJob(continuation);
+		}
+	}
+
+	delete job;
+}
+
+void JobSystem::WaitForWork(JobWorkerThread& worker, int numFailedAttempts)
+{
+	switch (m_config.m_idlePolicy)
+	{
+	case JobWorkerIdlePolicy::SLEEP_POLL:
+		std::this_thread::sleep_for(std::chrono::microseconds(1));
+		break;
+
+	case JobWorkerIdlePolicy::SPIN:
+		std::this_thread::yield();
+		break;
+
+	case JobWorkerIdlePolicy::SPIN_THEN_PARK:
+		if (numFailedAttempts < m_config.m_idleSpinCount)
+		{
+			std::this_thread::yield();
+		}
+		else
+		{
+			ParkWorker(worker);
+		}
+		break;
+	}
+}
+
+bool JobSystem::HasJobsInLane(JobLane const& lane, JobPriority lowestPriority) const
+{
+	for (int priorityIndex = 0; priorityIndex <= (int) lowestPriority; ++priorityIndex)
+	{
+		if (lane.m_postedJobsHeads[priorityIndex].load(std::memory_order_relaxed) != nullptr)
+		{
+			return true;
+		}
+
+		for (int workerIndex = 0; workerIndex < lane.m_workers.size(); ++workerIndex)
+		{
+			if (!lane.m_workers[workerIndex]->m_localJobs[priorityIndex].IsEmpty())
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void JobSystem::ParkWorker(JobWorkerThread& worker)
+{
+	JobLane&	lane = m_lanes[(int) worker.m_workingJobType];
+	JobPriority lowestPriority = worker.m_lowestPriority.load(std::memory_order_relaxed);
+	int			groupIndex = (int) lowestPriority;
+
+	// announce first, then look again; pairs with the fence in WakeParkedWorker() so that
+	// either the poster sees us parked or we see its job, never neither. Same goes for
+	// ApplyReservations() moving us to another group
+	lane.m_numParkedWorkers[groupIndex].fetch_add(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (!HasJobsInLane(lane, lowestPriority) && !IsQuitting() && worker.m_lowestPriority.load(std::memory_order_relaxed) == lowestPriority)
+	{
+		lane.m_wakeUpSignals[groupIndex].Acquire(); // whoever woke us already took us off the count
+		return;
+	}
+
+	// not parking after all; take ourselves off the count, unless a waker got there first and
+	// has a token on its way for us, which we then eat so it does not wake somebody later
+	if (!TryDecrementParkedCount(lane.m_numParkedWorkers[groupIndex]))
+	{
+		lane.m_wakeUpSignals[groupIndex].Acquire();
+	}
+}
+
+bool JobSystem::TryDecrementParkedCount(std::atomic<int>& numParked)
+{
+	int expected = numParked.load(std::memory_order_relaxed);
+	while (expected > 0)
+	{
+		if (numParked.compare_exchange_weak(expected, expected - 1, std::memory_order_relaxed))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void JobSystem::WakeParkedWorker(JobLane& lane, JobPriority priority)
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	// prefer the workers reserved for this priority, then the ones that run lower priorities too
+	for (int groupIndex = (int) priority; groupIndex < NUM_JOB_PRIORITIES; ++groupIndex)
+	{
+		// one token per worker going from parked to waking, so posts to a lane whose parked
+		// worker is already waking up do not pile tokens up for it
+		if (TryDecrementParkedCount(lane.m_numParkedWorkers[groupIndex]))
+		{
+			lane.m_wakeUpSignals[groupIndex].Release(1);
+			return;
+		}
+	}
+}
@@ -1,59 +1,199 @@
 #pragma once
 
+#include "Engine/Core/WorkStealingQueue.hpp"
+#include "Engine/Core/CpuTopology.hpp"
+#include "Engine/Core/Semaphore.hpp"
+#include "Engine/Core/JobPool.hpp"
+
 #include <thread>
 #include <atomic>
 #include <unordered_set>
 #include <vector>
-#include <deque>
 #include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 
 class JobSystem;
+class JobProfiler;
+class AsyncFileIO;
+struct AsyncFileRead;
 
 
 enum class JobType
 {
-	DISK_IO,
-	COMPUTATION
+	DISK_IO,	 // blocking I/O; jobs that suspend on a read (JobSystem::SuspendForFileRead()) don't need to run here
+	COMPUTATION,
+	COUNT
 };
 
+constexpr int NUM_JOB_TYPES = ( int ) JobType::COUNT;
+
 
 //-------------------------------------------------------------------------
-// Abstract Base Class; 
+// Within a lane, workers look for FRAME_CRITICAL work before NORMAL before BACKGROUND
+enum class JobPriority
+{
+	FRAME_CRITICAL, // has to be done this frame; gets a deadline, misses are reported at EndFrame()
+	NORMAL,
+	BACKGROUND,		// streaming, baking, anything allowed to take several frames
+	COUNT
+};
+
+constexpr int NUM_JOB_PRIORITIES = ( int ) JobPriority::COUNT;
+
+
+//-------------------------------------------------------------------------
+// Abstract Base Class;
+// Jobs can be chained into a graph with AddContinuation(); a posted job is held back
+// until every job it continues from has finished, and is then scheduled automatically.
+// A job may also Suspend() itself inside Execute() to wait for a file read, the next frame or
+// anything else that ends in JobSystem::ResumeJob(); no thread is held meanwhile, and
+// Execute() runs again once resumed, so such jobs keep track of their own progress:
+//	void LoadJob::Execute()
+//	{
+//		if (!m_hasRead)
+//		{
+//			m_hasRead = true;
+//			m_type = JobType::COMPUTATION; // parse on a computation worker
+//			g_theJobSystem->SuspendForFileRead(this, m_read);
+//			return;
+//		}
+//		Parse(m_read.m_buffer);
+//	}
+// new / delete of any job go through the JobPool, so creating and recycling jobs doesn't
+// touch the global heap.
 class Job
 {
+	friend class JobSystem;
+
 public:
 	Job() = default;
 	virtual ~Job() = default;
 	virtual void Execute() = 0;
+	virtual char const* GetDebugName() const { return nullptr; } // shown in job traces, the JobType when nullptr
+
+	static void* operator new(size_t numBytes);
+	static void	 operator delete(void* memory, size_t numBytes);
 
-	JobType GetType() const { return m_type; }
+	JobType		GetType() const { return m_type; }
+	JobPriority GetPriority() const { return m_priority; }
+	double		GetDeadlineSeconds() const { return m_deadlineSeconds; }
+
+	// continuation won't start before this job has finished; call before posting this job
+	void AddContinuation(Job* continuation);
+	bool IsComplete() const { return m_isComplete.load(std::memory_order_acquire); }
 
 protected:
+	void Suspend(); // only from Execute(); the job isn't complete, and runs Execute() again (in the lane of its type by then) after JobSystem::ResumeJob()
+
 	std::atomic<JobType> m_type = JobType::COMPUTATION;
+	JobPriority			 m_priority = JobPriority::NORMAL;
+	double				 m_deadlineSeconds = 0.0;		// GetCurrentTimeSeconds() to be done by, 0 for none; FRAME_CRITICAL jobs default to the frame deadline
+	bool				 m_deleteWhenComplete = false; // job system deletes the job instead of handing it back through Retrieve*()
+
+private:
+	static constexpr int NUM_INLINE_CONTINUATIONS = 2;
+
+	Job* GetContinuation(int index) const;
+
+	Job* m_nextJob = nullptr; // intrusive link while sitting in a lane's posted jobs stack, a completed jobs list or the next frame's jobs
+
+	std::atomic<int>  m_numPendingDependencies = 1; // unfinished predecessors, plus one until the job is posted
+	int				  m_numContinuations = 0;
+	Job*			  m_inlineContinuations[NUM_INLINE_CONTINUATIONS] = {};
+	std::vector<Job*> m_overflowContinuations; // only allocates past NUM_INLINE_CONTINUATIONS
+	std::atomic<bool> m_isComplete = false;
+	bool			  m_isSuspended = false;		  // set by Suspend(), seen by the thread running Execute() only
+	std::atomic<int>  m_numSuspensionHolds = 0;	  // the running thread and the resumer; whoever lets go last schedules the next run
+	bool			  m_hasFrameDeadline = false;	  // m_deadlineSeconds came from the frame; resuming takes the current frame's again
+	double			  m_enqueueSeconds = 0.0; // when the job became ready to run, only stamped while the JobProfiler is enabled
+};
+
+
+//-------------------------------------------------------------------------
+constexpr int CALLABLE_JOB_INLINE_SIZE = 96;
+
+// Runs any callable (usually a lambda) stored inside the job itself, so posting one costs no
+// allocation beyond the pooled job; captures must fit CALLABLE_JOB_INLINE_SIZE bytes
+//	g_theJobSystem->PostNewJob(new CallableJob([=]() { ... }, JobType::COMPUTATION, true));
+class CallableJob : public Job
+{
+public:
+	template <typename Callable>
+	explicit CallableJob(Callable&& callable, JobType type = JobType::COMPUTATION, bool deleteWhenComplete = false, JobPriority priority = JobPriority::NORMAL);
+	CallableJob(CallableJob const& copy) = delete;
+	virtual ~CallableJob() override;
+
+	virtual void Execute() override;
+
+private:
+	alignas(16) unsigned char m_callableStorage[CALLABLE_JOB_INLINE_SIZE];
+	void (*m_invokeCallable)(void* callable)  = nullptr;
+	void (*m_destroyCallable)(void* callable) = nullptr;
 };
 
+static_assert(sizeof(CallableJob) <= JOB_POOL_MAX_OBJECT_SIZE, "CallableJob no longer fits a JobPool slot");
+
 
 //-------------------------------------------------------------------------
 class JobWorkerThread
 {
 public:
-	JobWorkerThread(JobSystem* jobSystem, int threadId, JobType workingJobType);
+	JobWorkerThread(JobSystem* jobSystem, int threadId, JobType workingJobType, int indexInLane);
 	~JobWorkerThread();
 
+	void StartThread();
 	void ThreadMain();
 
 	JobSystem* m_jobSystem = nullptr;
 	int m_threadID = -1;
 	std::thread* m_thread = nullptr;
 
-	JobType m_workingJobType = JobType::COMPUTATION;
+	JobType					 m_workingJobType = JobType::COMPUTATION;
+	int						 m_indexInLane	  = -1;
+	int						 m_logicalProcessorIndex = -1; // in the JobSystem's CpuTopology, -1 when not pinned
+	int						 m_numaNode = 0;
+	std::vector<int>		 m_stealOrder; // indices in the lane of the workers to steal from, same NUMA node first
+	std::atomic<JobPriority> m_lowestPriority = JobPriority::BACKGROUND; // lowest priority this worker runs, higher for reserved workers
+
+	WorkStealingQueue m_localJobs[ NUM_JOB_PRIORITIES ]; // jobs posted by this worker; other workers in the same lane steal from here
+};
+
+
+//-------------------------------------------------------------------------
+// What a worker does when it finds no job to work on
+enum class JobWorkerIdlePolicy
+{
+	SLEEP_POLL,		// sleep 1us and check again; never blocks, but keeps every idle core busy
+	SPIN,			// yield and check again; lowest latency, burns a core per worker
+	SPIN_THEN_PARK	// yield for m_idleSpinCount checks, then block until a job is posted
 };
 
 
 struct JobSystemConfig
 {
 	int m_preferredNumberOfWorkerThreads = -1; // -1 means "one fewer than num of Cores"
+	int m_numDiskIOWorkers				 = 1;  // out of the preferred number, the rest run COMPUTATION jobs
+
+	// COMPUTATION workers that only run jobs of that priority or higher, FRAME_CRITICAL ones
+	// first; at least one worker is always left to run everything. Rebalance with SetNumReservedWorkers()
+	int	   m_numReservedWorkers[ NUM_JOB_PRIORITIES ] = {};
+	double m_frameCriticalDeadlineSeconds			 = 1.0 / 60.0; // after BeginFrame(), for FRAME_CRITICAL jobs posted without a deadline
+
+	JobWorkerIdlePolicy m_idlePolicy	 = JobWorkerIdlePolicy::SPIN_THEN_PARK;
+	int					m_idleSpinCount = 256; // failed checks before an idle worker parks
+
+	int m_numPreallocatedJobs = 4096; // JobPool slots reserved at Startup()
+
+	// pin every worker to its own logical processor, spread over NUMA nodes, COMPUTATION workers first
+	// (see CpuTopology::GetWorkerPlacementOrder()); stealing prefers workers on the same node either way
+	bool m_pinWorkerThreads = false;
+	bool m_avoidSmtSiblings = true; // when pinning, one worker per physical core; -1 workers then means one fewer than num of physical cores
+
+	bool m_enableInstrumentation = false; // per-job timing from the first frame on; otherwise off until the JobStats or JobTrace command
+	bool m_subscribeToCommands	 = true;  // JobStats, JobTrace and JobShutdownTest; off for extra JobSystems, whose Shutdown() would unsubscribe them
 };
 
 //-------------------------------------------------------------------------
@@ -71,32 +211,126 @@ public:
 	void Shutdown();
 
 
-	void PostNewJob(Job* job);							// called by Main Thread to add a job to the queue
-	Job* RetriveOneCompletedJob();						// called by Main Thread to get a job that has been completed
+	void PostNewJob(Job* job);							// called by Main Thread (or a worker) to add a job to the queue
+	void WaitFor(Job* job);								// helps run jobs of the same type until job is complete; job must not have been retrieved yet
+	bool TryRunOneJob(JobType type);					// runs one ready job of the given type on the calling thread, if there is one
+
+	// Suspended jobs (see Job::Suspend()); the Suspend* calls are made from the job's own Execute()
+	void ResumeJob(Job* job);								// from any thread, once what the job suspended for has happened
+	void SuspendForFileRead(Job* job, AsyncFileRead& read);	// reads read.m_filename into read.m_buffer without holding a thread, then resumes the job;
+																// during Shutdown() the read fails (read.m_succeeded false) and the job resumes right away
+	void SuspendUntilNextFrame(Job* job);					// resumes the job at the next BeginFrame()
+	int	 GetNumFileReadsInFlight() const;
+
+	// Completed jobs are handed back oldest first, one list per JobType. Each list must only be
+	// drained by one thread at a time (normally the main thread); nothing here allocates or hashes
+	int	 RetrieveCompletedJobs(JobType type, Job** out_completedJobs, int maxNumJobs); // returns number written
+	int	 RetrieveCompletedJobs(Job** out_completedJobs, int maxNumJobs);				 // all types
+	Job* RetriveOneCompletedJob();														 // called by Main Thread to get a job that has been completed
+
+	// convenience wrappers over RetrieveCompletedJobs(); these allocate the returned set
 	std::unordered_set<Job*> RetrieveAllCompleteJobs(); // called by Main Thread to get all jobs that have been completed
 	std::unordered_set<Job*> RetrieveAllCompletedJobsOfType(JobType type);
 
 
-	bool IsQuitting();
+	bool		   IsQuitting();
+	int			   GetNumWorkers(JobType type) const;
+	JobMemoryStats GetMemoryStats() const; // divide m_numHeapAllocations by m_numAllocations for the cost per job
+
+	void SetNumReservedWorkers(JobPriority priority, int numWorkers); // takes effect right away, also for parked workers
+	int	 GetNumReservedWorkers(JobPriority priority) const;
+	int	 GetNumMissedDeadlines() const; // since Startup()
+
+	JobProfiler* GetProfiler() const { return m_profiler; } // valid between Startup() and Shutdown()
+	CpuTopology const& GetCpuTopology() const { return m_cpuTopology; }
 
-	Job* GetNewJobToWorkOn(JobType jobType);
+	Job* GetNewJobToWorkOn(JobWorkerThread& worker);
+	void ExecuteJob(Job* job);
 	void MarkJobAsComplete(Job* job);
+	void WaitForWork(JobWorkerThread& worker, int numFailedAttempts); // called by a worker that found nothing to do
 
 	JobSystemConfig m_config;
 
 private:
 	std::vector<JobWorkerThread*> m_workers;
 
-	std::deque<Job*> m_unclaimedJobsQueue;		 // the jobs that have been posted by the main thread
-	std::mutex		 m_unclaimedJobsMutex;		// mutex that allows access to the jobs list
-
-	std::unordered_set<Job*> m_claimedJobsSet;	// List of jobs currently claimed by workers
-	std::mutex		  m_claimedJobsMutex;
-
-	std::unordered_set<Job*> m_completedJobsSet; // List of Jobs finished, ready yo be retrieved
-	std::mutex		  m_completedJobsMutex;
+	//-------------------------------------------------------------------------
+	// Every JobType has its own lane; workers only ever run and steal jobs from their own lane
+	struct JobLane
+	{
+		std::atomic<Job*>			  m_postedJobsHeads[ NUM_JOB_PRIORITIES ] = {}; // lock-free stacks of jobs posted from outside the lane
+		std::vector<JobWorkerThread*> m_workers;								   // fixed after Startup()
+
+		// parked workers nobody has woken yet, grouped by the lowest priority they run
+		std::atomic<int> m_numParkedWorkers[ NUM_JOB_PRIORITIES ] = {};
+		Semaphore		 m_wakeUpSignals[ NUM_JOB_PRIORITIES ];
+	};
+	JobLane m_lanes[ NUM_JOB_TYPES ];
+
+	CpuTopology m_cpuTopology;
+
+	//-------------------------------------------------------------------------
+	// Workers push finished jobs onto a lock-free stack; the draining thread takes the whole
+	// stack with one exchange and keeps it, reversed to oldest first, until it is handed out
+	struct CompletedJobList
+	{
+		alignas(64) std::atomic<Job*> m_completedJobsHead = nullptr; // newest first, pushed by any thread
+		Job*						  m_retrievedJobs = nullptr;	 // oldest first, touched by the draining thread only
+	};
+	CompletedJobList m_completedJobLists[ NUM_JOB_TYPES ];
 
 	std::atomic<bool> m_isQuitting = false;
 
-	void CreateWorkers(int numWorkerThreads, JobType workingJobType, int startingIndex);
-};
\ No newline at end of file
+	std::mutex m_reservationMutex;
+	int		   m_numReservedWorkers[ NUM_JOB_PRIORITIES ] = {};
+
+	std::atomic<double> m_frameDeadlineSeconds		  = 0.0;
+	std::atomic<int>	m_numMissedDeadlines		  = 0;
+	std::atomic<int>	m_numMissedDeadlinesThisFrame = 0;
+	std::atomic<double> m_worstMissThisFrameSeconds	  = 0.0;
+
+	JobProfiler* m_profiler = nullptr;
+	AsyncFileIO* m_fileIO = nullptr;
+
+	// Shutdown() closes reads before it deletes m_fileIO; a read asked for after that fails right away
+	std::atomic<bool> m_areFileReadsClosed	 = false;
+	std::atomic<int>  m_numFileReadsStarting = 0; // SuspendForFileRead() calls between checking the flag and StartRead() counting the read
+
+	std::atomic<Job*> m_nextFrameJobsHead = nullptr; // lock-free stack of jobs suspended until the next BeginFrame()
+
+	void CreateWorkers(int numWorkerThreads, JobType workingJobType);
+	void PlaceWorkers();
+	void BuildStealOrders();
+	void ApplyReservations();
+	void ReportMissedDeadline(double secondsLate);
+	void StampFrameDeadline(Job* job);
+	void ScheduleJob(Job* job);
+	void DeleteUnfinishedJob(Job* job);
+	void DeleteCompletedJobs(CompletedJobList& completedJobList);
+	void RetrieveAllCompletedJobsOfType(JobType type, std::unordered_set<Job*>& out_completedJobs);
+	Job* ClaimPostedJobs(JobWorkerThread& worker, JobPriority priority);
+	Job* ClaimPostedJobFromLane(JobLane& lane, JobPriority priority);
+	Job* StealJob(JobWorkerThread& thief, JobPriority priority);
+	Job* StealJobFromLane(JobLane& lane, int firstVictimIndex, JobPriority priority);
+	bool HasJobsInLane(JobLane const& lane, JobPriority lowestPriority) const;
+	void ParkWorker(JobWorkerThread& worker);
+	void WakeParkedWorker(JobLane& lane, JobPriority priority);
+	static bool TryDecrementParkedCount(std::atomic<int>& numParked); // false if it was already 0
+};
+
+//-------------------------------------------------------------------------
+template <typename Callable>
+inline CallableJob::CallableJob(Callable&& callable, JobType type, bool deleteWhenComplete, JobPriority priority)
+{
+	typedef typename std::decay<Callable>::type CallableType;
+	static_assert(sizeof(CallableType) <= CALLABLE_JOB_INLINE_SIZE, "CallableJob: captures too big to store inline");
+	static_assert(alignof(CallableType) <= 16, "CallableJob: callable is over-aligned");
+
+	new (m_callableStorage) CallableType(std::forward<Callable>(callable));
+	m_invokeCallable  = [](void* storedCallable) { (*static_cast<CallableType*>(storedCallable))(); };
+	m_destroyCallable = [](void* storedCallable) { static_cast<CallableType*>(storedCallable)->~CallableType(); };
+
+	m_type				 = type;
+	m_priority			 = priority;
+	m_deleteWhenComplete = deleteWhenComplete;
+}
@@ -0,0 +1,228 @@
+#include "Engine/Core/ParallelFor.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/JobPool.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <atomic>
+#include <thread>
+
+
+//-------------------------------------------------------------------------
+// Set while a thread runs chunks of a loop that was split over several participants.
+// A loop nested in one of those chunks runs inline: the outer loop already keeps every
+// participant busy, so splitting the inner one too would only add job overhead
+static thread_local int s_parallelForNestingDepth = 0;
+
+
+//-------------------------------------------------------------------------
+// State of one loop, shared by the calling thread and its helper jobs.
+// Ref counted because a helper job may only get to run after the loop has already been
+// finished by everyone else; such a late helper finds no chunk left and just lets go of it.
+// Comes from the JobPool like the helper jobs, so a loop doesn't touch the global heap.
+struct ParallelForRange
+{
+	std::atomic<int> m_nextIndex			= 0;
+	int				 m_end					= 0;
+	int				 m_minChunkSize			= 1;
+	int				 m_numParticipants		= 1;
+	std::atomic<int> m_numItemsRemaining	= 0; // items claimed but not yet run, plus unclaimed ones
+	std::atomic<int> m_nextParticipantIndex = 1; // 0 is the calling thread
+	std::atomic<int> m_refCount				= 1;
+
+	ParallelForChunkFunction m_chunkFunction = nullptr;
+	void const*				 m_context		 = nullptr;
+
+	static void* operator new( size_t numBytes ) { return JobPool::GetInstance().Allocate( numBytes ); }
+	static void	 operator delete( void* memory, size_t numBytes ) { JobPool::GetInstance().Free( memory, numBytes ); }
+
+	bool ClaimChunk( int& out_chunkBegin, int& out_chunkEnd );
+	void RunChunks( int participantIndex );
+	void AddRef() { m_refCount.fetch_add( 1, std::memory_order_relaxed ); }
+	void Release();
+};
+
+
+//-------------------------------------------------------------------------
+bool ParallelForRange::ClaimChunk( int& out_chunkBegin, int& out_chunkEnd )
+{
+	int chunkBegin = m_nextIndex.load( std::memory_order_relaxed );
+	for ( ;; )
+	{
+		int numRemaining = m_end - chunkBegin;
+		if ( numRemaining <= 0 )
+		{
+			return false;
+		}
+
+		// big chunks while there is plenty left, shrinking towards m_minChunkSize near the end
+		int chunkSize = numRemaining / ( 2 * m_numParticipants );
+		if ( chunkSize < m_minChunkSize )
+		{
+			chunkSize = m_minChunkSize;
+		}
+		if ( chunkSize > numRemaining )
+		{
+			chunkSize = numRemaining;
+		}
+
+		if ( m_nextIndex.compare_exchange_weak( chunkBegin, chunkBegin + chunkSize, std::memory_order_relaxed ) )
+		{
+			out_chunkBegin = chunkBegin;
+			out_chunkEnd   = chunkBegin + chunkSize;
+			return true;
+		}
+	}
+}
+
+
+//-------------------------------------------------------------------------
+void ParallelForRange::RunChunks( int participantIndex )
+{
+	int chunkBegin = 0;
+	int chunkEnd   = 0;
+	++s_parallelForNestingDepth;
+	while ( ClaimChunk( chunkBegin, chunkEnd ) )
+	{
+		m_chunkFunction( m_context, chunkBegin, chunkEnd, participantIndex );
+
+		// release so the calling thread sees everything this chunk wrote once the count hits 0
+		m_numItemsRemaining.fetch_sub( chunkEnd - chunkBegin, std::memory_order_release );
+	}
+	--s_parallelForNestingDepth;
+}
+
+
+//-------------------------------------------------------------------------
+void ParallelForRange::Release()
+{
+	if ( m_refCount.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+	{
+		delete this;
+	}
+}
+
+
+//-------------------------------------------------------------------------
+class ParallelForJob : public Job
+{
+public:
+	explicit ParallelForJob( ParallelForRange* range )
+		: m_range( range )
+	{
+		m_type				 = JobType::COMPUTATION;
+		m_deleteWhenComplete = true;
+	}
+
+	// releasing here rather than in Execute() also covers helpers dropped unrun at shutdown
+	virtual ~ParallelForJob() override
+	{
+		m_range->Release();
+	}
+
+	virtual void Execute() override
+	{
+		int participantIndex = m_range->m_nextParticipantIndex.fetch_add( 1, std::memory_order_relaxed );
+		m_range->RunChunks( participantIndex );
+	}
+
+	virtual char const* GetDebugName() const override { return "ParallelFor"; }
+
+private:
+	ParallelForRange* m_range = nullptr;
+};
+
+
+//-------------------------------------------------------------------------
+int GetMaxParallelForParticipants()
+{
+	if ( g_theJobSystem == nullptr )
+	{
+		return 1;
+	}
+
+	return g_theJobSystem->GetNumWorkers( JobType::COMPUTATION ) + 1;
+}
+
+
+//-------------------------------------------------------------------------
+void RunParallelFor( int begin, int end, int grainSize, int numParticipants, ParallelForChunkFunction chunkFunction, void const* context )
+{
+	if ( begin >= end )
+	{
+		return;
+	}
+
+	// held to the calling thread, loops nested in this one stay on it as well
+	if ( s_parallelForNestingDepth > 0 || numParticipants <= 1 )
+	{
+		++s_parallelForNestingDepth;
+		chunkFunction( context, begin, end, 0 );
+		--s_parallelForNestingDepth;
+		return;
+	}
+
+	if ( grainSize <= 0 )
+	{
+		// time a few items on this thread to find how many make a worthwhile chunk
+		int	   probeEnd		= end - begin > PARALLEL_FOR_NUM_PROBE_ITEMS ? begin + PARALLEL_FOR_NUM_PROBE_ITEMS : end;
+		double probeStart	= GetCurrentTimeSeconds();
+		chunkFunction( context, begin, probeEnd, 0 );
+		double probeSeconds = GetCurrentTimeSeconds() - probeStart;
+
+		double secondsPerItem = probeSeconds / ( double ) ( probeEnd - begin );
+		double itemsPerChunk  = secondsPerItem > 0.0 ? PARALLEL_FOR_TARGET_CHUNK_SECONDS / secondsPerItem : ( double ) ( end - begin );
+
+		begin	  = probeEnd;
+		grainSize = itemsPerChunk < ( double ) ( end - begin ) ? ( int ) itemsPerChunk : end - begin;
+		if ( grainSize < 1 )
+		{
+			grainSize = 1;
+		}
+	}
+
+	int numItems = end - begin;
+	if ( numItems <= grainSize )
+	{
+		if ( numItems > 0 )
+		{
+			chunkFunction( context, begin, end, 0 );
+		}
+		return;
+	}
+
+	ParallelForRange* range	   = new ParallelForRange();
+	range->m_nextIndex		   = begin;
+	range->m_end			   = end;
+	range->m_minChunkSize	   = grainSize;
+	range->m_numParticipants   = numParticipants;
+	range->m_numItemsRemaining = numItems;
+	range->m_chunkFunction	   = chunkFunction;
+	range->m_context		   = context;
+
+	// no point waking more helpers than there are chunks for them
+	int numHelpers = numItems / grainSize - 1;
+	if ( numHelpers > numParticipants - 1 )
+	{
+		numHelpers = numParticipants - 1;
+	}
+
+	for ( int helperIndex = 0; helperIndex < numHelpers; helperIndex++ )
+	{
+		range->AddRef();
+		g_theJobSystem->PostNewJob( new ParallelForJob( range ) );
+	}
+
+	range->RunChunks( 0 );
+
+	// out of chunks to claim; help with other computation jobs until the helpers finish theirs
+	while ( range->m_numItemsRemaining.load( std::memory_order_acquire ) > 0 )
+	{
+		if ( !g_theJobSystem->TryRunOneJob( JobType::COMPUTATION ) )
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	range->Release();
+}
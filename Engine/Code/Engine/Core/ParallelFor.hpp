@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vector>
+
+
+//-------------------------------------------------------------------------
+// Data-parallel loops on top of g_theJobSystem's COMPUTATION workers.
+// The range is handed out in chunks that shrink as it drains ("guided" scheduling), so items
+// of uneven cost still balance out, and the calling thread works on the range as well.
+// Falls back to a plain loop when there is no job system, no computation workers, the
+// range is too cheap to be worth splitting, or the loop is nested in another loop that was split.
+//
+// grainSize is the smallest chunk ever handed out. Pass 0 to have it picked from the measured
+// cost of the first few items, aiming for chunks of roughly PARALLEL_FOR_TARGET_CHUNK_SECONDS.
+//
+//	ParallelFor( 0, numVerts, 0, [ & ]( int index ) { ... } );
+//	float sum = ParallelReduce( 0, count, 0, 0.f,
+//								[ & ]( int index, float& accumulator ) { accumulator += values[ index ]; },
+//								[]( float a, float b ) { return a + b; } );
+//
+// ParallelReduce combines per-thread partial results in a fixed order, but how items are
+// split between threads is not fixed, so floating point results may differ in the last bits.
+template <typename Function>
+void ParallelFor( int begin, int end, int grainSize, Function const& function ); // function( int index )
+
+template <typename T, typename Function, typename CombineFunction>
+T ParallelReduce( int begin, int end, int grainSize, T const& identity, Function const& function, CombineFunction const& combine ); // function( int index, T& accumulator ), combine( T const& a, T const& b ) -> T
+
+
+//-------------------------------------------------------------------------
+constexpr double PARALLEL_FOR_TARGET_CHUNK_SECONDS = 0.00002; // 20us, well above the cost of claiming a chunk
+constexpr int	 PARALLEL_FOR_NUM_PROBE_ITEMS	   = 8;		  // items timed on the calling thread when grainSize is 0
+
+
+//-------------------------------------------------------------------------
+// Type-erased core shared by the templates; participantIndex is unique per thread working on
+// one loop and smaller than the numParticipants passed in. A loop with one participant runs
+// on the calling thread only, loops nested in it included
+typedef void ( *ParallelForChunkFunction )( void const* context, int chunkBegin, int chunkEnd, int participantIndex );
+
+int	 GetMaxParallelForParticipants();
+void RunParallelFor( int begin, int end, int grainSize, int numParticipants, ParallelForChunkFunction chunkFunction, void const* context );
+
+
+//-------------------------------------------------------------------------
+template <typename Function>
+inline void ParallelFor( int begin, int end, int grainSize, Function const& function )
+{
+	ParallelForChunkFunction runChunk = []( void const* context, int chunkBegin, int chunkEnd, int participantIndex )
+	{
+		( void ) participantIndex;
+
+		Function const& loopBody = *static_cast<Function const*>( context );
+		for ( int index = chunkBegin; index < chunkEnd; index++ )
+		{
+			loopBody( index );
+		}
+	};
+
+	RunParallelFor( begin, end, grainSize, GetMaxParallelForParticipants(), runChunk, &function );
+}
+
+
+//-------------------------------------------------------------------------
+template <typename T, typename Function, typename CombineFunction>
+inline T ParallelReduce( int begin, int end, int grainSize, T const& identity, Function const& function, CombineFunction const& combine )
+{
+	struct ReduceContext
+	{
+		Function const*		   m_function		= nullptr;
+		CombineFunction const* m_combine		= nullptr;
+		T const*			   m_identity		= nullptr;
+		T*					   m_partialResults = nullptr; // one per participant, only ever touched by that participant
+	};
+
+	int			   numParticipants = GetMaxParallelForParticipants();
+	std::vector<T> partialResults( numParticipants, identity );
+
+	ReduceContext reduceContext;
+	reduceContext.m_function	   = &function;
+	reduceContext.m_combine		   = &combine;
+	reduceContext.m_identity	   = &identity;
+	reduceContext.m_partialResults = partialResults.data();
+
+	ParallelForChunkFunction runChunk = []( void const* context, int chunkBegin, int chunkEnd, int participantIndex )
+	{
+		ReduceContext const& reduce = *static_cast<ReduceContext const*>( context );
+
+		// accumulate locally, then fold into our own slot once per chunk
+		T chunkResult = *reduce.m_identity;
+		for ( int index = chunkBegin; index < chunkEnd; index++ )
+		{
+			( *reduce.m_function )( index, chunkResult );
+		}
+
+		T& partialResult = reduce.m_partialResults[ participantIndex ];
+		partialResult	 = ( *reduce.m_combine )( partialResult, chunkResult );
+	};
+
+	RunParallelFor( begin, end, grainSize, numParticipants, runChunk, &reduceContext );
+
+	T result = identity;
+	for ( int participantIndex = 0; participantIndex < numParticipants; participantIndex++ )
+	{
+		result = combine( result, partialResults[ participantIndex ] );
+	}
+
+	return result;
+}
@@ -0,0 +1,62 @@
+#include "Engine/Core/Semaphore.hpp"
+
+
+//-------------------------------------------------------------------------
+Semaphore::Semaphore( int initialCount )
+	: m_count( initialCount )
+{
+}
+
+
+//-------------------------------------------------------------------------
+void Semaphore::Acquire()
+{
+	int oldCount = m_count.fetch_sub( 1, std::memory_order_acquire );
+	if ( oldCount > 0 )
+	{
+		return;
+	}
+
+	// nothing available, block until a Release() hands us a wakeup
+	std::unique_lock<std::mutex> lock( m_mutex );
+	m_condition.wait( lock, [ this ]() { return m_numPendingWakeups > 0; } );
+	m_numPendingWakeups--;
+}
+
+
+//-------------------------------------------------------------------------
+bool Semaphore::TryAcquire()
+{
+	int oldCount = m_count.load( std::memory_order_relaxed );
+	while ( oldCount > 0 )
+	{
+		if ( m_count.compare_exchange_weak( oldCount, oldCount - 1, std::memory_order_acquire, std::memory_order_relaxed ) )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//-------------------------------------------------------------------------
+void Semaphore::Release( int count )
+{
+	int oldCount   = m_count.fetch_add( count, std::memory_order_release );
+	int numBlocked = oldCount < 0 ? -oldCount : 0;
+	int numToWake  = numBlocked < count ? numBlocked : count;
+	if ( numToWake <= 0 )
+	{
+		return;
+	}
+
+	m_mutex.lock();
+	m_numPendingWakeups += numToWake;
+	m_mutex.unlock();
+
+	for ( int index = 0; index < numToWake; index++ )
+	{
+		m_condition.notify_one();
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+
+//-------------------------------------------------------------------------
+// Counting semaphore with an atomic fast path; only touches the mutex and condition
+// variable when a thread actually has to block or be woken up.
+// (std::counting_semaphore is C++20, the engine builds as C++17)
+class Semaphore
+{
+public:
+	explicit Semaphore( int initialCount = 0 );
+
+	Semaphore( Semaphore const& copy ) = delete;
+	Semaphore& operator=( Semaphore const& copyFrom ) = delete;
+
+	void Acquire();					// blocks until a count is available
+	bool TryAcquire();				// never blocks
+	void Release( int count = 1 );	// wakes up to count blocked threads
+
+private:
+	std::atomic<int> m_count = 0; // negative means that many threads are blocked
+
+	std::mutex				m_mutex;
+	std::condition_variable m_condition;
+	int						m_numPendingWakeups = 0;
+};
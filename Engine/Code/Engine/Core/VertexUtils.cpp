@@ -4,22 +4,89 @@
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/Mat44.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ParallelFor.hpp"
+
+#include <algorithm>
 
 
 constexpr float MARGIN_OF_ERROR = 0.000001f;
 
+// below these counts a mesh is processed on the calling thread
+constexpr int VERTS_PER_PARALLEL_CHUNK	   = 4096;
+constexpr int TRIANGLES_PER_PARALLEL_CHUNK = 1024;
 
-void TransformVertexArrayXY3D( int numVerts, Vertex_PCU* verts, float uniformScale,
-	float rotationDegreeAboutZ, Vec2 const& translationXY )
+
+//----------------------------------------------------------------------------------------
+// Calls transformChunk( firstVertIndex, numChunkVerts ) for each chunk of a mesh, spread across the job system
+template <typename ChunkFunc>
+static void ForEachVertChunk( int numVerts, ChunkFunc const& transformChunk )
+{
+	int numChunks = ( numVerts + VERTS_PER_PARALLEL_CHUNK - 1 ) / VERTS_PER_PARALLEL_CHUNK;
+	ParallelFor( 0, numChunks, 1, [ & ]( int chunkIndex )
+		{
+			int firstVertIndex = chunkIndex * VERTS_PER_PARALLEL_CHUNK;
+			int numChunkVerts  = numVerts - firstVertIndex < VERTS_PER_PARALLEL_CHUNK ? numVerts - firstVertIndex : VERTS_PER_PARALLEL_CHUNK;
+			transformChunk( firstVertIndex, numChunkVerts );
+		} );
+}
+
+
+//----------------------------------------------------------------------------------------
+// Copies the rest of the vertex when writing to a separate array, then transforms the positions over the copy
+template <typename VertexType>
+static void TransformVertexPositions3D( VertexType const* verts, VertexType* out_verts, int numVerts, Mat44 const& transform )
+{
+	if ( out_verts != verts )
+	{
+		std::copy( verts, verts + numVerts, out_verts );
+	}
+	transform.TransformPositions3D( &verts[ 0 ].m_position, &out_verts[ 0 ].m_position, numVerts, sizeof( VertexType ), sizeof( VertexType ) );
+}
+
+
+//----------------------------------------------------------------------------------------
+// Renormalized, so uniform scale in the transform doesn't reach the lighting; a non uniformly
+// scaled transform would need its inverse transpose for the normals
+static void TransformTangentBasesInPlace( Vertex_PCUTBN* verts, int numVerts, Mat44 const& transform )
 {
-	for ( int index = 0; index < numVerts; ++index )
+	float const* values = transform.GetAsFloatArray();
+	__m128		 iBasis = _mm_loadu_ps( values + Mat44::Ix );
+	__m128		 jBasis = _mm_loadu_ps( values + Mat44::Jx );
+	__m128		 kBasis = _mm_loadu_ps( values + Mat44::Kx );
+
+	for ( int index = 0; index < numVerts; index++ )
 	{
-		Vec3& vertex = verts[ index ].m_position;
-		TransformPositionXY3D( vertex, uniformScale, rotationDegreeAboutZ, translationXY );
+		Vec3* basisVectors[ 3 ] = { &verts[ index ].m_tangent, &verts[ index ].m_bitangent, &verts[ index ].m_normal };
+		for ( Vec3* basisVector : basisVectors )
+		{
+			__m128 result = _mm_add_ps( _mm_mul_ps( iBasis, _mm_set1_ps( basisVector->x ) ), _mm_mul_ps( jBasis, _mm_set1_ps( basisVector->y ) ) );
+			result		  = _mm_add_ps( result, _mm_mul_ps( kBasis, _mm_set1_ps( basisVector->z ) ) );
+			result		  = _mm_and_ps( result, _mm_castsi128_ps( _mm_set_epi32( 0, -1, -1, -1 ) ) );
+			SIMDStoreVec3( *basisVector, SIMDNormalize3( result ) );
+		}
 	}
 }
 
 
+//----------------------------------------------------------------------------------------
+void TransformVertexArrayXY3D( int numVerts, Vertex_PCU* verts, float uniformScale,
+	float rotationDegreeAboutZ, Vec2 const& translationXY )
+{
+	TransformVertexArrayXY3D( numVerts, verts, verts, uniformScale, rotationDegreeAboutZ, translationXY );
+}
+
+
+//----------------------------------------------------------------------------------------
+// The rotation's sine and cosine are taken once and go into a matrix shared by every vertex
+void TransformVertexArrayXY3D( int numVerts, Vertex_PCU const* verts, Vertex_PCU* out_verts, float uniformScale,
+	float rotationDegreeAboutZ, Vec2 const& translationXY )
+{
+	Vec2  iBasis = Vec2( CosDegrees( rotationDegreeAboutZ ), SinDegrees( rotationDegreeAboutZ ) ) * uniformScale;
+	Mat44 transform( iBasis, iBasis.GetRotated90Degrees(), translationXY );
+	TransformVertexArray3D( numVerts, verts, out_verts, transform );
+}
+
+
 //----------------------------------------------------------------------------------------
 
 void AddVertsForCapsule2D( std::vector<Vertex_PCU>& verts, Vec2 const& boneStart, Vec2 const& boneEnd, float radius, Rgba8 const& color )
@@ -588,11 +655,35 @@ void AddVertsForWireframeAABB2D( std::vector<Vertex_PCU>& verts, AABB2 const& bo
 
 void TransformVertexArray3D( std::vector<Vertex_PCU>& verts, Mat44 const& transform )
 {
-	for ( int vertIndex = 0; vertIndex < verts.size(); vertIndex++ )
-	{
-		Vertex_PCU& vertex = verts[ vertIndex ];
-		vertex.m_position  = transform.TransformPosition3D( vertex.m_position );
-	}
+	TransformVertexArray3D( ( int ) verts.size(), verts.data(), verts.data(), transform );
+}
+
+
+void TransformVertexArray3D( int numVerts, Vertex_PCU const* verts, Vertex_PCU* out_verts, Mat44 const& transform )
+{
+	ForEachVertChunk( numVerts, [ & ]( int firstVertIndex, int numChunkVerts )
+		{
+			TransformVertexPositions3D( verts + firstVertIndex, out_verts + firstVertIndex, numChunkVerts, transform );
+		} );
+}
+
+
+void TransformVertexArray3D( std::vector<Vertex_PCUTBN>& verts, Mat44 const& transform, bool transformTangentBasis )
+{
+	TransformVertexArray3D( ( int ) verts.size(), verts.data(), verts.data(), transform, transformTangentBasis );
+}
+
+
+void TransformVertexArray3D( int numVerts, Vertex_PCUTBN const* verts, Vertex_PCUTBN* out_verts, Mat44 const& transform, bool transformTangentBasis )
+{
+	ForEachVertChunk( numVerts, [ & ]( int firstVertIndex, int numChunkVerts )
+		{
+			TransformVertexPositions3D( verts + firstVertIndex, out_verts + firstVertIndex, numChunkVerts, transform );
+			if ( transformTangentBasis )
+			{
+				TransformTangentBasesInPlace( out_verts + firstVertIndex, numChunkVerts, transform );
+			}
+		} );
 }
 
 AABB2 GetVertexBounds2D( std::vector<Vertex_PCU> const& verts )
@@ -1268,61 +1359,73 @@ void AddVertsForLineUsingLineList3D( std::vector<Vertex_PCU>& verts, Vec3 const&
 void CalculateTangetSpaceBasisVectorForVertex_PCUTBN( std::vector<Vertex_PCUTBN>& outCpuVerts, std::vector<unsigned int> const& indexes )
 {
 	// 1. calculate tangents and bi-tangents for each triangle
-	for ( int index = 0; index < indexes.size(); index += 3 )
-	{
-		// get indexes
-		unsigned int index0 = indexes[ index ];
-		unsigned int index1 = indexes[ index + 1 ];
-		unsigned int index2 = indexes[ index + 2 ];
-
-		// get points
-		Vec3 const& point0 = outCpuVerts[ index0 ].m_position;
-		Vec3 const& point1 = outCpuVerts[ index1 ].m_position;
-		Vec3 const& point2 = outCpuVerts[ index2 ].m_position;
-
-		// get uvs
-		Vec2 const& uv0 = outCpuVerts[ index0 ].m_uvTexCoords;
-		Vec2 const& uv1 = outCpuVerts[ index1 ].m_uvTexCoords;
-		Vec2 const& uv2 = outCpuVerts[ index2 ].m_uvTexCoords;
-
-		// get edges
-		Vec3  edge1 = point1 - point0;
-		Vec3  edge2 = point2 - point0;
-		float x1	= uv1.x - uv0.x;
-		float x2	= uv2.x - uv0.x;
-		float y1	= uv1.y - uv0.y;
-		float y2	= uv2.y - uv0.y;
-
-		// calculate tangent and bi-tangent
-		float r			= 1.f / ( x1 * y2 - x2 * y1 );
-		Vec3  tangent	= ( edge1 * y2 - edge2 * y1 ) * r;
-		Vec3  biTangent = ( edge2 * x1 - edge1 * x2 ) * r;
-
-		// add to the vertex
-		outCpuVerts[ index0 ].m_tangent += tangent;
-		outCpuVerts[ index1 ].m_tangent += tangent;
-		outCpuVerts[ index2 ].m_tangent += tangent;
-		outCpuVerts[ index0 ].m_bitangent += biTangent;
-		outCpuVerts[ index1 ].m_bitangent += biTangent;
-		outCpuVerts[ index2 ].m_bitangent += biTangent;
-	}
+	int				  numTriangles = ( int ) indexes.size() / 3;
+	std::vector<Vec3> triangleTangents( numTriangles );
+	std::vector<Vec3> triangleBiTangents( numTriangles );
 
-	// 2. orthonormalize the tangent and bi-tangent and calculate handedness
-	for ( int index = 0; index < outCpuVerts.size(); index++ )
+	ParallelFor( 0, numTriangles, TRIANGLES_PER_PARALLEL_CHUNK, [ & ]( int triangleIndex )
+		{
+			// get indexes
+			int			 index	= triangleIndex * 3;
+			unsigned int index0 = indexes[ index ];
+			unsigned int index1 = indexes[ index + 1 ];
+			unsigned int index2 = indexes[ index + 2 ];
+
+			// get points
+			Vec3 const& point0 = outCpuVerts[ index0 ].m_position;
+			Vec3 const& point1 = outCpuVerts[ index1 ].m_position;
+			Vec3 const& point2 = outCpuVerts[ index2 ].m_position;
+
+			// get uvs
+			Vec2 const& uv0 = outCpuVerts[ index0 ].m_uvTexCoords;
+			Vec2 const& uv1 = outCpuVerts[ index1 ].m_uvTexCoords;
+			Vec2 const& uv2 = outCpuVerts[ index2 ].m_uvTexCoords;
+
+			// get edges
+			Vec3  edge1 = point1 - point0;
+			Vec3  edge2 = point2 - point0;
+			float x1	= uv1.x - uv0.x;
+			float x2	= uv2.x - uv0.x;
+			float y1	= uv1.y - uv0.y;
+			float y2	= uv2.y - uv0.y;
+
+			// calculate tangent and bi-tangent
+			float r								 = 1.f / ( x1 * y2 - x2 * y1 );
+			triangleTangents[ triangleIndex ]	 = ( edge1 * y2 - edge2 * y1 ) * r;
+			triangleBiTangents[ triangleIndex ] = ( edge2 * x1 - edge1 * x2 ) * r;
+		} );
+
+	// 2. add to the vertices; triangles share vertices, so this stays serial and in index order
+	for ( int triangleIndex = 0; triangleIndex < numTriangles; triangleIndex++ )
 	{
-		Vertex_PCUTBN& vertex	 = outCpuVerts[ index ];
-		Vec3&		   tangent	 = vertex.m_tangent;
-		Vec3&		   biTangent = vertex.m_bitangent;
-		Vec3&		   normal	 = vertex.m_normal;
-
-		// Gram-Schmidt orthogonalize
-		tangent = tangent - ( DotProduct3D( normal, tangent ) * normal );
-		tangent.Normalize();
-
-		// calculate handedness
-		float handedness = ( DotProduct3D( CrossProduct3D( normal, tangent ), biTangent ) < 0.f ) ? -1.f : 1.f;
-		biTangent		 = CrossProduct3D( normal, tangent ) * handedness;
+		int			index	  = triangleIndex * 3;
+		Vec3 const& tangent	  = triangleTangents[ triangleIndex ];
+		Vec3 const& biTangent = triangleBiTangents[ triangleIndex ];
+
+		outCpuVerts[ indexes[ index ] ].m_tangent += tangent;
+		outCpuVerts[ indexes[ index + 1 ] ].m_tangent += tangent;
+		outCpuVerts[ indexes[ index + 2 ] ].m_tangent += tangent;
+		outCpuVerts[ indexes[ index ] ].m_bitangent += biTangent;
+		outCpuVerts[ indexes[ index + 1 ] ].m_bitangent += biTangent;
+		outCpuVerts[ indexes[ index + 2 ] ].m_bitangent += biTangent;
 	}
+
+	// 3. orthonormalize the tangent and bi-tangent and calculate handedness
+	ParallelFor( 0, ( int ) outCpuVerts.size(), VERTS_PER_PARALLEL_CHUNK, [ & ]( int index )
+		{
+			Vertex_PCUTBN& vertex	 = outCpuVerts[ index ];
+			Vec3&		   tangent	 = vertex.m_tangent;
+			Vec3&		   biTangent = vertex.m_bitangent;
+			Vec3&		   normal	 = vertex.m_normal;
+
+			// Gram-Schmidt orthogonalize
+			tangent = tangent - ( DotProduct3D( normal, tangent ) * normal );
+			tangent.Normalize();
+
+			// calculate handedness
+			float handedness = ( DotProduct3D( CrossProduct3D( normal, tangent ), biTangent ) < 0.f ) ? -1.f : 1.f;
+			biTangent		 = CrossProduct3D( normal, tangent ) * handedness;
+		} );
 }
 
 
@@ -22,6 +22,7 @@ class Vertex_PCUTBN;
 //----------------------------------------------------------------------------------------------------------
 // 2d transformation
 void TransformVertexArrayXY3D(int numVerts, Vertex_PCU* verts, float uniformScale, float rotationDegreeAboutZ, Vec2 const& translationXY);
+void TransformVertexArrayXY3D(int numVerts, Vertex_PCU const* verts, Vertex_PCU* out_verts, float uniformScale, float rotationDegreeAboutZ, Vec2 const& translationXY);
 
 
 //----------------------------------------------------------------------------------------------------------
@@ -54,8 +55,11 @@ void AddVertsForWireframeConvexPolly2DIndexed( std::vector<Vertex_PCU>& verts, s
 
 
 //----------------------------------------------------------------------------------------------------------
-// 3d transformation
+// 3d transformation; out_verts may be verts, and meshes over a few thousand verts are split across the job system
 void TransformVertexArray3D(std::vector<Vertex_PCU>& verts, Mat44 const& transform);
+void TransformVertexArray3D(int numVerts, Vertex_PCU const* verts, Vertex_PCU* out_verts, Mat44 const& transform);
+void TransformVertexArray3D(std::vector<Vertex_PCUTBN>& verts, Mat44 const& transform, bool transformTangentBasis = true);
+void TransformVertexArray3D(int numVerts, Vertex_PCUTBN const* verts, Vertex_PCUTBN* out_verts, Mat44 const& transform, bool transformTangentBasis = true);
 
 
 //----------------------------------------------------------------------------------------------------------
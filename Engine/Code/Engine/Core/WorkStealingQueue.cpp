@@ -0,0 +1,149 @@
+#include "Engine/Core/WorkStealingQueue.hpp"
+
+
+//-------------------------------------------------------------------------
+WorkStealingQueue::JobRingBuffer::JobRingBuffer( long long capacity )
+	: m_capacity( capacity ), m_mask( capacity - 1 )
+{
+	m_jobs = new std::atomic<Job*>[ capacity ];
+}
+
+
+//-------------------------------------------------------------------------
+WorkStealingQueue::JobRingBuffer::~JobRingBuffer()
+{
+	delete[] m_jobs;
+}
+
+
+//-------------------------------------------------------------------------
+WorkStealingQueue::WorkStealingQueue( int initialCapacity )
+{
+	// capacity must be a power of two so indices can be masked
+	long long capacity = 1;
+	while ( capacity < initialCapacity )
+	{
+		capacity <<= 1;
+	}
+
+	m_buffer.store( new JobRingBuffer( capacity ), std::memory_order_relaxed );
+}
+
+
+//-------------------------------------------------------------------------
+WorkStealingQueue::~WorkStealingQueue()
+{
+	delete m_buffer.load( std::memory_order_relaxed );
+
+	for ( int index = 0; index < m_retiredBuffers.size(); index++ )
+	{
+		delete m_retiredBuffers[ index ];
+	}
+	m_retiredBuffers.clear();
+}
+
+
+//-------------------------------------------------------------------------
+void WorkStealingQueue::Push( Job* job )
+{
+	long long	   bottom = m_bottom.load( std::memory_order_relaxed );
+	long long	   top	  = m_top.load( std::memory_order_acquire );
+	JobRingBuffer* buffer = m_buffer.load( std::memory_order_relaxed );
+
+	if ( bottom - top > buffer->m_capacity - 1 )
+	{
+		buffer = Grow( buffer, bottom, top );
+	}
+
+	// release so a thief that sees the new bottom also sees the job it points at
+	buffer->Put( bottom, job );
+	m_bottom.store( bottom + 1, std::memory_order_release );
+}
+
+
+//-------------------------------------------------------------------------
+Job* WorkStealingQueue::Pop()
+{
+	long long	   bottom = m_bottom.load( std::memory_order_relaxed ) - 1;
+	JobRingBuffer* buffer = m_buffer.load( std::memory_order_relaxed );
+	m_bottom.store( bottom, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	long long top = m_top.load( std::memory_order_relaxed );
+
+	if ( top > bottom )
+	{
+		// queue was already empty
+		m_bottom.store( bottom + 1, std::memory_order_relaxed );
+		return nullptr;
+	}
+
+	Job* job = buffer->Get( bottom );
+	if ( top == bottom )
+	{
+		// last job, race against thieves for it
+		if ( !m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+		{
+			job = nullptr;
+		}
+		m_bottom.store( bottom + 1, std::memory_order_relaxed );
+	}
+
+	return job;
+}
+
+
+//-------------------------------------------------------------------------
+Job* WorkStealingQueue::Steal()
+{
+	long long top = m_top.load( std::memory_order_acquire );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	long long bottom = m_bottom.load( std::memory_order_acquire );
+
+	if ( top >= bottom )
+	{
+		return nullptr;
+	}
+
+	JobRingBuffer* buffer = m_buffer.load( std::memory_order_acquire );
+	Job*		   job	  = buffer->Get( top );
+	if ( !m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+	{
+		// another thief or the owner got it first
+		return nullptr;
+	}
+
+	return job;
+}
+
+
+//-------------------------------------------------------------------------
+bool WorkStealingQueue::IsEmpty() const
+{
+	return GetApproximateSize() <= 0;
+}
+
+
+//-------------------------------------------------------------------------
+int WorkStealingQueue::GetApproximateSize() const
+{
+	long long bottom = m_bottom.load( std::memory_order_relaxed );
+	long long top	 = m_top.load( std::memory_order_relaxed );
+	long long size	 = bottom - top;
+	return size > 0 ? ( int ) size : 0;
+}
+
+
+//-------------------------------------------------------------------------
+WorkStealingQueue::JobRingBuffer* WorkStealingQueue::Grow( JobRingBuffer* oldBuffer, long long bottom, long long top )
+{
+	JobRingBuffer* newBuffer = new JobRingBuffer( oldBuffer->m_capacity * 2 );
+	for ( long long index = top; index < bottom; index++ )
+	{
+		newBuffer->Put( index, oldBuffer->Get( index ) );
+	}
+
+	m_retiredBuffers.push_back( oldBuffer );
+	m_buffer.store( newBuffer, std::memory_order_release );
+
+	return newBuffer;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+
+class Job;
+
+
+//-------------------------------------------------------------------------
+// Lock-free, growable Chase-Lev deque of jobs (Le, Pop, Cohen & Nardelli, "Correct and
+// Efficient Work-Stealing for Weak Memory Models").
+// Only the owning worker may Push() and Pop() at the bottom; any other thread may Steal()
+// from the top. Retired buffers are kept alive until the queue is destroyed so that a
+// thief that raced with a grow never reads freed memory.
+class WorkStealingQueue
+{
+public:
+	explicit WorkStealingQueue( int initialCapacity = 1024 );
+	~WorkStealingQueue();
+
+	WorkStealingQueue( WorkStealingQueue const& copy ) = delete;
+	WorkStealingQueue& operator=( WorkStealingQueue const& copyFrom ) = delete;
+
+	void Push( Job* job );	// owner only
+	Job* Pop();				// owner only, LIFO
+	Job* Steal();			// any thread, FIFO; returns nullptr if empty or if it lost a race
+
+	bool IsEmpty() const;
+	int	 GetApproximateSize() const;
+
+private:
+	struct JobRingBuffer
+	{
+		explicit JobRingBuffer( long long capacity );
+		~JobRingBuffer();
+
+		Job* Get( long long index ) const { return m_jobs[ index & m_mask ].load( std::memory_order_relaxed ); }
+		void Put( long long index, Job* job ) { m_jobs[ index & m_mask ].store( job, std::memory_order_relaxed ); }
+
+		long long		   m_capacity = 0;
+		long long		   m_mask	  = 0;
+		std::atomic<Job*>* m_jobs	  = nullptr;
+	};
+
+	JobRingBuffer* Grow( JobRingBuffer* oldBuffer, long long bottom, long long top );
+
+	alignas( 64 ) std::atomic<long long> m_top	  = 0;
+	alignas( 64 ) std::atomic<long long> m_bottom = 0;
+	alignas( 64 ) std::atomic<JobRingBuffer*> m_buffer = nullptr;
+
+	std::vector<JobRingBuffer*> m_retiredBuffers; // touched by the owner only
+};
@@ -1,6 +1,8 @@
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/IO/BufferReader.hpp"
 
+#include <string.h>
+
 
 //----------------------------------------------------------------------------------------------------------
 BufferReader::BufferReader( unsigned char const* bufferToParse, size_t bufferSizeInBytes, eBufferEndian endianMode ) 
@@ -271,3 +273,12 @@ Vertex_PCU BufferReader::ParseVertexPCU()
 	parsedVertex.m_uvTexCoords = ParseVec2();
 	return parsedVertex;
 }
+
+
+//----------------------------------------------------------------------------------------------------------
+void BufferReader::ParseBytes( void* out_bytes, size_t numBytes )
+{
+	GUARANTEE_OR_DIE( m_currentOffsetFromStart + numBytes <= m_bufferSize, "Parsing Index out of bounds" );
+	memcpy( out_bytes, &m_bufferStart[ m_currentOffsetFromStart ], numBytes );
+	m_currentOffsetFromStart += numBytes;
+}
@@ -39,6 +39,7 @@ public:
 	Rgba8		  ParseRgba();
 	Rgba8		  ParseRgb();
 	Vertex_PCU	  ParseVertexPCU();
+	void		  ParseBytes( void* out_bytes, size_t numBytes ); // copied as they are in the buffer, no endian swap
 
 	//----------------------------------------------------------------------------------------------------------
 	unsigned char const* m_bufferStart				 = nullptr;
@@ -344,3 +344,11 @@ void BufferWriter::AppendVertexPCU( Vertex_PCU const& vertexToAppend )
 	AppendRgba( vertexToAppend.m_color );
 	AppendVec2( vertexToAppend.m_uvTexCoords );
 }
+
+
+//----------------------------------------------------------------------------------------------------------
+void BufferWriter::AppendBytes( void const* bytesToAppend, size_t numBytes )
+{
+	uint8_t const* firstByte = reinterpret_cast<uint8_t const*>( bytesToAppend );
+	m_buffer.insert( m_buffer.end(), firstByte, firstByte + numBytes );
+}
@@ -40,6 +40,7 @@ public:
 	void AppendVec2( Vec2 vec2ToAppend );
 	void AppendVec3( Vec3 vec2ToAppend );
 	void AppendVertexPCU( Vertex_PCU const& vertexToAppend );
+	void AppendBytes( void const* bytesToAppend, size_t numBytes ); // copied as they are in memory, no endian swap
 
 	//----------------------------------------------------------------------------------------------------------
 	std::vector<uint8_t>& m_buffer;
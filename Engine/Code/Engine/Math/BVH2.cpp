@@ -0,0 +1,249 @@
+#include "Engine/Math/BVH2.hpp"
+#include "Engine/Math/BVHBuilder.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <float.h>
+#include <math.h>
+#include <utility>
+
+
+//----------------------------------------------------------------------------------------------------------
+// Distance along the ray to where it enters the bounds, FLT_MAX if it misses them within rayMaxDistance
+static float GetRayEntryDistance( AABB2 const& bounds, Vec2 const& rayStartPos, Vec2 const& inverseFwd, float rayMaxDistance )
+{
+	float entryDistance = 0.f;
+	float exitDistance	= rayMaxDistance;
+	if ( !ClipRayToBVHSlab( bounds.m_mins.x, bounds.m_maxs.x, rayStartPos.x, inverseFwd.x, entryDistance, exitDistance ) ||
+		 !ClipRayToBVHSlab( bounds.m_mins.y, bounds.m_maxs.y, rayStartPos.y, inverseFwd.y, entryDistance, exitDistance ) )
+	{
+		return FLT_MAX;
+	}
+	return entryDistance;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int BVH2::AddConvexHull( ConvexHull2 const& convexHull, Vec2 const& boundingDiscCenter, float boundingDiscRadius )
+{
+	Vec2 radius = Vec2( boundingDiscRadius, boundingDiscRadius );
+	m_primitiveBounds.push_back( AABB2( boundingDiscCenter - radius, boundingDiscCenter + radius ) );
+	m_primitives.push_back( { BVH2ShapeType::CONVEX_HULL, ( int ) m_convexHulls.size(), ( int ) m_primitives.size() } );
+	m_convexHulls.push_back( { convexHull, boundingDiscCenter, boundingDiscRadius } );
+	m_isBuilt = false;
+	return m_primitives.back().m_primitiveId;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int BVH2::AddDisc( Vec2 const& center, float radius )
+{
+	m_primitiveBounds.push_back( AABB2( center - Vec2( radius, radius ), center + Vec2( radius, radius ) ) );
+	m_primitives.push_back( { BVH2ShapeType::DISC, ( int ) m_discs.size(), ( int ) m_primitives.size() } );
+	m_discs.push_back( { center, radius } );
+	m_isBuilt = false;
+	return m_primitives.back().m_primitiveId;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int BVH2::AddAABB( AABB2 const& bounds )
+{
+	m_primitiveBounds.push_back( bounds );
+	m_primitives.push_back( { BVH2ShapeType::AABB, ( int ) m_aabbs.size(), ( int ) m_primitives.size() } );
+	m_aabbs.push_back( bounds );
+	m_isBuilt = false;
+	return m_primitives.back().m_primitiveId;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int BVH2::AddOBB( OBB2 const& orientedBox )
+{
+	Vec2 iBasis		= orientedBox.m_iBasisNormal;
+	Vec2 jBasis		= iBasis.GetRotated90Degrees();
+	Vec2 halfExtent = Vec2( fabsf( iBasis.x ) * orientedBox.m_halfDimensions.x + fabsf( jBasis.x ) * orientedBox.m_halfDimensions.y,
+		fabsf( iBasis.y ) * orientedBox.m_halfDimensions.x + fabsf( jBasis.y ) * orientedBox.m_halfDimensions.y );
+
+	m_primitiveBounds.push_back( AABB2( orientedBox.m_center - halfExtent, orientedBox.m_center + halfExtent ) );
+	m_primitives.push_back( { BVH2ShapeType::OBB, ( int ) m_obbs.size(), ( int ) m_primitives.size() } );
+	m_obbs.push_back( orientedBox );
+	m_isBuilt = false;
+	return m_primitives.back().m_primitiveId;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void BVH2::Build()
+{
+	int				   numPrimitives = ( int ) m_primitives.size();
+	std::vector<AABB3> primitiveBounds( numPrimitives );
+	for ( int primitiveId = 0; primitiveId < numPrimitives; primitiveId++ )
+	{
+		AABB2 const& bounds			   = m_primitiveBounds[ primitiveId ];
+		primitiveBounds[ primitiveId ] = AABB3( bounds.m_mins.x, bounds.m_mins.y, 0.f, bounds.m_maxs.x, bounds.m_maxs.y, 0.f );
+	}
+
+	std::vector<BVHNode3> nodes;
+	std::vector<int>	  primitiveOrder;
+	BuildBVHNodes( primitiveBounds, 2, nodes, primitiveOrder );
+
+	m_nodes.resize( nodes.size() );
+	for ( int nodeIndex = 0; nodeIndex < ( int ) nodes.size(); nodeIndex++ )
+	{
+		BVHNode3 const& node = nodes[ nodeIndex ];
+		m_nodes[ nodeIndex ] = { AABB2( node.m_bounds.m_mins.x, node.m_bounds.m_mins.y, node.m_bounds.m_maxs.x, node.m_bounds.m_maxs.y ), node.m_firstPrimitiveOrRightChild, node.m_numPrimitives };
+	}
+
+	// primitives in leaf order, so each leaf's primitives are next to each other
+	std::vector<BVH2Primitive> primitivesById( numPrimitives );
+	for ( BVH2Primitive const& primitive : m_primitives )
+	{
+		primitivesById[ primitive.m_primitiveId ] = primitive;
+	}
+	for ( int orderIndex = 0; orderIndex < numPrimitives; orderIndex++ )
+	{
+		m_primitives[ orderIndex ] = primitivesById[ primitiveOrder[ orderIndex ] ];
+	}
+
+	m_isBuilt = true;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void BVH2::Clear()
+{
+	m_convexHulls.clear();
+	m_discs.clear();
+	m_aabbs.clear();
+	m_obbs.clear();
+	m_primitives.clear();
+	m_primitiveBounds.clear();
+	m_nodes.clear();
+	m_isBuilt = false;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+RaycastResult2D BVH2::Raycast( Vec2 const& rayStartPos, Vec2 const& rayFwdNormal, float rayMaxDistance, int* out_primitiveId ) const
+{
+	return Traverse( rayStartPos, rayFwdNormal, rayMaxDistance, false, out_primitiveId );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+RaycastResult2D BVH2::RaycastAny( Vec2 const& rayStartPos, Vec2 const& rayFwdNormal, float rayMaxDistance, int* out_primitiveId ) const
+{
+	return Traverse( rayStartPos, rayFwdNormal, rayMaxDistance, true, out_primitiveId );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+RaycastResult2D BVH2::RaycastPrimitive( BVH2Primitive const& primitive, Vec2 const& rayStartPos, Vec2 const& rayFwdNormal, float rayMaxDistance ) const
+{
+	switch ( primitive.m_shapeType )
+	{
+	case BVH2ShapeType::CONVEX_HULL:
+	{
+		BVH2ConvexHull const& convexHull = m_convexHulls[ primitive.m_shapeIndex ];
+		return RaycastVsConvexHull2D( rayStartPos, rayFwdNormal, rayMaxDistance, convexHull.m_convexHull, convexHull.m_boundingDiscCenter, convexHull.m_boundingDiscRadius );
+	}
+	case BVH2ShapeType::DISC:
+		return RaycastVsDisc2D( rayStartPos, rayFwdNormal, rayMaxDistance, m_discs[ primitive.m_shapeIndex ].m_center, m_discs[ primitive.m_shapeIndex ].m_radius );
+	case BVH2ShapeType::AABB:
+		return RaycastVsAABB2D( rayStartPos, rayFwdNormal, rayMaxDistance, m_aabbs[ primitive.m_shapeIndex ] );
+	case BVH2ShapeType::OBB:
+		return RaycastVsOBB2D( rayStartPos, rayFwdNormal, rayMaxDistance, m_obbs[ primitive.m_shapeIndex ] );
+	}
+	return RaycastResult2D();
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Depth first, nearer child first; the farther child waits on the stack with the distance the ray
+// enters it, and is skipped if a hit closer than that has been found by the time it's popped.
+// Each primitive is cast only as far as the closest hit so far
+RaycastResult2D BVH2::Traverse( Vec2 const& rayStartPos, Vec2 const& rayFwdNormal, float rayMaxDistance, bool stopAtFirstHit, int* out_primitiveId ) const
+{
+	GUARANTEE_OR_DIE( m_isBuilt || m_primitives.empty(), "BVH2 raycast after adding primitives without calling Build()" );
+
+	RaycastResult2D closestResult;
+	int				closestPrimitiveId = -1;
+	float			closestDistance	   = rayMaxDistance;
+
+	Vec2			  inverseFwd = Vec2( 1.f / rayFwdNormal.x, 1.f / rayFwdNormal.y );
+	BVHTraversalEntry traversalStack[ BVH_MAX_DEPTH ];
+	int				  stackSize = 0;
+	if ( !m_nodes.empty() )
+	{
+		float rootEntryDistance = GetRayEntryDistance( m_nodes[ 0 ].m_bounds, rayStartPos, inverseFwd, closestDistance );
+		if ( rootEntryDistance != FLT_MAX )
+		{
+			traversalStack[ stackSize++ ] = { 0, rootEntryDistance };
+		}
+	}
+
+	while ( stackSize > 0 )
+	{
+		BVHTraversalEntry entry = traversalStack[ --stackSize ];
+		if ( entry.m_entryDistance >= closestDistance )
+		{
+			continue;
+		}
+
+		int nodeIndex = entry.m_nodeIndex;
+		while ( m_nodes[ nodeIndex ].m_numPrimitives == 0 )
+		{
+			int	  nearChildIndex	= nodeIndex + 1;
+			int	  farChildIndex		= m_nodes[ nodeIndex ].m_firstPrimitiveOrRightChild;
+			float nearEntryDistance = GetRayEntryDistance( m_nodes[ nearChildIndex ].m_bounds, rayStartPos, inverseFwd, closestDistance );
+			float farEntryDistance	= GetRayEntryDistance( m_nodes[ farChildIndex ].m_bounds, rayStartPos, inverseFwd, closestDistance );
+			if ( farEntryDistance < nearEntryDistance )
+			{
+				std::swap( nearChildIndex, farChildIndex );
+				std::swap( nearEntryDistance, farEntryDistance );
+			}
+
+			if ( nearEntryDistance == FLT_MAX )
+			{
+				nodeIndex = -1; // misses both children
+				break;
+			}
+			if ( farEntryDistance != FLT_MAX )
+			{
+				traversalStack[ stackSize++ ] = { farChildIndex, farEntryDistance };
+			}
+			nodeIndex = nearChildIndex;
+		}
+		if ( nodeIndex < 0 )
+		{
+			continue;
+		}
+
+		BVHNode2 const& leaf = m_nodes[ nodeIndex ];
+		for ( int orderIndex = leaf.m_firstPrimitiveOrRightChild; orderIndex < leaf.m_firstPrimitiveOrRightChild + leaf.m_numPrimitives; orderIndex++ )
+		{
+			BVH2Primitive const& primitive = m_primitives[ orderIndex ];
+			RaycastResult2D		 result	   = RaycastPrimitive( primitive, rayStartPos, rayFwdNormal, closestDistance );
+			if ( result.m_didImpact && result.m_impactDist < closestDistance )
+			{
+				closestResult	   = result;
+				closestDistance	   = result.m_impactDist;
+				closestPrimitiveId = primitive.m_primitiveId;
+				if ( stopAtFirstHit )
+				{
+					stackSize = 0;
+					break;
+				}
+			}
+		}
+	}
+
+	closestResult.m_rayStartPos	 = rayStartPos;
+	closestResult.m_rayFwdNormal = rayFwdNormal;
+	closestResult.m_rayMaxLength = rayMaxDistance;
+	if ( out_primitiveId != nullptr )
+	{
+		*out_primitiveId = closestPrimitiveId;
+	}
+	return closestResult;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/ConvexHull2.hpp"
+#include "Engine/Math/OBB2.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------------
+enum class BVH2ShapeType : unsigned char
+{
+	CONVEX_HULL,
+	DISC,
+	AABB,
+	OBB,
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct BVH2ConvexHull
+{
+	ConvexHull2 m_convexHull;
+	Vec2		m_boundingDiscCenter;
+	float		m_boundingDiscRadius = 0.f;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct BVH2Disc
+{
+	Vec2  m_center;
+	float m_radius = 0.f;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct BVH2Primitive
+{
+	BVH2ShapeType m_shapeType	= BVH2ShapeType::DISC;
+	int			  m_shapeIndex	= 0; // into the array of its shape type
+	int			  m_primitiveId	= 0; // what the Add function returned
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// BVHNode3 with the z dropped, so a traversal step reads half a cache line
+struct BVHNode2
+{
+	AABB2 m_bounds;
+	int	  m_firstPrimitiveOrRightChild = 0;
+	int	  m_numPrimitives			   = 0;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// A bounding volume hierarchy over a static 2D scene of hulls, discs and boxes, so a raycast only
+// tests the primitives whose bounds it passes through: O(log n) nodes for a scene of n primitives
+// instead of a loop over all of them. Add every primitive, Build() once, then raycast as often as
+// needed from any number of threads; adding after Build() needs another Build().
+class BVH2
+{
+public:
+	// each returns the primitive id that raycasts report
+	int AddConvexHull( ConvexHull2 const& convexHull, Vec2 const& boundingDiscCenter, float boundingDiscRadius );
+	int AddDisc( Vec2 const& center, float radius );
+	int AddAABB( AABB2 const& bounds );
+	int AddOBB( OBB2 const& orientedBox );
+
+	void Build();
+	void Clear();
+
+	// the closest hit within rayMaxDistance; out_primitiveId gets the id of the primitive hit, -1 on a miss
+	RaycastResult2D Raycast( Vec2 const& rayStartPos, Vec2 const& rayFwdNormal, float rayMaxDistance, int* out_primitiveId = nullptr ) const;
+
+	// stops at the first hit found, which need not be the closest; for line of sight checks
+	RaycastResult2D RaycastAny( Vec2 const& rayStartPos, Vec2 const& rayFwdNormal, float rayMaxDistance, int* out_primitiveId = nullptr ) const;
+
+	int GetNumPrimitives() const { return ( int ) m_primitives.size(); }
+	int GetNumNodes() const { return ( int ) m_nodes.size(); }
+
+protected:
+	RaycastResult2D RaycastPrimitive( BVH2Primitive const& primitive, Vec2 const& rayStartPos, Vec2 const& rayFwdNormal, float rayMaxDistance ) const;
+	RaycastResult2D Traverse( Vec2 const& rayStartPos, Vec2 const& rayFwdNormal, float rayMaxDistance, bool stopAtFirstHit, int* out_primitiveId ) const;
+
+	std::vector<BVH2ConvexHull> m_convexHulls;
+	std::vector<BVH2Disc>		m_discs;
+	std::vector<AABB2>			m_aabbs;
+	std::vector<OBB2>			m_obbs;
+
+	std::vector<BVH2Primitive> m_primitives;	  // in leaf order once built
+	std::vector<AABB2>		   m_primitiveBounds; // by primitive id
+	std::vector<BVHNode2>	   m_nodes;
+	bool					   m_isBuilt = false;
+};
@@ -0,0 +1,218 @@
+#include "Engine/Math/BVH3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <float.h>
+#include <math.h>
+#include <utility>
+
+
+//----------------------------------------------------------------------------------------------------------
+// Distance along the ray to where it enters the bounds, FLT_MAX if it misses them within rayMaxDistance
+static float GetRayEntryDistance( AABB3 const& bounds, Vec3 const& rayStartPos, Vec3 const& inverseFwd, float rayMaxDistance )
+{
+	float entryDistance = 0.f;
+	float exitDistance	= rayMaxDistance;
+	if ( !ClipRayToBVHSlab( bounds.m_mins.x, bounds.m_maxs.x, rayStartPos.x, inverseFwd.x, entryDistance, exitDistance ) ||
+		 !ClipRayToBVHSlab( bounds.m_mins.y, bounds.m_maxs.y, rayStartPos.y, inverseFwd.y, entryDistance, exitDistance ) ||
+		 !ClipRayToBVHSlab( bounds.m_mins.z, bounds.m_maxs.z, rayStartPos.z, inverseFwd.z, entryDistance, exitDistance ) )
+	{
+		return FLT_MAX;
+	}
+	return entryDistance;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int BVH3::AddConvexHull( ConvexHull3 const& convexHull, AABB3 const& bounds )
+{
+	m_primitiveBounds.push_back( bounds );
+	m_primitives.push_back( { BVH3ShapeType::CONVEX_HULL, ( int ) m_convexHulls.size(), ( int ) m_primitives.size() } );
+	m_convexHulls.push_back( convexHull );
+	m_isBuilt = false;
+	return m_primitives.back().m_primitiveId;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int BVH3::AddAABB( AABB3 const& bounds )
+{
+	m_primitiveBounds.push_back( bounds );
+	m_primitives.push_back( { BVH3ShapeType::AABB, ( int ) m_aabbs.size(), ( int ) m_primitives.size() } );
+	m_aabbs.push_back( bounds );
+	m_isBuilt = false;
+	return m_primitives.back().m_primitiveId;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int BVH3::AddOBB( OBB3 const& orientedBox )
+{
+	Vec3 iBasis		= orientedBox.m_iBasisNormal;
+	Vec3 jBasis		= orientedBox.m_jBasisNormal;
+	Vec3 kBasis		= CrossProduct3D( iBasis, jBasis );
+	Vec3 halfDims	= orientedBox.m_dimensions;
+	Vec3 halfExtent = Vec3( fabsf( iBasis.x ) * halfDims.x + fabsf( jBasis.x ) * halfDims.y + fabsf( kBasis.x ) * halfDims.z,
+		fabsf( iBasis.y ) * halfDims.x + fabsf( jBasis.y ) * halfDims.y + fabsf( kBasis.y ) * halfDims.z,
+		fabsf( iBasis.z ) * halfDims.x + fabsf( jBasis.z ) * halfDims.y + fabsf( kBasis.z ) * halfDims.z );
+
+	m_primitiveBounds.push_back( AABB3( orientedBox.m_center - halfExtent, orientedBox.m_center + halfExtent ) );
+	m_primitives.push_back( { BVH3ShapeType::OBB, ( int ) m_obbs.size(), ( int ) m_primitives.size() } );
+	m_obbs.push_back( orientedBox );
+	m_isBuilt = false;
+	return m_primitives.back().m_primitiveId;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void BVH3::Build()
+{
+	std::vector<int> primitiveOrder;
+	BuildBVHNodes( m_primitiveBounds, 3, m_nodes, primitiveOrder );
+
+	// primitives in leaf order, so each leaf's primitives are next to each other
+	int						   numPrimitives = ( int ) m_primitives.size();
+	std::vector<BVH3Primitive> primitivesById( numPrimitives );
+	for ( BVH3Primitive const& primitive : m_primitives )
+	{
+		primitivesById[ primitive.m_primitiveId ] = primitive;
+	}
+	for ( int orderIndex = 0; orderIndex < numPrimitives; orderIndex++ )
+	{
+		m_primitives[ orderIndex ] = primitivesById[ primitiveOrder[ orderIndex ] ];
+	}
+
+	m_isBuilt = true;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void BVH3::Clear()
+{
+	m_convexHulls.clear();
+	m_aabbs.clear();
+	m_obbs.clear();
+	m_primitives.clear();
+	m_primitiveBounds.clear();
+	m_nodes.clear();
+	m_isBuilt = false;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+RaycastResult3D BVH3::Raycast( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance, int* out_primitiveId ) const
+{
+	return Traverse( rayStartPos, rayFwdNormal, rayMaxDistance, false, out_primitiveId );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+RaycastResult3D BVH3::RaycastAny( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance, int* out_primitiveId ) const
+{
+	return Traverse( rayStartPos, rayFwdNormal, rayMaxDistance, true, out_primitiveId );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+RaycastResult3D BVH3::RaycastPrimitive( BVH3Primitive const& primitive, Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance ) const
+{
+	switch ( primitive.m_shapeType )
+	{
+	case BVH3ShapeType::CONVEX_HULL:
+		return RaycastVsConvexHull3D( rayStartPos, rayFwdNormal, rayMaxDistance, m_convexHulls[ primitive.m_shapeIndex ] );
+	case BVH3ShapeType::AABB:
+		return RaycastVsAABB3D( rayStartPos, rayFwdNormal, rayMaxDistance, m_aabbs[ primitive.m_shapeIndex ] );
+	case BVH3ShapeType::OBB:
+		return RaycastVsOBB3D( rayStartPos, rayFwdNormal, rayMaxDistance, m_obbs[ primitive.m_shapeIndex ] );
+	}
+	return RaycastResult3D();
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Same traversal as BVH2::Traverse()
+RaycastResult3D BVH3::Traverse( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance, bool stopAtFirstHit, int* out_primitiveId ) const
+{
+	GUARANTEE_OR_DIE( m_isBuilt || m_primitives.empty(), "BVH3 raycast after adding primitives without calling Build()" );
+
+	RaycastResult3D closestResult;
+	int				closestPrimitiveId = -1;
+	float			closestDistance	   = rayMaxDistance;
+
+	Vec3			  inverseFwd = Vec3( 1.f / rayFwdNormal.x, 1.f / rayFwdNormal.y, 1.f / rayFwdNormal.z );
+	BVHTraversalEntry traversalStack[ BVH_MAX_DEPTH ];
+	int				  stackSize = 0;
+	if ( !m_nodes.empty() )
+	{
+		float rootEntryDistance = GetRayEntryDistance( m_nodes[ 0 ].m_bounds, rayStartPos, inverseFwd, closestDistance );
+		if ( rootEntryDistance != FLT_MAX )
+		{
+			traversalStack[ stackSize++ ] = { 0, rootEntryDistance };
+		}
+	}
+
+	while ( stackSize > 0 )
+	{
+		BVHTraversalEntry entry = traversalStack[ --stackSize ];
+		if ( entry.m_entryDistance >= closestDistance )
+		{
+			continue;
+		}
+
+		int nodeIndex = entry.m_nodeIndex;
+		while ( m_nodes[ nodeIndex ].m_numPrimitives == 0 )
+		{
+			int	  nearChildIndex	= nodeIndex + 1;
+			int	  farChildIndex		= m_nodes[ nodeIndex ].m_firstPrimitiveOrRightChild;
+			float nearEntryDistance = GetRayEntryDistance( m_nodes[ nearChildIndex ].m_bounds, rayStartPos, inverseFwd, closestDistance );
+			float farEntryDistance	= GetRayEntryDistance( m_nodes[ farChildIndex ].m_bounds, rayStartPos, inverseFwd, closestDistance );
+			if ( farEntryDistance < nearEntryDistance )
+			{
+				std::swap( nearChildIndex, farChildIndex );
+				std::swap( nearEntryDistance, farEntryDistance );
+			}
+
+			if ( nearEntryDistance == FLT_MAX )
+			{
+				nodeIndex = -1; // misses both children
+				break;
+			}
+			if ( farEntryDistance != FLT_MAX )
+			{
+				traversalStack[ stackSize++ ] = { farChildIndex, farEntryDistance };
+			}
+			nodeIndex = nearChildIndex;
+		}
+		if ( nodeIndex < 0 )
+		{
+			continue;
+		}
+
+		BVHNode3 const& leaf = m_nodes[ nodeIndex ];
+		for ( int orderIndex = leaf.m_firstPrimitiveOrRightChild; orderIndex < leaf.m_firstPrimitiveOrRightChild + leaf.m_numPrimitives; orderIndex++ )
+		{
+			BVH3Primitive const& primitive = m_primitives[ orderIndex ];
+			RaycastResult3D		 result	   = RaycastPrimitive( primitive, rayStartPos, rayFwdNormal, closestDistance );
+			if ( result.m_didImpact && result.m_impactDist < closestDistance )
+			{
+				closestResult	   = result;
+				closestDistance	   = result.m_impactDist;
+				closestPrimitiveId = primitive.m_primitiveId;
+				if ( stopAtFirstHit )
+				{
+					stackSize = 0;
+					break;
+				}
+			}
+		}
+	}
+
+	closestResult.m_rayStartPos	 = rayStartPos;
+	closestResult.m_rayFwdNormal = rayFwdNormal;
+	closestResult.m_rayMaxLength = rayMaxDistance;
+	if ( out_primitiveId != nullptr )
+	{
+		*out_primitiveId = closestPrimitiveId;
+	}
+	return closestResult;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/BVHBuilder.hpp"
+#include "Engine/Math/ConvexHull3.hpp"
+#include "Engine/Math/OBB3.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------------
+enum class BVH3ShapeType : unsigned char
+{
+	CONVEX_HULL,
+	AABB,
+	OBB,
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct BVH3Primitive
+{
+	BVH3ShapeType m_shapeType	= BVH3ShapeType::AABB;
+	int			  m_shapeIndex	= 0; // into the array of its shape type
+	int			  m_primitiveId = 0; // what the Add function returned
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// BVH2 in 3D, over hulls and boxes
+class BVH3
+{
+public:
+	// each returns the primitive id that raycasts report. A hull's planes don't give its extent, so
+	// the caller passes bounds that contain it
+	int AddConvexHull( ConvexHull3 const& convexHull, AABB3 const& bounds );
+	int AddAABB( AABB3 const& bounds );
+	int AddOBB( OBB3 const& orientedBox ); // m_dimensions are half extents
+
+	void Build();
+	void Clear();
+
+	// the closest hit within rayMaxDistance; out_primitiveId gets the id of the primitive hit, -1 on a miss
+	RaycastResult3D Raycast( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance, int* out_primitiveId = nullptr ) const;
+
+	// stops at the first hit found, which need not be the closest; for line of sight checks
+	RaycastResult3D RaycastAny( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance, int* out_primitiveId = nullptr ) const;
+
+	int GetNumPrimitives() const { return ( int ) m_primitives.size(); }
+	int GetNumNodes() const { return ( int ) m_nodes.size(); }
+
+protected:
+	RaycastResult3D RaycastPrimitive( BVH3Primitive const& primitive, Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance ) const;
+	RaycastResult3D Traverse( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance, bool stopAtFirstHit, int* out_primitiveId ) const;
+
+	std::vector<ConvexHull3> m_convexHulls;
+	std::vector<AABB3>		 m_aabbs;
+	std::vector<OBB3>		 m_obbs;
+
+	std::vector<BVH3Primitive> m_primitives;	  // in leaf order once built
+	std::vector<AABB3>		   m_primitiveBounds; // by primitive id
+	std::vector<BVHNode3>	   m_nodes;
+	bool					   m_isBuilt = false;
+};
@@ -0,0 +1,201 @@
+#include "Engine/Math/BVHBuilder.hpp"
+
+#include <algorithm>
+#include <float.h>
+
+
+//----------------------------------------------------------------------------------------------------------
+static constexpr float BVH_NODE_VISIT_COST = 0.5f; // relative to one primitive raycast
+
+
+//----------------------------------------------------------------------------------------------------------
+struct BVHBuildTask
+{
+	int m_rightChildOfNode = -1; // the interior node waiting for this node's index, -1 for left children and the root
+	int m_beginIndex	   = 0;	 // range of the primitive order
+	int m_endIndex		   = 0;
+	int m_depth			   = 0;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+static float GetComponent( Vec3 const& vector, int axis )
+{
+	return axis == 0 ? vector.x : ( axis == 1 ? vector.y : vector.z );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static AABB3 MakeEmptyBounds()
+{
+	return AABB3( FLT_MAX, FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static void StretchToIncludeBounds( AABB3& bounds, AABB3 const& boundsToInclude )
+{
+	bounds.m_mins = Vec3( std::min( bounds.m_mins.x, boundsToInclude.m_mins.x ), std::min( bounds.m_mins.y, boundsToInclude.m_mins.y ), std::min( bounds.m_mins.z, boundsToInclude.m_mins.z ) );
+	bounds.m_maxs = Vec3( std::max( bounds.m_maxs.x, boundsToInclude.m_maxs.x ), std::max( bounds.m_maxs.y, boundsToInclude.m_maxs.y ), std::max( bounds.m_maxs.z, boundsToInclude.m_maxs.z ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// proportional to the chance a random ray hits the bounds: half the surface area in 3D, the perimeter in 2D
+static float GetSurfaceAreaHeuristicArea( AABB3 const& bounds, int numAxes )
+{
+	Vec3 dimensions = bounds.m_maxs - bounds.m_mins;
+	if ( numAxes == 2 )
+	{
+		return dimensions.x + dimensions.y;
+	}
+	return ( dimensions.x * dimensions.y ) + ( dimensions.y * dimensions.z ) + ( dimensions.z * dimensions.x );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void BuildBVHNodes( std::vector<AABB3> const& primitiveBounds, int numAxes, std::vector<BVHNode3>& out_nodes, std::vector<int>& out_primitiveOrder )
+{
+	int numPrimitives = ( int ) primitiveBounds.size();
+	out_nodes.clear();
+	out_primitiveOrder.resize( numPrimitives );
+	for ( int primitiveIndex = 0; primitiveIndex < numPrimitives; primitiveIndex++ )
+	{
+		out_primitiveOrder[ primitiveIndex ] = primitiveIndex;
+	}
+	if ( numPrimitives == 0 )
+	{
+		return;
+	}
+
+	std::vector<Vec3> centroids( numPrimitives );
+	for ( int primitiveIndex = 0; primitiveIndex < numPrimitives; primitiveIndex++ )
+	{
+		centroids[ primitiveIndex ] = primitiveBounds[ primitiveIndex ].GetCenter();
+	}
+
+	// depth first: a node's left child is built right after it, the right child once the left subtree is done
+	std::vector<BVHBuildTask> buildTasks;
+	buildTasks.push_back( { -1, 0, numPrimitives, 0 } );
+	while ( !buildTasks.empty() )
+	{
+		BVHBuildTask task = buildTasks.back();
+		buildTasks.pop_back();
+
+		int nodeIndex = ( int ) out_nodes.size();
+		if ( task.m_rightChildOfNode >= 0 )
+		{
+			out_nodes[ task.m_rightChildOfNode ].m_firstPrimitiveOrRightChild = nodeIndex;
+		}
+		out_nodes.emplace_back();
+
+		AABB3 nodeBounds	 = MakeEmptyBounds();
+		AABB3 centroidBounds = MakeEmptyBounds();
+		for ( int orderIndex = task.m_beginIndex; orderIndex < task.m_endIndex; orderIndex++ )
+		{
+			int primitiveIndex = out_primitiveOrder[ orderIndex ];
+			StretchToIncludeBounds( nodeBounds, primitiveBounds[ primitiveIndex ] );
+			StretchToIncludeBounds( centroidBounds, AABB3( centroids[ primitiveIndex ], centroids[ primitiveIndex ] ) );
+		}
+		out_nodes[ nodeIndex ].m_bounds = nodeBounds;
+
+		// 1. cheapest split over the bin borders of every axis, costed as primitives times the area they're in
+		int	  numNodePrimitives = task.m_endIndex - task.m_beginIndex;
+		bool  canSplit			= numNodePrimitives > 1 && task.m_depth < BVH_MAX_DEPTH - 1;
+		float bestSplitCost		= FLT_MAX;
+		int	  bestAxis			= -1;
+		int	  bestFirstRightBin = 0;
+		for ( int axis = 0; canSplit && axis < numAxes; axis++ )
+		{
+			float centroidMin	 = GetComponent( centroidBounds.m_mins, axis );
+			float centroidExtent = GetComponent( centroidBounds.m_maxs, axis ) - centroidMin;
+			if ( centroidExtent <= 0.f )
+			{
+				continue;
+			}
+
+			int	  binCounts[ BVH_NUM_SAH_BINS ] = {};
+			AABB3 binBounds[ BVH_NUM_SAH_BINS ];
+			for ( AABB3& bounds : binBounds )
+			{
+				bounds = MakeEmptyBounds();
+			}
+
+			float binsPerUnit = ( float ) BVH_NUM_SAH_BINS / centroidExtent;
+			for ( int orderIndex = task.m_beginIndex; orderIndex < task.m_endIndex; orderIndex++ )
+			{
+				int primitiveIndex = out_primitiveOrder[ orderIndex ];
+				int binIndex	   = std::min( ( int ) ( ( GetComponent( centroids[ primitiveIndex ], axis ) - centroidMin ) * binsPerUnit ), BVH_NUM_SAH_BINS - 1 );
+				binCounts[ binIndex ]++;
+				StretchToIncludeBounds( binBounds[ binIndex ], primitiveBounds[ primitiveIndex ] );
+			}
+
+			// sweep from the left, then from the right, so every border costs O(1)
+			float leftCosts[ BVH_NUM_SAH_BINS ]	 = {};
+			int	  leftCounts[ BVH_NUM_SAH_BINS ] = {};
+			AABB3 sweptBounds					 = MakeEmptyBounds();
+			int	  sweptCount					 = 0;
+			for ( int binIndex = 0; binIndex < BVH_NUM_SAH_BINS - 1; binIndex++ )
+			{
+				StretchToIncludeBounds( sweptBounds, binBounds[ binIndex ] );
+				sweptCount += binCounts[ binIndex ];
+				leftCounts[ binIndex ] = sweptCount;
+				leftCosts[ binIndex ]  = sweptCount > 0 ? sweptCount * GetSurfaceAreaHeuristicArea( sweptBounds, numAxes ) : 0.f;
+			}
+
+			sweptBounds = MakeEmptyBounds();
+			sweptCount	= 0;
+			for ( int firstRightBin = BVH_NUM_SAH_BINS - 1; firstRightBin > 0; firstRightBin-- )
+			{
+				StretchToIncludeBounds( sweptBounds, binBounds[ firstRightBin ] );
+				sweptCount += binCounts[ firstRightBin ];
+				if ( sweptCount == 0 || leftCounts[ firstRightBin - 1 ] == 0 )
+				{
+					continue;
+				}
+
+				float splitCost = leftCosts[ firstRightBin - 1 ] + sweptCount * GetSurfaceAreaHeuristicArea( sweptBounds, numAxes );
+				if ( splitCost < bestSplitCost )
+				{
+					bestSplitCost	  = splitCost;
+					bestAxis		  = axis;
+					bestFirstRightBin = firstRightBin;
+				}
+			}
+		}
+
+		// 2. small nodes stay leaves unless splitting is cheaper than testing every primitive
+		bool isLeaf = !canSplit;
+		if ( canSplit && numNodePrimitives <= BVH_MAX_PRIMITIVES_PER_LEAF )
+		{
+			float nodeArea	= GetSurfaceAreaHeuristicArea( nodeBounds, numAxes );
+			float splitCost = nodeArea > 0.f ? BVH_NODE_VISIT_COST + ( bestSplitCost / nodeArea ) : FLT_MAX;
+			isLeaf			= bestAxis < 0 || splitCost >= ( float ) numNodePrimitives;
+		}
+
+		if ( isLeaf )
+		{
+			out_nodes[ nodeIndex ].m_firstPrimitiveOrRightChild = task.m_beginIndex;
+			out_nodes[ nodeIndex ].m_numPrimitives				= numNodePrimitives;
+			continue;
+		}
+
+		// 3. split; primitives with identical centroids have no border between them, so they're halved by count
+		int middleIndex = ( task.m_beginIndex + task.m_endIndex ) / 2;
+		if ( bestAxis >= 0 )
+		{
+			float centroidMin	= GetComponent( centroidBounds.m_mins, bestAxis );
+			float binsPerUnit	= ( float ) BVH_NUM_SAH_BINS / ( GetComponent( centroidBounds.m_maxs, bestAxis ) - centroidMin );
+			auto  isLeftOfSplit	= [ & ]( int primitiveIndex )
+			{
+				int binIndex = std::min( ( int ) ( ( GetComponent( centroids[ primitiveIndex ], bestAxis ) - centroidMin ) * binsPerUnit ), BVH_NUM_SAH_BINS - 1 );
+				return binIndex < bestFirstRightBin;
+			};
+			int* middle = std::partition( out_primitiveOrder.data() + task.m_beginIndex, out_primitiveOrder.data() + task.m_endIndex, isLeftOfSplit );
+			middleIndex = ( int ) ( middle - out_primitiveOrder.data() );
+		}
+
+		buildTasks.push_back( { nodeIndex, middleIndex, task.m_endIndex, task.m_depth + 1 } );
+		buildTasks.push_back( { -1, task.m_beginIndex, middleIndex, task.m_depth + 1 } );
+	}
+}
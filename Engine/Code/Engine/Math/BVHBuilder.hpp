@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Engine/Math/AABB3.hpp"
+
+#include <math.h>
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------------
+constexpr int BVH_MAX_PRIMITIVES_PER_LEAF = 4;
+constexpr int BVH_NUM_SAH_BINS			  = 16; // candidate split planes per axis are the bin borders
+constexpr int BVH_MAX_DEPTH				  = 64; // deeper nodes become leaves, so traversal stacks can be fixed size
+
+
+//----------------------------------------------------------------------------------------------------------
+// One node of a flattened BVH. Nodes are stored depth first, so the left child of an interior
+// node is the next node and only the right child needs an index
+struct BVHNode3
+{
+	AABB3 m_bounds;
+	int	  m_firstPrimitiveOrRightChild = 0; // leaf: first index into the primitive order; interior: index of the right child
+	int	  m_numPrimitives			   = 0; // 0 for interior nodes
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// A node waiting on a traversal stack; the ray is known to enter its bounds at m_entryDistance
+struct BVHTraversalEntry
+{
+	int	  m_nodeIndex	  = 0;
+	float m_entryDistance = 0.f; // checked again when popped, a closer hit may have been found since
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Narrows [ io_entryDistance, io_exitDistance ] to where the ray is between a node's two planes on one axis;
+// false if that leaves nothing. inverseFwd is infinite when the ray is parallel to the planes, which
+// would make ( plane - start ) * inverseFwd a NaN for a start on a plane, so that axis is handled
+// like the slab tests in RaycastUtils: the start has to be between the planes, and the range is left alone
+inline bool ClipRayToBVHSlab( float slabMin, float slabMax, float startPos, float inverseFwd, float& io_entryDistance, float& io_exitDistance )
+{
+	if ( isinf( inverseFwd ) )
+	{
+		return startPos >= slabMin && startPos <= slabMax;
+	}
+
+	float minPlaneDistance = ( slabMin - startPos ) * inverseFwd;
+	float maxPlaneDistance = ( slabMax - startPos ) * inverseFwd;
+	io_entryDistance	   = fmaxf( io_entryDistance, fminf( minPlaneDistance, maxPlaneDistance ) );
+	io_exitDistance		   = fminf( io_exitDistance, fmaxf( minPlaneDistance, maxPlaneDistance ) );
+	return io_entryDistance <= io_exitDistance;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Builds the nodes over the bounds of every primitive with a binned surface area heuristic: each
+// node splits where the primitives' centroids divide into the two children that are cheapest to
+// cast a ray into, or stays a leaf when that's cheaper. numAxes is 2 for 2D bounds ( z ignored,
+// the perimeter standing in for the surface area ) or 3.
+// out_primitiveOrder lists primitive indexes leaf by leaf; leaves reference ranges of it.
+void BuildBVHNodes( std::vector<AABB3> const& primitiveBounds, int numAxes, std::vector<BVHNode3>& out_nodes, std::vector<int>& out_primitiveOrder );
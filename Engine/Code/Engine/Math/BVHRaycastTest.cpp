@@ -0,0 +1,190 @@
+#include "Engine/Math/BVHRaycastTest.hpp"
+#include "Engine/Math/BVH2.hpp"
+#include "Engine/Math/BVH3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <math.h>
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------------
+constexpr int	BVH_TEST_GRID_SIZE		= 16;	// boxes sit on cells of a grid this many cells wide
+constexpr float BVH_TEST_BOX_CHANCE		= 0.35f;
+constexpr int	BVH_TEST_NUM_RAYS		= 4000;
+constexpr float BVH_TEST_RAY_MAX_LENGTH = 20.f;
+constexpr float BVH_TEST_DISTANCE_SLOP	= 0.0001f;
+
+
+//----------------------------------------------------------------------------------------------------------
+static void LogToDevConsole( Rgba8 const& color, std::string const& text )
+{
+	if ( g_theDevConsole )
+	{
+		g_theDevConsole->AddLine( color, text );
+	}
+	else
+	{
+		DebuggerPrintf( "%s\n", text.c_str() );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Mostly integer starts along an axis, so the ray lies on the edges and faces of the boxes;
+// then half-integer starts along an axis, and the rest in any direction
+static float RollRayStartCoordinate( RandomNumberGenerator& rng, int rayIndex )
+{
+	float cellCoordinate = ( float ) rng.RollRandomIntInRange( -1, BVH_TEST_GRID_SIZE + 1 );
+	return rayIndex % 4 == 1 ? cellCoordinate + 0.5f : cellCoordinate;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static bool DoResultsMatch( bool bvhDidImpact, float bvhImpactDist, bool bruteForceDidImpact, float bruteForceImpactDist )
+{
+	if ( bvhDidImpact != bruteForceDidImpact )
+	{
+		return false;
+	}
+	return !bvhDidImpact || fabsf( bvhImpactDist - bruteForceImpactDist ) <= BVH_TEST_DISTANCE_SLOP;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+BVHRaycastTestResult RunBVH2RaycastTest( unsigned int seed )
+{
+	RandomNumberGenerator rng;
+	rng.SetSeed( seed );
+
+	BVH2			   bvh;
+	std::vector<AABB2> boxes;
+	for ( int cellY = 0; cellY < BVH_TEST_GRID_SIZE; cellY++ )
+	{
+		for ( int cellX = 0; cellX < BVH_TEST_GRID_SIZE; cellX++ )
+		{
+			if ( rng.RollRandomFloatZeroToOne() < BVH_TEST_BOX_CHANCE )
+			{
+				boxes.push_back( AABB2( ( float ) cellX, ( float ) cellY, ( float ) cellX + 1.f, ( float ) cellY + 1.f ) );
+				bvh.AddAABB( boxes.back() );
+			}
+		}
+	}
+	bvh.Build();
+
+	BVHRaycastTestResult result;
+	for ( int rayIndex = 0; rayIndex < BVH_TEST_NUM_RAYS; rayIndex++ )
+	{
+		Vec2 rayStartPos = Vec2( RollRayStartCoordinate( rng, rayIndex ), RollRayStartCoordinate( rng, rayIndex ) );
+		Vec2 rayFwdNormal;
+		if ( rayIndex % 4 == 3 )
+		{
+			rayFwdNormal = Vec2::MakeFromPolarDegrees( rng.RollRandomFloatInRange( 0.f, 360.f ) );
+		}
+		else
+		{
+			Vec2 const axisDirections[ 4 ] = { Vec2( 1.f, 0.f ), Vec2( -1.f, 0.f ), Vec2( 0.f, 1.f ), Vec2( 0.f, -1.f ) };
+			rayFwdNormal				   = axisDirections[ rng.RollRandomIntLessThan( 4 ) ];
+		}
+
+		RaycastResult2D bruteForceResult;
+		for ( AABB2 const& box : boxes )
+		{
+			RaycastResult2D boxResult = RaycastVsAABB2D( rayStartPos, rayFwdNormal, BVH_TEST_RAY_MAX_LENGTH, box );
+			if ( boxResult.m_didImpact && ( !bruteForceResult.m_didImpact || boxResult.m_impactDist < bruteForceResult.m_impactDist ) )
+			{
+				bruteForceResult = boxResult;
+			}
+		}
+
+		RaycastResult2D closestResult = bvh.Raycast( rayStartPos, rayFwdNormal, BVH_TEST_RAY_MAX_LENGTH );
+		RaycastResult2D anyResult	  = bvh.RaycastAny( rayStartPos, rayFwdNormal, BVH_TEST_RAY_MAX_LENGTH );
+		bool			isMatch		  = DoResultsMatch( closestResult.m_didImpact, closestResult.m_impactDist, bruteForceResult.m_didImpact, bruteForceResult.m_impactDist ) &&
+							  anyResult.m_didImpact == bruteForceResult.m_didImpact;
+
+		result.m_numRays++;
+		result.m_numMismatches += isMatch ? 0 : 1;
+	}
+	return result;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+BVHRaycastTestResult RunBVH3RaycastTest( unsigned int seed )
+{
+	RandomNumberGenerator rng;
+	rng.SetSeed( seed );
+
+	// one layer of cubes on the grid, with a second layer on some of them
+	BVH3			   bvh;
+	std::vector<AABB3> boxes;
+	for ( int cellY = 0; cellY < BVH_TEST_GRID_SIZE; cellY++ )
+	{
+		for ( int cellX = 0; cellX < BVH_TEST_GRID_SIZE; cellX++ )
+		{
+			for ( int cellZ = 0; cellZ < 2; cellZ++ )
+			{
+				if ( rng.RollRandomFloatZeroToOne() < BVH_TEST_BOX_CHANCE )
+				{
+					boxes.push_back( AABB3( ( float ) cellX, ( float ) cellY, ( float ) cellZ, ( float ) cellX + 1.f, ( float ) cellY + 1.f, ( float ) cellZ + 1.f ) );
+					bvh.AddAABB( boxes.back() );
+				}
+			}
+		}
+	}
+	bvh.Build();
+
+	BVHRaycastTestResult result;
+	for ( int rayIndex = 0; rayIndex < BVH_TEST_NUM_RAYS; rayIndex++ )
+	{
+		Vec3 rayStartPos = Vec3( RollRayStartCoordinate( rng, rayIndex ), RollRayStartCoordinate( rng, rayIndex ), ( float ) rng.RollRandomIntInRange( 0, 2 ) );
+		Vec3 rayFwdNormal;
+		if ( rayIndex % 4 == 3 )
+		{
+			rayFwdNormal = Vec3( rng.RollRandomFloatInRange( -1.f, 1.f ), rng.RollRandomFloatInRange( -1.f, 1.f ), rng.RollRandomFloatInRange( -1.f, 1.f ) ).GetNormalized();
+		}
+		else
+		{
+			Vec3 const axisDirections[ 6 ] = { Vec3( 1.f, 0.f, 0.f ), Vec3( -1.f, 0.f, 0.f ), Vec3( 0.f, 1.f, 0.f ), Vec3( 0.f, -1.f, 0.f ), Vec3( 0.f, 0.f, 1.f ), Vec3( 0.f, 0.f, -1.f ) };
+			rayFwdNormal				   = axisDirections[ rng.RollRandomIntLessThan( 6 ) ];
+		}
+
+		RaycastResult3D bruteForceResult;
+		for ( AABB3 const& box : boxes )
+		{
+			RaycastResult3D boxResult = RaycastVsAABB3D( rayStartPos, rayFwdNormal, BVH_TEST_RAY_MAX_LENGTH, box );
+			if ( boxResult.m_didImpact && ( !bruteForceResult.m_didImpact || boxResult.m_impactDist < bruteForceResult.m_impactDist ) )
+			{
+				bruteForceResult = boxResult;
+			}
+		}
+
+		RaycastResult3D closestResult = bvh.Raycast( rayStartPos, rayFwdNormal, BVH_TEST_RAY_MAX_LENGTH );
+		RaycastResult3D anyResult	  = bvh.RaycastAny( rayStartPos, rayFwdNormal, BVH_TEST_RAY_MAX_LENGTH );
+		bool			isMatch		  = DoResultsMatch( closestResult.m_didImpact, closestResult.m_impactDist, bruteForceResult.m_didImpact, bruteForceResult.m_impactDist ) &&
+							  anyResult.m_didImpact == bruteForceResult.m_didImpact;
+
+		result.m_numRays++;
+		result.m_numMismatches += isMatch ? 0 : 1;
+	}
+	return result;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+bool Command_BVHRaycastTest( EventArgs& args )
+{
+	unsigned int seed = ( unsigned int ) args.GetValue( "Seed", 1 );
+
+	BVHRaycastTestResult results2D = RunBVH2RaycastTest( seed );
+	BVHRaycastTestResult results3D = RunBVH3RaycastTest( seed );
+
+	Rgba8 color = results2D.m_numMismatches == 0 && results3D.m_numMismatches == 0 ? DevConsole::INFO_MAJOR_COLOR : DevConsole::ERROR_COLOR;
+	LogToDevConsole( color, Stringf( "BVHRaycastTest: BVH2 %d of %d rays differ from brute force, BVH3 %d of %d", results2D.m_numMismatches,
+		results2D.m_numRays, results3D.m_numMismatches, results3D.m_numRays ) );
+	return true;
+}
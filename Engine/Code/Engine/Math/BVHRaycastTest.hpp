@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------
+struct BVHRaycastTestResult
+{
+	int m_numRays		= 0; // each cast with Raycast() and RaycastAny()
+	int m_numMismatches = 0; // rays where the BVH and the loop over every primitive disagree
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Checks BVH2 and BVH3 raycasts against casting the ray at every primitive. The scenes are unit boxes
+// on an integer grid, and most rays start on integer coordinates and run along an axis, so they slide
+// along the boxes' edges and faces, where a ray parallel to a node's side starts right on it
+BVHRaycastTestResult RunBVH2RaycastTest( unsigned int seed );
+BVHRaycastTestResult RunBVH3RaycastTest( unsigned int seed );
+
+// "BVHRaycastTest Seed=1"; logs the mismatches of both
+// The dev console subscribes it: g_theEventSystem->SubscribeToEvent( "BVHRaycastTest", Command_BVHRaycastTest );
+bool Command_BVHRaycastTest( EventArgs& args );
@@ -175,15 +175,6 @@ Vec2 const Mat44::TransformVectorQuantity2D(Vec2 const& vectorQuantityXY) const
 	return Vec2(x, y);
 }
 
-Vec3 const Mat44::TransformVectorQuantity3D(Vec3 const& vectorQuantityXYZ) const
-{
-	float x = m_values[Ix] * vectorQuantityXYZ.x	+	m_values[Jx] * vectorQuantityXYZ.y	+ m_values[Kx] * vectorQuantityXYZ.z;
-	float y = m_values[Iy] * vectorQuantityXYZ.x	+	m_values[Jy] * vectorQuantityXYZ.y	+ m_values[Ky] * vectorQuantityXYZ.z;
-	float z = m_values[Iz] * vectorQuantityXYZ.x	+	m_values[Jz] * vectorQuantityXYZ.y	+ m_values[Kz] * vectorQuantityXYZ.z;
-	
-	return Vec3(x, y, z);
-}
-
 Vec2 const Mat44::TransformPosition2D(Vec2 const& positionXY) const
 {
 	float x = m_values[Ix] * positionXY.x	+	m_values[Jx] * positionXY.y		+ m_values[Tx];
@@ -192,23 +183,39 @@ Vec2 const Mat44::TransformPosition2D(Vec2 const& positionXY) const
 	return Vec2(x, y);
 }
 
-Vec3 const Mat44::TransformPosition3D(Vec3 const& positionXYZ) const
+void Mat44::TransformPositions3D(Vec3 const* positions, Vec3* out_positions, int count, int positionStride, int outPositionStride) const
 {
-	float x = m_values[Ix] * positionXYZ.x	+	m_values[Jx] * positionXYZ.y	+	m_values[Kx] * positionXYZ.z	+ m_values[Tx];
-	float y = m_values[Iy] * positionXYZ.x	+	m_values[Jy] * positionXYZ.y	+	m_values[Ky] * positionXYZ.z	+ m_values[Ty];
-	float z = m_values[Iz] * positionXYZ.x	+	m_values[Jz] * positionXYZ.y	+	m_values[Kz] * positionXYZ.z	+ m_values[Tz];
-	
-	return Vec3(x, y, z);
+	__m128 iBasis		= _mm_loadu_ps(m_values + Ix);
+	__m128 jBasis		= _mm_loadu_ps(m_values + Jx);
+	__m128 kBasis		= _mm_loadu_ps(m_values + Kx);
+	__m128 translation	= _mm_loadu_ps(m_values + Tx);
+
+	unsigned char const* positionBytes		= reinterpret_cast<unsigned char const*>(positions);
+	unsigned char*		 outPositionBytes	= reinterpret_cast<unsigned char*>(out_positions);
+	for (int index = 0; index < count; index++)
+	{
+		// read before written, so in place works
+		Vec3 const& position = *reinterpret_cast<Vec3 const*>(positionBytes + (size_t)index * positionStride);
+		__m128		result	 = SIMDTransformByColumns(iBasis, jBasis, kBasis, translation, position.x, position.y, position.z, 1.f);
+		SIMDStoreVec3(*reinterpret_cast<Vec3*>(outPositionBytes + (size_t)index * outPositionStride), result);
+	}
 }
 
-Vec4 const Mat44::TransformHomogeneous3D(Vec4 const& homogeneousPoint3D) const
+void Mat44::TransformVectorQuantities3D(Vec3 const* vectorQuantities, Vec3* out_vectorQuantities, int count, int vectorStride, int outVectorStride) const
 {
-	float x = m_values[Ix] * homogeneousPoint3D.x	+	m_values[Jx] * homogeneousPoint3D.y		+	m_values[Kx] * homogeneousPoint3D.z		+	m_values[Tx] * homogeneousPoint3D.w;
-	float y = m_values[Iy] * homogeneousPoint3D.x	+	m_values[Jy] * homogeneousPoint3D.y		+	m_values[Ky] * homogeneousPoint3D.z		+	m_values[Ty] * homogeneousPoint3D.w;
-	float z = m_values[Iz] * homogeneousPoint3D.x	+	m_values[Jz] * homogeneousPoint3D.y		+	m_values[Kz] * homogeneousPoint3D.z		+	m_values[Tz] * homogeneousPoint3D.w;
-	float w = m_values[Iw] * homogeneousPoint3D.x	+	m_values[Jw] * homogeneousPoint3D.y		+	m_values[Kw] * homogeneousPoint3D.z		+	m_values[Tw] * homogeneousPoint3D.w;
-	
-	return Vec4(x, y, z, w);
+	__m128 iBasis = _mm_loadu_ps(m_values + Ix);
+	__m128 jBasis = _mm_loadu_ps(m_values + Jx);
+	__m128 kBasis = _mm_loadu_ps(m_values + Kx);
+
+	unsigned char const* vectorBytes	= reinterpret_cast<unsigned char const*>(vectorQuantities);
+	unsigned char*		 outVectorBytes	= reinterpret_cast<unsigned char*>(out_vectorQuantities);
+	for (int index = 0; index < count; index++)
+	{
+		Vec3 const& vectorQuantity = *reinterpret_cast<Vec3 const*>(vectorBytes + (size_t)index * vectorStride);
+		__m128		result		   = _mm_add_ps(_mm_mul_ps(iBasis, _mm_set1_ps(vectorQuantity.x)), _mm_mul_ps(jBasis, _mm_set1_ps(vectorQuantity.y)));
+		result					   = _mm_add_ps(result, _mm_mul_ps(kBasis, _mm_set1_ps(vectorQuantity.z)));
+		SIMDStoreVec3(*reinterpret_cast<Vec3*>(outVectorBytes + (size_t)index * outVectorStride), result);
+	}
 }
 
 float* Mat44::GetAsFloatArray()
@@ -388,32 +395,14 @@ void Mat44::SetIJKT4D(Vec4 const& iBasis4D, Vec4 const& jBasis4D, Vec4 const& kB
 	m_values[Iw] = iBasis4D.w;	m_values[Jw] = jBasis4D.w;	m_values[Kw] = kBasis4D.w;	m_values[Tw] = translation4D.w;
 }
 
-void Mat44::Append(Mat44 const& appendThis)
+void Mat44::AppendEach(Mat44 const* matrices, Mat44 const* appendMatrices, Mat44* out_matrices, int count)
 {
-	Mat44 copy = *this;
-
-	float* my = copy.m_values;
-	float const* append = appendThis.m_values;
-
-	m_values[Ix] = my[Ix] * append[Ix]	+	my[Jx] * append[Iy]		+	my[Kx] * append[Iz]		+	my[Tx] * append[Iw];
-	m_values[Iy] = my[Iy] * append[Ix]	+	my[Jy] * append[Iy]		+	my[Ky] * append[Iz]		+	my[Ty] * append[Iw];
-	m_values[Iz] = my[Iz] * append[Ix]	+	my[Jz] * append[Iy]		+	my[Kz] * append[Iz]		+	my[Tz] * append[Iw];
-	m_values[Iw] = my[Iw] * append[Ix]	+	my[Jw] * append[Iy]		+	my[Kw] * append[Iz]		+	my[Tw] * append[Iw];
-
-	m_values[Jx] = my[Ix] * append[Jx]	+	my[Jx] * append[Jy]		+	my[Kx] * append[Jz]		+	my[Tx] * append[Jw];
-	m_values[Jy] = my[Iy] * append[Jx]	+	my[Jy] * append[Jy]		+	my[Ky] * append[Jz]		+	my[Ty] * append[Jw];
-	m_values[Jz] = my[Iz] * append[Jx]	+	my[Jz] * append[Jy]		+	my[Kz] * append[Jz]		+	my[Tz] * append[Jw];
-	m_values[Jw] = my[Iw] * append[Jx]	+	my[Jw] * append[Jy]		+	my[Kw] * append[Jz]		+	my[Tw] * append[Jw];
-
-	m_values[Kx] = my[Ix] * append[Kx]	+	my[Jx] * append[Ky]		+	my[Kx] * append[Kz]		+	my[Tx] * append[Kw];
-	m_values[Ky] = my[Iy] * append[Kx]	+	my[Jy] * append[Ky]		+	my[Ky] * append[Kz]		+	my[Ty] * append[Kw];
-	m_values[Kz] = my[Iz] * append[Kx]	+	my[Jz] * append[Ky]		+	my[Kz] * append[Kz]		+	my[Tz] * append[Kw];
-	m_values[Kw] = my[Iw] * append[Kx]	+	my[Jw] * append[Ky]		+	my[Kw] * append[Kz]		+	my[Tw] * append[Kw];
-
-	m_values[Tx] = my[Ix] * append[Tx]	+	my[Jx] * append[Ty]		+	my[Kx] * append[Tz]		+	my[Tx] * append[Tw];
-	m_values[Ty] = my[Iy] * append[Tx]	+	my[Jy] * append[Ty]		+	my[Ky] * append[Tz]		+	my[Ty] * append[Tw];
-	m_values[Tz] = my[Iz] * append[Tx]	+	my[Jz] * append[Ty]		+	my[Kz] * append[Tz]		+	my[Tz] * append[Tw];
-	m_values[Tw] = my[Iw] * append[Tx]	+	my[Jw] * append[Ty]		+	my[Kw] * append[Tz]		+	my[Tw] * append[Tw];
+	for (int index = 0; index < count; index++)
+	{
+		Mat44 product = matrices[index];
+		product.Append(appendMatrices[index]);
+		out_matrices[index] = product;
+	}
 }
 
 void Mat44::AppendZRotation(float degreesRotationAboutZ)
@@ -1,12 +1,14 @@
 #pragma once
 
+#include "Engine/Math/MathSIMD.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/Vec4.hpp"
+
 struct Vec2;
-struct Vec3;
-struct Vec4;
 struct Transform;
 
 
-struct Mat44
+struct alignas( 16 ) Mat44 // each basis is one SSE register
 {
 	enum { Ix, Iy, Iz, Iw,  Jx, Jy, Jz, Jw,	 Kx, Ky, Kz, Kw,  Tx, Ty, Tz, Tw }; // index nicknames, [0] through [15]
 	float m_values[16] = {}; // stored in "bases major" order (Ix,Iy,Iz,Iw,Jx...)
@@ -37,6 +39,10 @@ struct Mat44
 	Vec3 const		TransformPosition3D(Vec3 const& positionXYZ) const;				// assumes w=1
 	Vec4 const		TransformHomogeneous3D(Vec4 const& homogeneousPoint3D) const;		// w is provided
 
+	// batches of count, strides in bytes so positions can be transformed in place inside vertexes
+	void			TransformPositions3D(Vec3 const* positions, Vec3* out_positions, int count, int positionStride = sizeof(Vec3), int outPositionStride = sizeof(Vec3)) const;
+	void			TransformVectorQuantities3D(Vec3 const* vectorQuantities, Vec3* out_vectorQuantities, int count, int vectorStride = sizeof(Vec3), int outVectorStride = sizeof(Vec3)) const;
+
 	float*			GetAsFloatArray();			// non-const (mutable version)
 	float const*	GetAsFloatArray() const;	// const version, used only when Mat44 is const
 	Vec2 const		GetIBasis2D() const;
@@ -60,6 +66,7 @@ struct Mat44
 	void SetIJKT4D( Vec4 const& iBasis4D, Vec4 const& jBasis4D, Vec4 const& kBasis4D, Vec4 const& translation4D );	// 
 	
 	void Append( Mat44 const& appendThis );							// Multiply on right in column notation / on left in row notation
+	static void AppendEach( Mat44 const* matrices, Mat44 const* appendMatrices, Mat44* out_matrices, int count ); // out_matrices[n] = matrices[n] with appendMatrices[n] appended; out may be either input
 	void AppendZRotation( float degreesRotationAboutZ );			// same as appending (*= in column notation) a z-rotation matrix
 	void AppendYRotation( float degreesRotationAboutY );			// same as appending (*= in column notation) a y-rotation matrix
 	void AppendXRotation( float degreesRotationAboutX );			// same as appending (*= in column notation) a x-rotation matrix
@@ -76,4 +83,59 @@ struct Mat44
 
 	static Mat44 CreateOrthoProjection(float left, float right, float bottom, float top, float zNear, float zFar);
 	static Mat44 CreatePerspectiveProjection(float fovYDegrees, float aspect, float zNear, float zFar);
-};
\ No newline at end of file
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Inline so the hot paths compile into their callers; same arithmetic, in the same order, as the
+// scalar code they replaced, one basis per SSE register
+//----------------------------------------------------------------------------------------------------------
+inline Vec3 const Mat44::TransformVectorQuantity3D(Vec3 const& vectorQuantityXYZ) const
+{
+	__m128 result = _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( m_values + Ix ), _mm_set1_ps( vectorQuantityXYZ.x ) ), _mm_mul_ps( _mm_loadu_ps( m_values + Jx ), _mm_set1_ps( vectorQuantityXYZ.y ) ) );
+	result		  = _mm_add_ps( result, _mm_mul_ps( _mm_loadu_ps( m_values + Kx ), _mm_set1_ps( vectorQuantityXYZ.z ) ) );
+
+	Vec3 transformed;
+	SIMDStoreVec3( transformed, result );
+	return transformed;
+}
+
+inline Vec3 const Mat44::TransformPosition3D(Vec3 const& positionXYZ) const
+{
+	__m128 result = SIMDTransformByColumns( _mm_loadu_ps( m_values + Ix ), _mm_loadu_ps( m_values + Jx ), _mm_loadu_ps( m_values + Kx ), _mm_loadu_ps( m_values + Tx ),
+		positionXYZ.x, positionXYZ.y, positionXYZ.z, 1.f );
+
+	Vec3 transformed;
+	SIMDStoreVec3( transformed, result );
+	return transformed;
+}
+
+inline Vec4 const Mat44::TransformHomogeneous3D(Vec4 const& homogeneousPoint3D) const
+{
+	__m128 result = SIMDTransformByColumns( _mm_loadu_ps( m_values + Ix ), _mm_loadu_ps( m_values + Jx ), _mm_loadu_ps( m_values + Kx ), _mm_loadu_ps( m_values + Tx ),
+		homogeneousPoint3D.x, homogeneousPoint3D.y, homogeneousPoint3D.z, homogeneousPoint3D.w );
+
+	Vec4 transformed;
+	_mm_storeu_ps( &transformed.x, result );
+	return transformed;
+}
+
+inline void Mat44::Append(Mat44 const& appendThis)
+{
+	__m128 iBasis	   = _mm_loadu_ps( m_values + Ix );
+	__m128 jBasis	   = _mm_loadu_ps( m_values + Jx );
+	__m128 kBasis	   = _mm_loadu_ps( m_values + Kx );
+	__m128 translation = _mm_loadu_ps( m_values + Tx );
+
+	// appendThis may be this matrix, so every column is computed before any is stored
+	float const* append			= appendThis.m_values;
+	__m128		 newIBasis		= SIMDTransformByColumns( iBasis, jBasis, kBasis, translation, append[Ix], append[Iy], append[Iz], append[Iw] );
+	__m128		 newJBasis		= SIMDTransformByColumns( iBasis, jBasis, kBasis, translation, append[Jx], append[Jy], append[Jz], append[Jw] );
+	__m128		 newKBasis		= SIMDTransformByColumns( iBasis, jBasis, kBasis, translation, append[Kx], append[Ky], append[Kz], append[Kw] );
+	__m128		 newTranslation = SIMDTransformByColumns( iBasis, jBasis, kBasis, translation, append[Tx], append[Ty], append[Tz], append[Tw] );
+
+	_mm_storeu_ps( m_values + Ix, newIBasis );
+	_mm_storeu_ps( m_values + Jx, newJBasis );
+	_mm_storeu_ps( m_values + Kx, newKBasis );
+	_mm_storeu_ps( m_values + Tx, newTranslation );
+}
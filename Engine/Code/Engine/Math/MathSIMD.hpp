@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Engine/Math/Vec3.hpp"
+
+#include <emmintrin.h>
+
+
+//----------------------------------------------------------------------------------------------------------
+// Inline SSE2 building blocks for the math types and the kernels built on them. Registers hold
+// x, y, z, w in lanes 0 to 3; a Vec3 loads with w = 0. Each helper does the same float operations
+// in the same order as the scalar function it stands in for, so results match it bit for bit.
+//----------------------------------------------------------------------------------------------------------
+inline __m128 SIMDLoadVec3( Vec3 const& vector )
+{
+	return _mm_set_ps( 0.f, vector.z, vector.y, vector.x );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// writes exactly the 12 bytes of the Vec3, so it's safe on the last element of an array
+inline void SIMDStoreVec3( Vec3& out_vector, __m128 value )
+{
+	_mm_storel_pi( reinterpret_cast<__m64*>( &out_vector.x ), value );
+	_mm_store_ss( &out_vector.z, _mm_movehl_ps( value, value ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+inline __m128 SIMDSplatW( __m128 value )
+{
+	return _mm_shuffle_ps( value, value, _MM_SHUFFLE( 3, 3, 3, 3 ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// ( y, z, x, w ) of a register
+inline __m128 SIMDShuffleYZX( __m128 value )
+{
+	return _mm_shuffle_ps( value, value, _MM_SHUFFLE( 3, 0, 2, 1 ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// CrossProduct3D() of xyz, w comes out 0
+inline __m128 SIMDCrossProduct3( __m128 a, __m128 b )
+{
+	__m128 result = _mm_sub_ps( _mm_mul_ps( a, SIMDShuffleYZX( b ) ), _mm_mul_ps( SIMDShuffleYZX( a ), b ) );
+	return SIMDShuffleYZX( result );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// In every lane; with w = 0 in either it's DotProduct3D()
+inline __m128 SIMDDotProduct4( __m128 a, __m128 b )
+{
+	__m128 product = _mm_mul_ps( a, b );
+	__m128 sum	   = _mm_add_ps( product, _mm_shuffle_ps( product, product, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+	return _mm_add_ps( sum, _mm_shuffle_ps( sum, sum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// w must be 0; zero length stays zero
+inline __m128 SIMDNormalize3( __m128 vector )
+{
+	__m128 lengthSquared = SIMDDotProduct4( vector, vector );
+	__m128 isNonZero	 = _mm_cmpgt_ps( lengthSquared, _mm_setzero_ps() );
+	return _mm_and_ps( isNonZero, _mm_div_ps( vector, _mm_sqrt_ps( lengthSquared ) ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// v + 2 * r.xyz x ( r.xyz x v + r.w * v ); cheaper than Quaternion::operator*( Vec3 ) but rounds differently
+inline __m128 SIMDRotateByUnitQuaternion( __m128 rotation, __m128 vector )
+{
+	__m128 rotationW	  = SIMDSplatW( rotation );
+	__m128 rotationXYZ	  = _mm_and_ps( rotation, _mm_castsi128_ps( _mm_set_epi32( 0, -1, -1, -1 ) ) );
+	__m128 innerCross	  = _mm_add_ps( SIMDCrossProduct3( rotationXYZ, vector ), _mm_mul_ps( rotationW, vector ) );
+	__m128 doubledProduct = SIMDCrossProduct3( rotationXYZ, innerCross );
+	return _mm_add_ps( vector, _mm_add_ps( doubledProduct, doubledProduct ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// x * iBasis + y * jBasis + z * kBasis + w * translation, added up left to right as Mat44 does
+inline __m128 SIMDTransformByColumns( __m128 iBasis, __m128 jBasis, __m128 kBasis, __m128 translation, float x, float y, float z, float w )
+{
+	__m128 result = _mm_add_ps( _mm_mul_ps( iBasis, _mm_set1_ps( x ) ), _mm_mul_ps( jBasis, _mm_set1_ps( y ) ) );
+	result		  = _mm_add_ps( result, _mm_mul_ps( kBasis, _mm_set1_ps( z ) ) );
+	return _mm_add_ps( result, _mm_mul_ps( translation, _mm_set1_ps( w ) ) );
+}
@@ -208,54 +208,6 @@ Quaternion const Quaternion::operator*( float scalar ) const
 }
 
 
-//-------------------------------------------------------------------------
-// append another rotation to 'this' rotation
-// this method follow the rules of quaternion multiplication
-// i.e. if result = thisQuaternion * rotationToAppend
-// when using the result quaternion is used to rotate a vector, 'rotationToAppend' will be applied, then 'thisQuaternion' will be applied
-Quaternion const Quaternion::operator*( Quaternion const& rotationToAppend ) const
-{
-	float	   realPartOfThisQuaternion		 = w;
-	Vec3	   imaginaryPartofThisQuaternion = { x, y, z };
-
-	float	   realPartOfRotor				 = rotationToAppend.w;
-	Vec3	   imaginaryPartOfRotor			 = { rotationToAppend.x, rotationToAppend.y, rotationToAppend.z };
-
-	float	   w1w2							 = realPartOfThisQuaternion * realPartOfRotor;
-	float	   v1Dotv2						 = DotProduct3D( imaginaryPartofThisQuaternion, imaginaryPartOfRotor );
-	Vec3	   w1v2							 = realPartOfThisQuaternion * imaginaryPartOfRotor;
-	Vec3	   w2v1							 = realPartOfRotor * imaginaryPartofThisQuaternion;
-	Vec3	   v1Crossv2					 = CrossProduct3D( imaginaryPartofThisQuaternion, imaginaryPartOfRotor );
-
-	float	   scalar						 = w1w2 - v1Dotv2;
-	Vec3	   vector						 = w1v2 + w2v1 + v1Crossv2;
-
-	Quaternion result;
-	result.x = vector.x;
-	result.y = vector.y;
-	result.z = vector.z;
-	result.w = scalar;
-
-	return result;
-}
-
-
-// For reference
-// https://gabormakesgames.com/blog_quats_multiply_vec.html
-//-------------------------------------------------------------------------
-Vec3 const Quaternion::operator*( Vec3 const& vectorToRotate ) const
-{
-	Vec3 vectorPartOfQuaternion = Vec3( x, y, z );
-
-	Vec3 rotatedResult;
-	rotatedResult = ( 2.f * DotProduct3D( vectorPartOfQuaternion, vectorToRotate ) * vectorPartOfQuaternion ) +
-					( ( w * w - DotProduct3D( vectorPartOfQuaternion, vectorPartOfQuaternion ) ) * vectorToRotate ) +
-					( 2.f * w * CrossProduct3D( vectorPartOfQuaternion, vectorToRotate ) );
-
-	return rotatedResult;
-}
-
-
 //----------------------------------------------------------------------------------------------------------
 Quaternion const Quaternion::GetInverse() const
 {
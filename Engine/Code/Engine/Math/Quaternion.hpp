@@ -2,10 +2,11 @@
 
 
 #include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/MathSIMD.hpp"
+#include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/Vec4.hpp"
 
 
-struct Vec3;
 struct Mat44;
 
 //-------------------------------------------------------------------------
@@ -76,4 +77,47 @@ struct Quaternion
 
 	//----------------------------------------------------------------------------------------------------------
 	void GetAxisAndAngle( Vec3& outAxisOfRotation, float& outAngleOfRotation ) const;
-};
\ No newline at end of file
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Inline, so composing transforms doesn't call out of line for every rotation. Same arithmetic, in
+// the same order, as the scalar code these replaced
+//----------------------------------------------------------------------------------------------------------
+// append another rotation to 'this' rotation
+// this method follow the rules of quaternion multiplication
+// i.e. if result = thisQuaternion * rotationToAppend
+// when using the result quaternion is used to rotate a vector, 'rotationToAppend' will be applied, then 'thisQuaternion' will be applied
+inline Quaternion const Quaternion::operator*( Quaternion const& rotationToAppend ) const
+{
+	// vector part w1 * v2 + w2 * v1 + v1 x v2, real part w1 * w2 - v1 . v2
+	__m128 thisQuaternion = _mm_loadu_ps( &x );
+	__m128 rotor		  = _mm_loadu_ps( &rotationToAppend.x );
+	__m128 vector		  = _mm_add_ps( _mm_mul_ps( SIMDSplatW( thisQuaternion ), rotor ), _mm_mul_ps( SIMDSplatW( rotor ), thisQuaternion ) );
+	vector				  = _mm_add_ps( vector, SIMDCrossProduct3( thisQuaternion, rotor ) );
+
+	Quaternion result;
+	_mm_storeu_ps( &result.x, vector );
+	result.w = w * rotationToAppend.w - ( x * rotationToAppend.x + y * rotationToAppend.y + z * rotationToAppend.z );
+	return result;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// For reference
+// https://gabormakesgames.com/blog_quats_multiply_vec.html
+inline Vec3 const Quaternion::operator*( Vec3 const& vectorToRotate ) const
+{
+	// 2 ( v . r ) v + ( w^2 - v . v ) r + 2 w ( v x r )
+	float  vectorDotRotated = x * vectorToRotate.x + y * vectorToRotate.y + z * vectorToRotate.z;
+	float  vectorDotVector	= x * x + y * y + z * z;
+	__m128 vectorPart		= _mm_set_ps( 0.f, z, y, x );
+	__m128 toRotate			= SIMDLoadVec3( vectorToRotate );
+
+	__m128 rotated = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( 2.f * vectorDotRotated ), vectorPart ), _mm_mul_ps( _mm_set1_ps( w * w - vectorDotVector ), toRotate ) );
+	rotated		   = _mm_add_ps( rotated, _mm_mul_ps( _mm_set1_ps( 2.f * w ), SIMDCrossProduct3( vectorPart, toRotate ) ) );
+
+	Vec3 rotatedResult;
+	SIMDStoreVec3( rotatedResult, rotated );
+	return rotatedResult;
+}
@@ -0,0 +1,217 @@
+#include "Engine/Math/RaycastPacketBenchmark.hpp"
+#include "Engine/Math/ConvexPolly2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Math/RaycastPacketUtils.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <math.h>
+#include <string.h>
+
+
+//----------------------------------------------------------------------------------------------------------
+struct BenchmarkRay2D
+{
+	Vec2  m_startPos;
+	Vec2  m_fwdNormal;
+	float m_maxDistance = 0.f;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct BenchmarkRay3D
+{
+	Vec3  m_startPos;
+	Vec3  m_fwdNormal;
+	float m_maxDistance = 0.f;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+static float volatile s_impactDistSink = 0.f; // the timed casts sum their distances into it, so they can't be dropped as unused
+
+
+//----------------------------------------------------------------------------------------------------------
+static void LogToDevConsole( Rgba8 const& color, std::string const& text )
+{
+	if ( g_theDevConsole )
+	{
+		g_theDevConsole->AddLine( color, text );
+	}
+	else
+	{
+		DebuggerPrintf( "%s\n", text.c_str() );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Checks every lane against the scalar cast of its ray, then times both over the same rays.
+// numRays has to be a multiple of RAY_PACKET_WIDTH
+template <typename T_Ray, typename T_Packet, typename T_ScalarCast, typename T_PacketCast>
+static RaycastPacketBenchmarkShapeResult RunShape( char const* shapeName, std::vector<T_Ray> const& rays, int numRepeats, T_ScalarCast scalarCast,
+	T_PacketCast packetCast )
+{
+	RaycastPacketBenchmarkShapeResult result;
+	result.m_shapeName = shapeName;
+
+	int					  numRays = ( int ) rays.size();
+	std::vector<T_Packet> packets( numRays / RAY_PACKET_WIDTH );
+	for ( int rayIndex = 0; rayIndex < numRays; rayIndex++ )
+	{
+		T_Ray const& ray = rays[ rayIndex ];
+		packets[ rayIndex / RAY_PACKET_WIDTH ].SetRay( rayIndex % RAY_PACKET_WIDTH, ray.m_startPos, ray.m_fwdNormal, ray.m_maxDistance );
+	}
+
+	for ( int packetIndex = 0; packetIndex < ( int ) packets.size(); packetIndex++ )
+	{
+		RayPacketResult packetResult = packetCast( packets[ packetIndex ] );
+		for ( int lane = 0; lane < RAY_PACKET_WIDTH; lane++ )
+		{
+			auto scalarResult = scalarCast( rays[ packetIndex * RAY_PACKET_WIDTH + lane ] );
+			bool didImpact	  = packetResult.DidImpact( lane );
+			bool isSameDist	  = memcmp( &packetResult.m_impactDist[ lane ], &scalarResult.m_impactDist, sizeof( float ) ) == 0;
+			result.m_numHits += scalarResult.m_didImpact ? 1 : 0;
+			result.m_numMismatches += ( didImpact != scalarResult.m_didImpact || ( didImpact && !isSameDist ) ) ? 1 : 0;
+		}
+	}
+
+	float  distanceSum	= 0.f;
+	double millionRays	= ( double ) numRays * ( double ) numRepeats / 1.0e6;
+	double startSeconds = GetCurrentTimeSeconds();
+	for ( int repeatIndex = 0; repeatIndex < numRepeats; repeatIndex++ )
+	{
+		for ( T_Ray const& ray : rays )
+		{
+			distanceSum += scalarCast( ray ).m_impactDist;
+		}
+	}
+	result.m_scalarMillionRaysPerSecond = millionRays / ( GetCurrentTimeSeconds() - startSeconds );
+
+	startSeconds = GetCurrentTimeSeconds();
+	for ( int repeatIndex = 0; repeatIndex < numRepeats; repeatIndex++ )
+	{
+		for ( T_Packet const& packet : packets )
+		{
+			distanceSum += packetCast( packet ).m_impactDist[ 0 ];
+		}
+	}
+	result.m_packetMillionRaysPerSecond = millionRays / ( GetCurrentTimeSeconds() - startSeconds );
+
+	s_impactDistSink = distanceSum;
+	return result;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+std::vector<RaycastPacketBenchmarkShapeResult> RunRaycastPacketBenchmark( RaycastPacketBenchmarkSettings const& settings )
+{
+	RandomNumberGenerator rng;
+	rng.SetSeed( settings.m_seed );
+
+	int numRays = settings.m_numRays - settings.m_numRays % RAY_PACKET_WIDTH;
+
+	std::vector<BenchmarkRay2D> rays2D( numRays );
+	for ( BenchmarkRay2D& ray : rays2D )
+	{
+		ray.m_startPos	  = Vec2( rng.RollRandomFloatInRange( -10.f, 10.f ), rng.RollRandomFloatInRange( -10.f, 10.f ) );
+		ray.m_fwdNormal	  = Vec2::MakeFromPolarDegrees( rng.RollRandomFloatInRange( 0.f, 360.f ) );
+		ray.m_maxDistance = rng.RollRandomFloatInRange( 1.f, 20.f );
+
+		int axisRoll = rng.RollRandomIntLessThan( 10 );
+		if ( axisRoll == 0 )
+		{
+			ray.m_fwdNormal = Vec2( 1.f, 0.f );
+		}
+		else if ( axisRoll == 1 )
+		{
+			ray.m_fwdNormal = Vec2( 0.f, -1.f );
+		}
+	}
+
+	std::vector<BenchmarkRay3D> rays3D( numRays );
+	for ( BenchmarkRay3D& ray : rays3D )
+	{
+		ray.m_startPos	  = Vec3( rng.RollRandomFloatInRange( -10.f, 10.f ), rng.RollRandomFloatInRange( -10.f, 10.f ), rng.RollRandomFloatInRange( -10.f, 10.f ) );
+		ray.m_fwdNormal	  = Vec3( rng.RollRandomFloatInRange( -1.f, 1.f ), rng.RollRandomFloatInRange( -1.f, 1.f ), rng.RollRandomFloatInRange( -1.f, 1.f ) ).GetNormalized();
+		ray.m_maxDistance = rng.RollRandomFloatInRange( 1.f, 20.f );
+
+		int axisRoll = rng.RollRandomIntLessThan( 10 );
+		if ( axisRoll == 0 )
+		{
+			ray.m_fwdNormal = Vec3( 0.f, 0.f, 1.f );
+		}
+		else if ( axisRoll == 1 )
+		{
+			ray.m_fwdNormal = Vec3( 0.f, -1.f, 0.f );
+		}
+	}
+
+	Vec2			  discCenter  = Vec2( 1.f, 2.f );
+	float			  discRadius  = 3.f;
+	AABB2			  box2D		  = AABB2( -2.f, -1.f, 3.f, 4.f );
+	Vec2			  planeNormal = Vec2( 0.6f, 0.8f );
+	std::vector<Vec2> hullPoints;
+	for ( int pointIndex = 0; pointIndex < 6; pointIndex++ )
+	{
+		hullPoints.push_back( discCenter + Vec2::MakeFromPolarDegrees( 60.f * ( float ) pointIndex, discRadius ) );
+	}
+	ConvexHull2 hull2D = ConvexHull2( ConvexPolly2( hullPoints ) );
+
+	AABB3		box3D		  = AABB3( -2.f, -1.f, -3.f, 3.f, 4.f, 2.f );
+	Vec3		planeNormal3D = Vec3( 1.f, 2.f, 2.f ) * ( 1.f / 3.f );
+	ConvexHull3 hull3D		  = ConvexHull3( box3D );
+
+	std::vector<RaycastPacketBenchmarkShapeResult> results;
+	results.push_back( RunShape<BenchmarkRay2D, RayPacket2D>( "disc2D", rays2D, settings.m_numRepeats,
+		[ & ]( BenchmarkRay2D const& ray ) { return RaycastVsDisc2D( ray.m_startPos, ray.m_fwdNormal, ray.m_maxDistance, discCenter, discRadius ); },
+		[ & ]( RayPacket2D const& rays ) { return RaycastPacketVsDisc2D( rays, discCenter, discRadius ); } ) );
+	results.push_back( RunShape<BenchmarkRay2D, RayPacket2D>( "AABB2D", rays2D, settings.m_numRepeats,
+		[ & ]( BenchmarkRay2D const& ray ) { return RaycastVsAABB2D( ray.m_startPos, ray.m_fwdNormal, ray.m_maxDistance, box2D ); },
+		[ & ]( RayPacket2D const& rays ) { return RaycastPacketVsAABB2D( rays, box2D ); } ) );
+	results.push_back( RunShape<BenchmarkRay2D, RayPacket2D>( "plane2D", rays2D, settings.m_numRepeats,
+		[ & ]( BenchmarkRay2D const& ray ) { return RaycastVsPlane2D( ray.m_startPos, ray.m_fwdNormal, ray.m_maxDistance, planeNormal, 1.5f ); },
+		[ & ]( RayPacket2D const& rays ) { return RaycastPacketVsPlane2D( rays, planeNormal, 1.5f ); } ) );
+	results.push_back( RunShape<BenchmarkRay2D, RayPacket2D>( "hull2D", rays2D, settings.m_numRepeats,
+		[ & ]( BenchmarkRay2D const& ray ) { return RaycastVsConvexHull2D( ray.m_startPos, ray.m_fwdNormal, ray.m_maxDistance, hull2D, discCenter, discRadius ); },
+		[ & ]( RayPacket2D const& rays ) { return RaycastPacketVsConvexHull2D( rays, hull2D, discCenter, discRadius ); } ) );
+	results.push_back( RunShape<BenchmarkRay3D, RayPacket3D>( "AABB3D", rays3D, settings.m_numRepeats,
+		[ & ]( BenchmarkRay3D const& ray ) { return RaycastVsAABB3D( ray.m_startPos, ray.m_fwdNormal, ray.m_maxDistance, box3D ); },
+		[ & ]( RayPacket3D const& rays ) { return RaycastPacketVsAABB3D( rays, box3D ); } ) );
+	results.push_back( RunShape<BenchmarkRay3D, RayPacket3D>( "plane3D", rays3D, settings.m_numRepeats,
+		[ & ]( BenchmarkRay3D const& ray ) { return RaycastVsPlane3D( ray.m_startPos, ray.m_fwdNormal, ray.m_maxDistance, planeNormal3D, 1.f ); },
+		[ & ]( RayPacket3D const& rays ) { return RaycastPacketVsPlane3D( rays, planeNormal3D, 1.f ); } ) );
+	results.push_back( RunShape<BenchmarkRay3D, RayPacket3D>( "hull3D", rays3D, settings.m_numRepeats,
+		[ & ]( BenchmarkRay3D const& ray ) { return RaycastVsConvexHull3D( ray.m_startPos, ray.m_fwdNormal, ray.m_maxDistance, hull3D ); },
+		[ & ]( RayPacket3D const& rays ) { return RaycastPacketVsConvexHull3D( rays, hull3D ); } ) );
+	return results;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+bool Command_RayPacketBench( EventArgs& args )
+{
+	RaycastPacketBenchmarkSettings settings;
+	settings.m_numRays = args.GetValue( "Rays", settings.m_numRays );
+	if ( settings.m_numRays < RAY_PACKET_WIDTH )
+	{
+		LogToDevConsole( DevConsole::ERROR_COLOR, Stringf( "RayPacketBench: Rays has to be at least %d", RAY_PACKET_WIDTH ) );
+		return true;
+	}
+
+	std::vector<RaycastPacketBenchmarkShapeResult> results = RunRaycastPacketBenchmark( settings );
+	LogToDevConsole( DevConsole::INFO_MAJOR_COLOR, Stringf( "RayPacketBench: %d rays per shape, %d wide; million rays per second:", settings.m_numRays, RAY_PACKET_WIDTH ) );
+	for ( RaycastPacketBenchmarkShapeResult const& result : results )
+	{
+		Rgba8 color = result.m_numMismatches == 0 ? DevConsole::INFO_MINOR_COLOR : DevConsole::ERROR_COLOR;
+		LogToDevConsole( color, Stringf( "  %-8s scalar %6.1f, packet %6.1f ( x%.1f ); %d hits, %d lanes differ from scalar", result.m_shapeName.c_str(),
+			result.m_scalarMillionRaysPerSecond, result.m_packetMillionRaysPerSecond, result.m_packetMillionRaysPerSecond / result.m_scalarMillionRaysPerSecond,
+			result.m_numHits, result.m_numMismatches ) );
+	}
+	return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <string>
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------------
+struct RaycastPacketBenchmarkSettings
+{
+	int			 m_numRays	  = 200000; // per shape; one in ten runs along an axis
+	int			 m_numRepeats = 20;
+	unsigned int m_seed		  = 7;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct RaycastPacketBenchmarkShapeResult
+{
+	std::string m_shapeName;
+	double		m_scalarMillionRaysPerSecond = 0.0;
+	double		m_packetMillionRaysPerSecond = 0.0;
+	int			m_numHits					 = 0;
+	int			m_numMismatches				 = 0; // lanes whose hit or impact distance isn't bit for bit the scalar one
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Rays per second cast one at a time with RaycastUtils and RAY_PACKET_WIDTH at a time with
+// RaycastPacketUtils, against a disc, box, plane and hull in 2D and a box, plane and hull in 3D.
+// Rays start inside and outside the shapes, in random directions and along the axes
+std::vector<RaycastPacketBenchmarkShapeResult> RunRaycastPacketBenchmark( RaycastPacketBenchmarkSettings const& settings );
+
+// "RayPacketBench Rays=200000"; logs millions of rays per second and mismatches for each shape
+// DevConsole::Startup() subscribes it
+bool Command_RayPacketBench( EventArgs& args );
@@ -0,0 +1,408 @@
+#include "Engine/Math/RaycastPacketUtils.hpp"
+
+#include <emmintrin.h>
+
+
+//----------------------------------------------------------------------------------------------------------
+// Every kernel does the arithmetic of its scalar function in the same order, so each lane rounds
+// the same way the scalar function does; a branch of the scalar function becomes a lane mask
+constexpr float RAY_PACKET_HULL_EPSILON = 0.00001f; // how far IsPointInsideConvexHull2D() and 3D() let a point be in front of a plane
+
+
+//----------------------------------------------------------------------------------------------------------
+struct RayLanes2D
+{
+	__m128 m_startX;
+	__m128 m_startY;
+	__m128 m_fwdX;
+	__m128 m_fwdY;
+	__m128 m_maxDistance;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct RayLanes3D
+{
+	__m128 m_startX;
+	__m128 m_startY;
+	__m128 m_startZ;
+	__m128 m_fwdX;
+	__m128 m_fwdY;
+	__m128 m_fwdZ;
+	__m128 m_maxDistance;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+static RayLanes2D LoadRays( RayPacket2D const& rays )
+{
+	return { _mm_load_ps( rays.m_startX ), _mm_load_ps( rays.m_startY ), _mm_load_ps( rays.m_fwdX ), _mm_load_ps( rays.m_fwdY ), _mm_load_ps( rays.m_maxDistance ) };
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static RayLanes3D LoadRays( RayPacket3D const& rays )
+{
+	return { _mm_load_ps( rays.m_startX ), _mm_load_ps( rays.m_startY ), _mm_load_ps( rays.m_startZ ), _mm_load_ps( rays.m_fwdX ), _mm_load_ps( rays.m_fwdY ),
+		_mm_load_ps( rays.m_fwdZ ), _mm_load_ps( rays.m_maxDistance ) };
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static __m128 Select( __m128 mask, __m128 ifTrue, __m128 ifFalse )
+{
+	return _mm_or_ps( _mm_and_ps( mask, ifTrue ), _mm_andnot_ps( mask, ifFalse ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static __m128 Not( __m128 mask )
+{
+	return _mm_xor_ps( mask, _mm_castsi128_ps( _mm_set1_epi32( -1 ) ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static __m128 Negate( __m128 value )
+{
+	return _mm_xor_ps( value, _mm_set1_ps( -0.f ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static __m128 DotProduct2( __m128 ax, __m128 ay, __m128 bx, __m128 by )
+{
+	return _mm_add_ps( _mm_mul_ps( ax, bx ), _mm_mul_ps( ay, by ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static __m128 DotProduct3( __m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz )
+{
+	return _mm_add_ps( _mm_add_ps( _mm_mul_ps( ax, bx ), _mm_mul_ps( ay, by ) ), _mm_mul_ps( az, bz ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static RayPacketResult MakeResult( __m128 hitMask, __m128 impactDist )
+{
+	RayPacketResult result;
+	_mm_store_ps( result.m_impactDist, _mm_and_ps( hitMask, impactDist ) );
+	result.m_hitMask = _mm_movemask_ps( hitMask );
+	return result;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void RayPacket2D::SetRay( int lane, Vec2 const& rayStartPos, Vec2 const& rayFwdNormal, float rayMaxDistance )
+{
+	m_startX[ lane ]	  = rayStartPos.x;
+	m_startY[ lane ]	  = rayStartPos.y;
+	m_fwdX[ lane ]		  = rayFwdNormal.x;
+	m_fwdY[ lane ]		  = rayFwdNormal.y;
+	m_maxDistance[ lane ] = rayMaxDistance;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void RayPacket3D::SetRay( int lane, Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance )
+{
+	m_startX[ lane ]	  = rayStartPos.x;
+	m_startY[ lane ]	  = rayStartPos.y;
+	m_startZ[ lane ]	  = rayStartPos.z;
+	m_fwdX[ lane ]		  = rayFwdNormal.x;
+	m_fwdY[ lane ]		  = rayFwdNormal.y;
+	m_fwdZ[ lane ]		  = rayFwdNormal.z;
+	m_maxDistance[ lane ] = rayMaxDistance;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// RaycastVsPlane2D() on every lane. out_startDotNormal is the start's dot product with the plane
+// normal, for the in front of plane test of the hull raycast
+static __m128 RaycastLanesVsPlane2D( RayLanes2D const& ray, Vec2 const& planeNormal, float planeDistanceFromOrigin, __m128& out_impactDist, __m128& out_startDotNormal )
+{
+	__m128 normalX		 = _mm_set1_ps( planeNormal.x );
+	__m128 normalY		 = _mm_set1_ps( planeNormal.y );
+	__m128 planeDistance = _mm_set1_ps( planeDistanceFromOrigin );
+
+	__m128 startDotNormal	  = DotProduct2( ray.m_startX, ray.m_startY, normalX, normalY );
+	__m128 startPointAltitude = _mm_sub_ps( startDotNormal, planeDistance );
+	__m128 endX				  = _mm_add_ps( ray.m_startX, _mm_mul_ps( ray.m_fwdX, ray.m_maxDistance ) );
+	__m128 endY				  = _mm_add_ps( ray.m_startY, _mm_mul_ps( ray.m_fwdY, ray.m_maxDistance ) );
+	__m128 endPointAltitude	  = _mm_sub_ps( DotProduct2( endX, endY, normalX, normalY ), planeDistance );
+	__m128 crossesPlane		  = _mm_cmplt_ps( _mm_mul_ps( startPointAltitude, endPointAltitude ), _mm_setzero_ps() );
+
+	Vec2   normalizedNormal	  = planeNormal.GetNormalized();
+	__m128 projectedFwdLength = DotProduct2( ray.m_fwdX, ray.m_fwdY, _mm_set1_ps( normalizedNormal.x ), _mm_set1_ps( normalizedNormal.y ) );
+
+	out_impactDist	   = Negate( _mm_div_ps( startPointAltitude, projectedFwdLength ) );
+	out_startDotNormal = startDotNormal;
+	return crossesPlane;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// IsPointInsideConvexHull2D() on every lane
+static __m128 AreLanesInsideConvexHull2D( __m128 pointX, __m128 pointY, ConvexHull2 const& convexHull, Vec2 const& boundingDiscCenter, float boundingDiscRadius )
+{
+	__m128 displacementX = _mm_sub_ps( pointX, _mm_set1_ps( boundingDiscCenter.x ) );
+	__m128 displacementY = _mm_sub_ps( pointY, _mm_set1_ps( boundingDiscCenter.y ) );
+	__m128 isInside		 = _mm_cmple_ps( DotProduct2( displacementX, displacementY, displacementX, displacementY ), _mm_set1_ps( boundingDiscRadius * boundingDiscRadius ) );
+
+	for ( int planeIndex = 0; planeIndex < ( int ) convexHull.m_boundingPlanes.size() && _mm_movemask_ps( isInside ) != 0; planeIndex++ )
+	{
+		Plane2 const& plane			= convexHull.m_boundingPlanes[ planeIndex ];
+		__m128		  pointAltitude = DotProduct2( pointX, pointY, _mm_set1_ps( plane.m_normal.x ), _mm_set1_ps( plane.m_normal.y ) );
+		isInside					= _mm_and_ps( isInside, _mm_cmple_ps( pointAltitude, _mm_set1_ps( plane.m_distanceFromOrigin + RAY_PACKET_HULL_EPSILON ) ) );
+	}
+	return isInside;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// IsPointInsideConvexHull3D() on every lane
+static __m128 AreLanesInsideConvexHull3D( __m128 pointX, __m128 pointY, __m128 pointZ, ConvexHull3 const& convexHull )
+{
+	__m128 isInside = _mm_castsi128_ps( _mm_set1_epi32( -1 ) );
+	for ( int planeIndex = 0; planeIndex < ( int ) convexHull.m_boundingPlanes.size() && _mm_movemask_ps( isInside ) != 0; planeIndex++ )
+	{
+		Plane3 const& plane			= convexHull.m_boundingPlanes[ planeIndex ];
+		__m128		  pointAltitude = DotProduct3( pointX, pointY, pointZ, _mm_set1_ps( plane.m_normal.x ), _mm_set1_ps( plane.m_normal.y ), _mm_set1_ps( plane.m_normal.z ) );
+		isInside					= _mm_and_ps( isInside, _mm_cmple_ps( pointAltitude, _mm_set1_ps( plane.m_distanceFromOrigin + RAY_PACKET_HULL_EPSILON ) ) );
+	}
+	return isInside;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// RaycastVsPlane3D() on every lane, as RaycastLanesVsPlane2D()
+static __m128 RaycastLanesVsPlane3D( RayLanes3D const& ray, Vec3 const& planeNormal, float planeDistanceFromOrigin, __m128& out_impactDist, __m128& out_startDotNormal )
+{
+	__m128 normalX		 = _mm_set1_ps( planeNormal.x );
+	__m128 normalY		 = _mm_set1_ps( planeNormal.y );
+	__m128 normalZ		 = _mm_set1_ps( planeNormal.z );
+	__m128 planeDistance = _mm_set1_ps( planeDistanceFromOrigin );
+
+	__m128 startDotNormal	  = DotProduct3( ray.m_startX, ray.m_startY, ray.m_startZ, normalX, normalY, normalZ );
+	__m128 startPointAltitude = _mm_sub_ps( startDotNormal, planeDistance );
+	__m128 endX				  = _mm_add_ps( ray.m_startX, _mm_mul_ps( ray.m_fwdX, ray.m_maxDistance ) );
+	__m128 endY				  = _mm_add_ps( ray.m_startY, _mm_mul_ps( ray.m_fwdY, ray.m_maxDistance ) );
+	__m128 endZ				  = _mm_add_ps( ray.m_startZ, _mm_mul_ps( ray.m_fwdZ, ray.m_maxDistance ) );
+	__m128 endPointAltitude	  = _mm_sub_ps( DotProduct3( endX, endY, endZ, normalX, normalY, normalZ ), planeDistance );
+	__m128 crossesPlane		  = _mm_cmplt_ps( _mm_mul_ps( startPointAltitude, endPointAltitude ), _mm_setzero_ps() );
+
+	Vec3   normalizedNormal	  = planeNormal.GetNormalized();
+	__m128 projectedFwdLength = DotProduct3( ray.m_fwdX, ray.m_fwdY, ray.m_fwdZ, _mm_set1_ps( normalizedNormal.x ), _mm_set1_ps( normalizedNormal.y ), _mm_set1_ps( normalizedNormal.z ) );
+
+	out_impactDist	   = Negate( _mm_div_ps( startPointAltitude, projectedFwdLength ) );
+	out_startDotNormal = startDotNormal;
+	return crossesPlane;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+RayPacketResult RaycastPacketVsDisc2D( RayPacket2D const& rays, Vec2 const& discCenter, float discRadius )
+{
+	RayLanes2D ray			 = LoadRays( rays );
+	__m128	   centerX		 = _mm_set1_ps( discCenter.x );
+	__m128	   centerY		 = _mm_set1_ps( discCenter.y );
+	__m128	   radius		 = _mm_set1_ps( discRadius );
+	__m128	   negRadius	 = _mm_set1_ps( -discRadius );
+	__m128	   radiusSquared = _mm_set1_ps( discRadius * discRadius );
+
+	// the disc center along and to the left of the ray
+	__m128 displacementX = _mm_sub_ps( centerX, ray.m_startX );
+	__m128 displacementY = _mm_sub_ps( centerY, ray.m_startY );
+	__m128 SCj			 = DotProduct2( displacementX, displacementY, Negate( ray.m_fwdY ), ray.m_fwdX );
+	__m128 SCi			 = DotProduct2( displacementX, displacementY, ray.m_fwdX, ray.m_fwdY );
+
+	__m128 overlapsSideways = _mm_and_ps( _mm_cmplt_ps( SCj, radius ), _mm_cmpgt_ps( SCj, negRadius ) );
+	__m128 overlapsAlong	= _mm_and_ps( _mm_cmpgt_ps( SCi, negRadius ), _mm_cmplt_ps( SCi, _mm_add_ps( ray.m_maxDistance, radius ) ) );
+
+	__m128 startDisplacementX = _mm_sub_ps( ray.m_startX, centerX );
+	__m128 startDisplacementY = _mm_sub_ps( ray.m_startY, centerY );
+	__m128 startIsInside	  = _mm_cmple_ps( DotProduct2( startDisplacementX, startDisplacementY, startDisplacementX, startDisplacementY ), radiusSquared );
+
+	__m128 rayInsideCircle = _mm_sqrt_ps( _mm_sub_ps( radiusSquared, _mm_mul_ps( SCj, SCj ) ) ); // NaN on lanes that miss sideways
+	__m128 impactDist	   = _mm_sub_ps( SCi, rayInsideCircle );
+	__m128 impactIsOnRay   = _mm_and_ps( _mm_cmpgt_ps( impactDist, _mm_setzero_ps() ), _mm_cmplt_ps( impactDist, ray.m_maxDistance ) );
+
+	__m128 hitMask = _mm_and_ps( _mm_and_ps( overlapsSideways, overlapsAlong ), _mm_or_ps( startIsInside, impactIsOnRay ) );
+	return MakeResult( hitMask, _mm_andnot_ps( startIsInside, impactDist ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+RayPacketResult RaycastPacketVsAABB2D( RayPacket2D const& rays, AABB2 const& bounds )
+{
+	RayLanes2D	 ray			= LoadRays( rays );
+	__m128 const startPos[ 2 ]	= { ray.m_startX, ray.m_startY };
+	__m128 const fwdNormal[ 2 ] = { ray.m_fwdX, ray.m_fwdY };
+	float const	 mins[ 2 ]		= { bounds.m_mins.x, bounds.m_mins.y };
+	float const	 maxs[ 2 ]		= { bounds.m_maxs.x, bounds.m_maxs.y };
+
+	__m128 zero			 = _mm_setzero_ps();
+	__m128 entryDistance = zero;
+	__m128 exitDistance	 = ray.m_maxDistance;
+	__m128 missesSlab	 = zero;
+	for ( int axis = 0; axis < 2; axis++ )
+	{
+		__m128 slabMin = _mm_set1_ps( mins[ axis ] );
+		__m128 slabMax = _mm_set1_ps( maxs[ axis ] );
+
+		// parallel to the slab, the start has to be between its lines
+		__m128 isParallel = _mm_cmpeq_ps( fwdNormal[ axis ], zero );
+		missesSlab		  = _mm_or_ps( missesSlab, _mm_and_ps( isParallel, _mm_or_ps( _mm_cmplt_ps( startPos[ axis ], slabMin ), _mm_cmpgt_ps( startPos[ axis ], slabMax ) ) ) );
+
+		__m128 inverseFwd	   = _mm_div_ps( _mm_set1_ps( 1.f ), fwdNormal[ axis ] );
+		__m128 minLineDistance = _mm_mul_ps( _mm_sub_ps( slabMin, startPos[ axis ] ), inverseFwd );
+		__m128 maxLineDistance = _mm_mul_ps( _mm_sub_ps( slabMax, startPos[ axis ] ), inverseFwd );
+		__m128 isFwdPositive   = _mm_cmpgt_ps( inverseFwd, zero );
+		__m128 slabEntry	   = Select( isFwdPositive, minLineDistance, maxLineDistance );
+		__m128 slabExit		   = Select( isFwdPositive, maxLineDistance, minLineDistance );
+
+		entryDistance = Select( _mm_andnot_ps( isParallel, _mm_cmpgt_ps( slabEntry, entryDistance ) ), slabEntry, entryDistance );
+		exitDistance  = Select( _mm_andnot_ps( isParallel, _mm_cmplt_ps( slabExit, exitDistance ) ), slabExit, exitDistance );
+	}
+
+	__m128 hitMask = Not( _mm_or_ps( missesSlab, _mm_cmpgt_ps( entryDistance, exitDistance ) ) );
+	return MakeResult( hitMask, entryDistance );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+RayPacketResult RaycastPacketVsPlane2D( RayPacket2D const& rays, Vec2 const& planeNormal, float planeDistanceFromOrigin )
+{
+	RayLanes2D ray = LoadRays( rays );
+	__m128	   impactDist;
+	__m128	   startDotNormal;
+	__m128	   hitMask = RaycastLanesVsPlane2D( ray, planeNormal, planeDistanceFromOrigin, impactDist, startDotNormal );
+	return MakeResult( hitMask, impactDist );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// The furthest plane the ray enters through is the only one it can enter the hull through
+RayPacketResult RaycastPacketVsConvexHull2D( RayPacket2D const& rays, ConvexHull2 const& convexHull, Vec2 const& boundingDiscCenter, float boundingDiscRadius,
+	bool useNarrowPhaseDiscOptimization )
+{
+	RayLanes2D ray			 = LoadRays( rays );
+	__m128	   startIsInside = _mm_setzero_ps();
+	if ( useNarrowPhaseDiscOptimization )
+	{
+		startIsInside = AreLanesInsideConvexHull2D( ray.m_startX, ray.m_startY, convexHull, boundingDiscCenter, boundingDiscRadius );
+		if ( _mm_movemask_ps( startIsInside ) == ( 1 << RAY_PACKET_WIDTH ) - 1 )
+		{
+			return MakeResult( startIsInside, _mm_setzero_ps() );
+		}
+	}
+
+	__m128 hasEntry			 = _mm_setzero_ps();
+	__m128 lastEntryDistance = _mm_setzero_ps();
+	for ( int planeIndex = 0; planeIndex < ( int ) convexHull.m_boundingPlanes.size(); planeIndex++ )
+	{
+		Plane2 const& plane = convexHull.m_boundingPlanes[ planeIndex ];
+		__m128		  impactDist;
+		__m128		  startDotNormal;
+		__m128		  crossesPlane = RaycastLanesVsPlane2D( ray, plane.m_normal, plane.m_distanceFromOrigin, impactDist, startDotNormal );
+
+		__m128 isEntry			= _mm_and_ps( crossesPlane, _mm_cmpgt_ps( startDotNormal, _mm_set1_ps( plane.m_distanceFromOrigin ) ) );
+		__m128 isLastEntrySoFar = _mm_and_ps( isEntry, _mm_cmpgt_ps( impactDist, lastEntryDistance ) );
+		lastEntryDistance		= Select( isLastEntrySoFar, impactDist, lastEntryDistance );
+		hasEntry				= _mm_or_ps( hasEntry, isLastEntrySoFar );
+	}
+
+	__m128 lastEntryX		 = _mm_add_ps( ray.m_startX, _mm_mul_ps( ray.m_fwdX, lastEntryDistance ) );
+	__m128 lastEntryY		 = _mm_add_ps( ray.m_startY, _mm_mul_ps( ray.m_fwdY, lastEntryDistance ) );
+	__m128 lastEntryIsInside = AreLanesInsideConvexHull2D( lastEntryX, lastEntryY, convexHull, boundingDiscCenter, boundingDiscRadius );
+
+	__m128 hitMask = _mm_or_ps( startIsInside, _mm_and_ps( hasEntry, lastEntryIsInside ) );
+	return MakeResult( hitMask, _mm_andnot_ps( startIsInside, lastEntryDistance ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Slab test as RaycastVsAABB3D(); entry only grows and exit only shrinks, so testing them once
+// after the last slab finds the same misses as testing after every slab
+RayPacketResult RaycastPacketVsAABB3D( RayPacket3D const& rays, AABB3 const& bounds )
+{
+	RayLanes3D	 ray			= LoadRays( rays );
+	__m128 const startPos[ 3 ]	= { ray.m_startX, ray.m_startY, ray.m_startZ };
+	__m128 const fwdNormal[ 3 ] = { ray.m_fwdX, ray.m_fwdY, ray.m_fwdZ };
+	float const	 mins[ 3 ]		= { bounds.m_mins.x, bounds.m_mins.y, bounds.m_mins.z };
+	float const	 maxs[ 3 ]		= { bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_maxs.z };
+
+	__m128 zero			 = _mm_setzero_ps();
+	__m128 entryDistance = zero;
+	__m128 exitDistance	 = ray.m_maxDistance;
+	__m128 missesSlab	 = zero;
+	for ( int axis = 0; axis < 3; axis++ )
+	{
+		__m128 slabMin = _mm_set1_ps( mins[ axis ] );
+		__m128 slabMax = _mm_set1_ps( maxs[ axis ] );
+
+		// parallel to the slab, the start has to be between its planes
+		__m128 isParallel = _mm_cmpeq_ps( fwdNormal[ axis ], zero );
+		missesSlab		  = _mm_or_ps( missesSlab, _mm_and_ps( isParallel, _mm_or_ps( _mm_cmplt_ps( startPos[ axis ], slabMin ), _mm_cmpgt_ps( startPos[ axis ], slabMax ) ) ) );
+
+		__m128 inverseFwd		= _mm_div_ps( _mm_set1_ps( 1.f ), fwdNormal[ axis ] );
+		__m128 minPlaneDistance = _mm_mul_ps( _mm_sub_ps( slabMin, startPos[ axis ] ), inverseFwd );
+		__m128 maxPlaneDistance = _mm_mul_ps( _mm_sub_ps( slabMax, startPos[ axis ] ), inverseFwd );
+		__m128 isFwdPositive	= _mm_cmpgt_ps( inverseFwd, zero );
+		__m128 slabEntry		= Select( isFwdPositive, minPlaneDistance, maxPlaneDistance );
+		__m128 slabExit			= Select( isFwdPositive, maxPlaneDistance, minPlaneDistance );
+
+		entryDistance = Select( _mm_andnot_ps( isParallel, _mm_cmpgt_ps( slabEntry, entryDistance ) ), slabEntry, entryDistance );
+		exitDistance  = Select( _mm_andnot_ps( isParallel, _mm_cmplt_ps( slabExit, exitDistance ) ), slabExit, exitDistance );
+	}
+
+	__m128 hitMask = Not( _mm_or_ps( missesSlab, _mm_cmpgt_ps( entryDistance, exitDistance ) ) );
+	return MakeResult( hitMask, entryDistance );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+RayPacketResult RaycastPacketVsPlane3D( RayPacket3D const& rays, Vec3 const& planeNormal, float planeDistanceFromOrigin )
+{
+	RayLanes3D ray = LoadRays( rays );
+	__m128	   impactDist;
+	__m128	   startDotNormal;
+	__m128	   hitMask = RaycastLanesVsPlane3D( ray, planeNormal, planeDistanceFromOrigin, impactDist, startDotNormal );
+	return MakeResult( hitMask, impactDist );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+RayPacketResult RaycastPacketVsConvexHull3D( RayPacket3D const& rays, ConvexHull3 const& convexHull )
+{
+	RayLanes3D ray			 = LoadRays( rays );
+	__m128	   startIsInside = AreLanesInsideConvexHull3D( ray.m_startX, ray.m_startY, ray.m_startZ, convexHull );
+	if ( _mm_movemask_ps( startIsInside ) == ( 1 << RAY_PACKET_WIDTH ) - 1 )
+	{
+		return MakeResult( startIsInside, _mm_setzero_ps() );
+	}
+
+	__m128 hasEntry			 = _mm_setzero_ps();
+	__m128 lastEntryDistance = _mm_setzero_ps();
+	for ( int planeIndex = 0; planeIndex < ( int ) convexHull.m_boundingPlanes.size(); planeIndex++ )
+	{
+		Plane3 const& plane = convexHull.m_boundingPlanes[ planeIndex ];
+		__m128		  impactDist;
+		__m128		  startDotNormal;
+		__m128		  crossesPlane = RaycastLanesVsPlane3D( ray, plane.m_normal, plane.m_distanceFromOrigin, impactDist, startDotNormal );
+
+		__m128 isEntry			= _mm_and_ps( crossesPlane, _mm_cmpgt_ps( startDotNormal, _mm_set1_ps( plane.m_distanceFromOrigin ) ) );
+		__m128 isLastEntrySoFar = _mm_and_ps( isEntry, _mm_cmpgt_ps( impactDist, lastEntryDistance ) );
+		lastEntryDistance		= Select( isLastEntrySoFar, impactDist, lastEntryDistance );
+		hasEntry				= _mm_or_ps( hasEntry, isLastEntrySoFar );
+	}
+
+	__m128 lastEntryX		 = _mm_add_ps( ray.m_startX, _mm_mul_ps( ray.m_fwdX, lastEntryDistance ) );
+	__m128 lastEntryY		 = _mm_add_ps( ray.m_startY, _mm_mul_ps( ray.m_fwdY, lastEntryDistance ) );
+	__m128 lastEntryZ		 = _mm_add_ps( ray.m_startZ, _mm_mul_ps( ray.m_fwdZ, lastEntryDistance ) );
+	__m128 lastEntryIsInside = AreLanesInsideConvexHull3D( lastEntryX, lastEntryY, lastEntryZ, convexHull );
+
+	__m128 hitMask = _mm_or_ps( startIsInside, _mm_and_ps( hasEntry, lastEntryIsInside ) );
+	return MakeResult( hitMask, _mm_andnot_ps( startIsInside, lastEntryDistance ) );
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/ConvexHull2.hpp"
+#include "Engine/Math/ConvexHull3.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------
+// Raycasts of RAY_PACKET_WIDTH rays at once against one shape, for line of sight and visibility
+// sampling that casts many rays at the same shapes. Each lane gives exactly what the scalar
+// function in RaycastUtils gives for its ray: the same hit or miss and the same impact distance.
+// Impact positions and normals aren't computed; cast the lanes that need them again with the
+// scalar function.
+//
+//	RayPacket2D rays;
+//	for ( int lane = 0; lane < RAY_PACKET_WIDTH; lane++ )
+//	{
+//		rays.SetRay( lane, eyePos, directions[ lane ], sightDistance );
+//	}
+//	RayPacketResult result = RaycastPacketVsDisc2D( rays, discCenter, discRadius );
+//----------------------------------------------------------------------------------------------------------
+constexpr int RAY_PACKET_WIDTH = 4; // one SSE register
+
+
+//----------------------------------------------------------------------------------------------------------
+// Unused lanes can be left as they are; their results are just ignored
+struct alignas( 16 ) RayPacket2D
+{
+	float m_startX[ RAY_PACKET_WIDTH ]		= {};
+	float m_startY[ RAY_PACKET_WIDTH ]		= {};
+	float m_fwdX[ RAY_PACKET_WIDTH ]		= {};
+	float m_fwdY[ RAY_PACKET_WIDTH ]		= {};
+	float m_maxDistance[ RAY_PACKET_WIDTH ] = {};
+
+	void SetRay( int lane, Vec2 const& rayStartPos, Vec2 const& rayFwdNormal, float rayMaxDistance );
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct alignas( 16 ) RayPacket3D
+{
+	float m_startX[ RAY_PACKET_WIDTH ]		= {};
+	float m_startY[ RAY_PACKET_WIDTH ]		= {};
+	float m_startZ[ RAY_PACKET_WIDTH ]		= {};
+	float m_fwdX[ RAY_PACKET_WIDTH ]		= {};
+	float m_fwdY[ RAY_PACKET_WIDTH ]		= {};
+	float m_fwdZ[ RAY_PACKET_WIDTH ]		= {};
+	float m_maxDistance[ RAY_PACKET_WIDTH ] = {};
+
+	void SetRay( int lane, Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance );
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct alignas( 16 ) RayPacketResult
+{
+	float m_impactDist[ RAY_PACKET_WIDTH ] = {}; // 0 on lanes that missed
+	int	  m_hitMask						   = 0;	 // bit n set when lane n hit
+
+	bool DidImpact( int lane ) const { return ( m_hitMask & ( 1 << lane ) ) != 0; }
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+RayPacketResult RaycastPacketVsDisc2D( RayPacket2D const& rays, Vec2 const& discCenter, float discRadius );
+RayPacketResult RaycastPacketVsAABB2D( RayPacket2D const& rays, AABB2 const& bounds );
+RayPacketResult RaycastPacketVsPlane2D( RayPacket2D const& rays, Vec2 const& planeNormal, float planeDistanceFromOrigin );
+RayPacketResult RaycastPacketVsConvexHull2D( RayPacket2D const& rays, ConvexHull2 const& convexHull, Vec2 const& boundingDiscCenter, float boundingDiscRadius,
+	bool useNarrowPhaseDiscOptimization = true );
+
+RayPacketResult RaycastPacketVsAABB3D( RayPacket3D const& rays, AABB3 const& bounds );
+RayPacketResult RaycastPacketVsPlane3D( RayPacket3D const& rays, Vec3 const& planeNormal, float planeDistanceFromOrigin );
+RayPacketResult RaycastPacketVsConvexHull3D( RayPacket3D const& rays, ConvexHull3 const& convexHull );
@@ -1,7 +1,6 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Math/RaycastUtils.hpp"
 #include "Engine/Math/MathUtils.hpp"
-#include "Engine/Math/FloatRange.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 
 
@@ -134,6 +133,9 @@ RaycastResult2D RaycastVsLineSegment2D( Vec2 rayStartPos, Vec2 rayFwdNormal, flo
 	return result;
 }
 
+
+//----------------------------------------------------------------------------------------------------------
+// Slab test: the ray is inside the box where it's between both pairs of lines at once
 RaycastResult2D RaycastVsAABB2D( Vec2 const& rayStartPos, Vec2 const& rayFwdNormal, float rayMaxDist, AABB2 const& bounds )
 {
 	RaycastResult2D result;
@@ -141,107 +143,131 @@ RaycastResult2D RaycastVsAABB2D( Vec2 const& rayStartPos, Vec2 const& rayFwdNorm
 	result.m_rayFwdNormal = rayFwdNormal;
 	result.m_rayMaxLength = rayMaxDist;
 
-	// if inside the AABB2, automatic hit
-	bool isPointInsideAABB2 = bounds.IsPointInside( rayStartPos );
-	if ( isPointInsideAABB2 )
-	{
-		Vec2 impactPos = bounds.GetNearestPoint( rayStartPos );
+	float const startPos[ 2 ]  = { rayStartPos.x, rayStartPos.y };
+	float const fwdNormal[ 2 ] = { rayFwdNormal.x, rayFwdNormal.y };
+	float const mins[ 2 ]	   = { bounds.m_mins.x, bounds.m_mins.y };
+	float const maxs[ 2 ]	   = { bounds.m_maxs.x, bounds.m_maxs.y };
 
-		result.m_didImpact	  = true;
-		result.m_impactNormal = rayFwdNormal * -1.f;
-		result.m_impactPos	  = impactPos;
-		result.m_impactDist	  = 0.f;
-		return result;
-	}
-
-
-	// 1. calculate t with minX
-	float tMinX = ( bounds.m_mins.x - rayStartPos.x ) / rayFwdNormal.x;
-
-	// 2. calculate t with maxX
-	float tMaxX = ( bounds.m_maxs.x - rayStartPos.x ) / rayFwdNormal.x;
-
-	// 3. calculate t with minY
-	float tMinY = ( bounds.m_mins.y - rayStartPos.y ) / rayFwdNormal.y;
+	float entryDistance = 0.f;
+	float exitDistance	= rayMaxDist;
+	int	  entryAxis		= -1;
+	float entrySign		= 0.f;
+	for ( int axis = 0; axis < 2; axis++ )
+	{
+		if ( fwdNormal[ axis ] == 0.f )
+		{
+			// parallel to the slab, the start has to be between its lines
+			if ( startPos[ axis ] < mins[ axis ] || startPos[ axis ] > maxs[ axis ] )
+			{
+				return result;
+			}
+			continue;
+		}
 
-	// 4. calculate t with maxY
-	float tMaxY = ( bounds.m_maxs.y - rayStartPos.y ) / rayFwdNormal.y;
+		float inverseFwd	  = 1.f / fwdNormal[ axis ];
+		float minLineDistance = ( mins[ axis ] - startPos[ axis ] ) * inverseFwd;
+		float maxLineDistance = ( maxs[ axis ] - startPos[ axis ] ) * inverseFwd;
+		float slabEntry		  = inverseFwd > 0.f ? minLineDistance : maxLineDistance;
+		float slabExit		  = inverseFwd > 0.f ? maxLineDistance : minLineDistance;
 
-	// calculate float ranges
-	FloatRange xFloatRange;
-	if ( tMinX < tMaxX )
-	{
-		xFloatRange = FloatRange( tMinX, tMaxX );
-	}
-	else
-	{
-		xFloatRange = FloatRange( tMaxX, tMinX );
+		if ( slabEntry > entryDistance )
+		{
+			entryDistance = slabEntry;
+			entryAxis	  = axis;
+			entrySign	  = inverseFwd > 0.f ? -1.f : 1.f;
+		}
+		if ( slabExit < exitDistance )
+		{
+			exitDistance = slabExit;
+		}
+		if ( entryDistance > exitDistance )
+		{
+			return result; // miss, or the box is behind the start or past the max distance
+		}
 	}
 
-	FloatRange yFloatRange;
-	if ( tMinY < tMaxY )
+	result.m_didImpact	= true;
+	result.m_impactDist = entryDistance;
+	result.m_impactPos	= rayStartPos + ( rayFwdNormal * entryDistance );
+	if ( entryAxis < 0 )
 	{
-		yFloatRange = FloatRange( tMinY, tMaxY );
+		// started inside the box
+		result.m_impactNormal = -1.f * rayFwdNormal;
 	}
 	else
 	{
-		yFloatRange = FloatRange( tMaxY, tMinY );
+		result.m_impactNormal = ( entryAxis == 0 ? Vec2( entrySign, 0.f ) : Vec2( 0.f, entrySign ) );
 	}
+	return result;
+}
 
-	if ( xFloatRange.IsOverlappingWith( yFloatRange ) )
-	{
-		// hit
-		float impactTime = 0.f;
 
-		// find the second smallest impact time
-		if ( xFloatRange.GetMin() < yFloatRange.GetMin() )
-		{
-			impactTime = yFloatRange.GetMin();
-		}
-		else
-		{
-			impactTime = xFloatRange.GetMin();
-		}
+//----------------------------------------------------------------------------------------------------------
+// Slab test in the box's own space, where it's an AABB2 around the origin
+RaycastResult2D RaycastVsOBB2D( Vec2 const& rayStartPos, Vec2 const& rayFwdNormal, float rayMaxDist, OBB2 const& orientedBox )
+{
+	RaycastResult2D result;
+	result.m_rayStartPos  = rayStartPos;
+	result.m_rayFwdNormal = rayFwdNormal;
+	result.m_rayMaxLength = rayMaxDist;
+
+	Vec2		iBasis				= orientedBox.m_iBasisNormal;
+	Vec2		jBasis				= iBasis.GetRotated90Degrees();
+	Vec2		startDisplacement	= rayStartPos - orientedBox.m_center;
+	float const	startPos[ 2 ]		= { DotProduct2D( startDisplacement, iBasis ), DotProduct2D( startDisplacement, jBasis ) };
+	float const	fwdNormal[ 2 ]		= { DotProduct2D( rayFwdNormal, iBasis ), DotProduct2D( rayFwdNormal, jBasis ) };
+	float const	halfDimensions[ 2 ]	= { orientedBox.m_halfDimensions.x, orientedBox.m_halfDimensions.y };
 
-		if ( impactTime < 0.f )
+	float entryDistance = 0.f;
+	float exitDistance	= rayMaxDist;
+	int	  entryAxis		= -1;
+	float entrySign		= 0.f;
+	for ( int axis = 0; axis < 2; axis++ )
+	{
+		if ( fwdNormal[ axis ] == 0.f )
 		{
-			// early miss
-			result.m_didImpact = false;
-			return result;
+			// parallel to the slab, the start has to be between its lines
+			if ( startPos[ axis ] < -halfDimensions[ axis ] || startPos[ axis ] > halfDimensions[ axis ] )
+			{
+				return result;
+			}
+			continue;
 		}
 
+		float inverseFwd	  = 1.f / fwdNormal[ axis ];
+		float minLineDistance = ( -halfDimensions[ axis ] - startPos[ axis ] ) * inverseFwd;
+		float maxLineDistance = ( halfDimensions[ axis ] - startPos[ axis ] ) * inverseFwd;
+		float slabEntry		  = inverseFwd > 0.f ? minLineDistance : maxLineDistance;
+		float slabExit		  = inverseFwd > 0.f ? maxLineDistance : minLineDistance;
 
-		Vec2  impactPos		 = rayStartPos + ( rayFwdNormal * impactTime );
-		Vec2  impactVector	 = impactPos - rayStartPos;
-		float impactDistance = impactVector.GetLength();
-
-		Vec2 impactNormal = Vec2::ZERO;
-		if ( impactPos.x == bounds.m_mins.x )
-		{
-			impactNormal = Vec2( -1.f, 0.f );
-		}
-		else if ( impactPos.x == bounds.m_maxs.x )
+		if ( slabEntry > entryDistance )
 		{
-			impactNormal = Vec2( 1.f, 0.f );
+			entryDistance = slabEntry;
+			entryAxis	  = axis;
+			entrySign	  = inverseFwd > 0.f ? -1.f : 1.f;
 		}
-		else if ( impactPos.y == bounds.m_mins.y )
+		if ( slabExit < exitDistance )
 		{
-			impactNormal = Vec2( 0.f, -1.f );
+			exitDistance = slabExit;
 		}
-		else if ( impactPos.y == bounds.m_maxs.y )
+		if ( entryDistance > exitDistance )
 		{
-			impactNormal = Vec2( 0.f, 1.f );
+			return result; // miss
 		}
-
-		result.m_didImpact	  = true;
-		result.m_impactNormal = impactNormal;
-		result.m_impactPos	  = impactPos;
-		result.m_impactDist	  = impactDistance;
-		return result;
 	}
 
-	// miss
-	result.m_didImpact = false;
+	result.m_didImpact	= true;
+	result.m_impactDist = entryDistance;
+	result.m_impactPos	= rayStartPos + ( rayFwdNormal * entryDistance );
+	if ( entryAxis < 0 )
+	{
+		// started inside the box
+		result.m_impactNormal = -1.f * rayFwdNormal;
+	}
+	else
+	{
+		result.m_impactNormal = ( entryAxis == 0 ? iBasis : jBasis ) * entrySign;
+	}
 	return result;
 }
 
@@ -423,6 +449,103 @@ RaycastResult2D RaycastVsCylinderZ3D( Vec3 const& startPos, Vec3 const& fwdNorma
 }
 
 
+//----------------------------------------------------------------------------------------------------------
+// Slab test: the ray is inside the box between the latest entry and the earliest exit of the three slabs
+RaycastResult3D RaycastVsAABB3D( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance, AABB3 const& bounds )
+{
+	RaycastResult3D result;
+	result.m_rayStartPos  = rayStartPos;
+	result.m_rayFwdNormal = rayFwdNormal;
+	result.m_rayMaxLength = rayMaxDistance;
+
+	float const startPos[ 3 ]  = { rayStartPos.x, rayStartPos.y, rayStartPos.z };
+	float const fwdNormal[ 3 ] = { rayFwdNormal.x, rayFwdNormal.y, rayFwdNormal.z };
+	float const mins[ 3 ]	   = { bounds.m_mins.x, bounds.m_mins.y, bounds.m_mins.z };
+	float const maxs[ 3 ]	   = { bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_maxs.z };
+
+	float entryDistance = 0.f;
+	float exitDistance	= rayMaxDistance;
+	int	  entryAxis		= -1;
+	float entrySign		= 0.f;
+	for ( int axis = 0; axis < 3; axis++ )
+	{
+		if ( fwdNormal[ axis ] == 0.f )
+		{
+			// parallel to the slab, the start has to be between its planes
+			if ( startPos[ axis ] < mins[ axis ] || startPos[ axis ] > maxs[ axis ] )
+			{
+				return result;
+			}
+			continue;
+		}
+
+		float inverseFwd	   = 1.f / fwdNormal[ axis ];
+		float minPlaneDistance = ( mins[ axis ] - startPos[ axis ] ) * inverseFwd;
+		float maxPlaneDistance = ( maxs[ axis ] - startPos[ axis ] ) * inverseFwd;
+		float slabEntry		   = inverseFwd > 0.f ? minPlaneDistance : maxPlaneDistance;
+		float slabExit		   = inverseFwd > 0.f ? maxPlaneDistance : minPlaneDistance;
+
+		if ( slabEntry > entryDistance )
+		{
+			entryDistance = slabEntry;
+			entryAxis	  = axis;
+			entrySign	  = inverseFwd > 0.f ? -1.f : 1.f;
+		}
+		if ( slabExit < exitDistance )
+		{
+			exitDistance = slabExit;
+		}
+		if ( entryDistance > exitDistance )
+		{
+			return result; // miss
+		}
+	}
+
+	result.m_didImpact	= true;
+	result.m_impactDist = entryDistance;
+	result.m_impactPos	= rayStartPos + ( rayFwdNormal * entryDistance );
+	if ( entryAxis < 0 )
+	{
+		// started inside the box
+		result.m_impactNormal = -1.f * rayFwdNormal;
+	}
+	else
+	{
+		float normal[ 3 ]	  = { 0.f, 0.f, 0.f };
+		normal[ entryAxis ]	  = entrySign;
+		result.m_impactNormal = Vec3( normal[ 0 ], normal[ 1 ], normal[ 2 ] );
+	}
+	return result;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Raycast against the box in its own space, where it's an AABB3 around the origin
+RaycastResult3D RaycastVsOBB3D( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance, OBB3 const& orientedBox )
+{
+	Vec3 iBasis = orientedBox.m_iBasisNormal;
+	Vec3 jBasis = orientedBox.m_jBasisNormal;
+	Vec3 kBasis = CrossProduct3D( iBasis, jBasis );
+
+	Vec3 localStartDisplacement = rayStartPos - orientedBox.m_center;
+	Vec3 localStartPos			= Vec3( DotProduct3D( localStartDisplacement, iBasis ), DotProduct3D( localStartDisplacement, jBasis ), DotProduct3D( localStartDisplacement, kBasis ) );
+	Vec3 localFwdNormal			= Vec3( DotProduct3D( rayFwdNormal, iBasis ), DotProduct3D( rayFwdNormal, jBasis ), DotProduct3D( rayFwdNormal, kBasis ) );
+
+	AABB3			localBounds = AABB3( -1.f * orientedBox.m_dimensions, orientedBox.m_dimensions );
+	RaycastResult3D result		= RaycastVsAABB3D( localStartPos, localFwdNormal, rayMaxDistance, localBounds );
+	result.m_rayStartPos		= rayStartPos;
+	result.m_rayFwdNormal		= rayFwdNormal;
+	if ( !result.m_didImpact )
+	{
+		return result;
+	}
+
+	result.m_impactPos	  = orientedBox.m_center + ( iBasis * result.m_impactPos.x ) + ( jBasis * result.m_impactPos.y ) + ( kBasis * result.m_impactPos.z );
+	result.m_impactNormal = ( iBasis * result.m_impactNormal.x ) + ( jBasis * result.m_impactNormal.y ) + ( kBasis * result.m_impactNormal.z );
+	return result;
+}
+
+
 //----------------------------------------------------------------------------------------------------------
 RaycastResult3D RaycastVsPlane3D( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance, Vec3 const& planeNormal, float planeDistanceFromOrigin )
 {
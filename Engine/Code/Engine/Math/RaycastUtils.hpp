@@ -3,6 +3,9 @@
 #include "Engine/Math/ConvexHull3.hpp"
 #include "Engine/Math/ConvexHull2.hpp"
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/OBB2.hpp"
+#include "Engine/Math/OBB3.hpp"
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/Vec2.hpp"
 
@@ -30,6 +33,7 @@ struct RaycastResult2D
 RaycastResult2D RaycastVsDisc2D(Vec2 startPos, Vec2 fwdNormal, float maxDist, Vec2 discCenter, float discRadius);
 RaycastResult2D RaycastVsLineSegment2D(Vec2 rayStartPos, Vec2 rayFwdNormal, float rayMaxDist, Vec2 lineSegmentStartPos, Vec2 lineSegmentEndPos);
 RaycastResult2D RaycastVsAABB2D(Vec2 const& rayStartPos, Vec2 const& rayFwdNormal, float rayMaxDist, AABB2 const& bounds);
+RaycastResult2D RaycastVsOBB2D( Vec2 const& rayStartPos, Vec2 const& rayFwdNormal, float rayMaxDist, OBB2 const& orientedBox );
 
 
 //----------------------------------------------------------------------------------------------------------
@@ -61,5 +65,7 @@ RaycastResult2D RaycastVsCylinderZ3D(Vec3 const& startPos, Vec3 const& fwdNormal
 
 
 //----------------------------------------------------------------------------------------------------------
+RaycastResult3D RaycastVsAABB3D( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance, AABB3 const& bounds );
+RaycastResult3D RaycastVsOBB3D( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance, OBB3 const& orientedBox ); // m_dimensions are half extents
 RaycastResult3D RaycastVsPlane3D( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance, Vec3 const& planeNormal, float planeDistanceFromOrigin );
 RaycastResult3D RaycastVsConvexHull3D( Vec3 const& rayStartPos, Vec3 const& rayFwdNormal, float rayMaxDistance, ConvexHull3 const& convexHull );
\ No newline at end of file
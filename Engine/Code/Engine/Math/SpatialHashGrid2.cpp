@@ -0,0 +1,339 @@
+#include "Engine/Math/SpatialHashGrid2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <math.h>
+
+
+//----------------------------------------------------------------------------------------------------------
+static AABB2 GetDiscBounds( Vec2 const& center, float radius )
+{
+	return AABB2( center - Vec2( radius, radius ), center + Vec2( radius, radius ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static AABB2 GetCapsuleBounds( Vec2 const& boneStart, Vec2 const& boneEnd, float radius )
+{
+	Vec2 mins = Vec2( fminf( boneStart.x, boneEnd.x ) - radius, fminf( boneStart.y, boneEnd.y ) - radius );
+	Vec2 maxs = Vec2( fmaxf( boneStart.x, boneEnd.x ) + radius, fmaxf( boneStart.y, boneEnd.y ) + radius );
+	return AABB2( mins, maxs );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static AABB2 GetOBBBounds( OBB2 const& orientedBox )
+{
+	Vec2 iBasis		= orientedBox.m_iBasisNormal;
+	Vec2 jBasis		= iBasis.GetRotated90Degrees();
+	Vec2 halfExtent = Vec2( fabsf( iBasis.x ) * orientedBox.m_halfDimensions.x + fabsf( jBasis.x ) * orientedBox.m_halfDimensions.y,
+		fabsf( iBasis.y ) * orientedBox.m_halfDimensions.x + fabsf( jBasis.y ) * orientedBox.m_halfDimensions.y );
+	return AABB2( orientedBox.m_center - halfExtent, orientedBox.m_center + halfExtent );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static bool DoBoundsOverlap( AABB2 const& boundsA, AABB2 const& boundsB )
+{
+	return boundsA.m_mins.x <= boundsB.m_maxs.x && boundsB.m_mins.x <= boundsA.m_maxs.x && boundsA.m_mins.y <= boundsB.m_maxs.y &&
+		   boundsB.m_mins.y <= boundsA.m_maxs.y;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+SpatialHashGrid2::SpatialHashGrid2( float cellSize, int numBuckets )
+	: m_cellSize( cellSize )
+	, m_inverseCellSize( 1.f / cellSize )
+{
+	GUARANTEE_OR_DIE( cellSize > 0.f, "SpatialHashGrid2 cell size must be positive" );
+
+	m_numBuckets = 1;
+	while ( m_numBuckets < numBuckets )
+	{
+		m_numBuckets *= 2;
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int SpatialHashGrid2::AddDisc( Vec2 const& center, float radius )
+{
+	return AddBounds( GetDiscBounds( center, radius ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int SpatialHashGrid2::AddCapsule( Vec2 const& boneStart, Vec2 const& boneEnd, float radius )
+{
+	return AddBounds( GetCapsuleBounds( boneStart, boneEnd, radius ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int SpatialHashGrid2::AddAABB( AABB2 const& bounds )
+{
+	return AddBounds( bounds );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int SpatialHashGrid2::AddOBB( OBB2 const& orientedBox )
+{
+	return AddBounds( GetOBBBounds( orientedBox ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void SpatialHashGrid2::UpdateDisc( int proxyId, Vec2 const& center, float radius )
+{
+	UpdateBounds( proxyId, GetDiscBounds( center, radius ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void SpatialHashGrid2::UpdateCapsule( int proxyId, Vec2 const& boneStart, Vec2 const& boneEnd, float radius )
+{
+	UpdateBounds( proxyId, GetCapsuleBounds( boneStart, boneEnd, radius ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void SpatialHashGrid2::UpdateAABB( int proxyId, AABB2 const& bounds )
+{
+	UpdateBounds( proxyId, bounds );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void SpatialHashGrid2::UpdateOBB( int proxyId, OBB2 const& orientedBox )
+{
+	UpdateBounds( proxyId, GetOBBBounds( orientedBox ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void SpatialHashGrid2::Remove( int proxyId )
+{
+	GUARANTEE_OR_DIE( m_proxies[ proxyId ].m_isInUse, "SpatialHashGrid2 removing a proxy that was already removed" );
+	m_proxies[ proxyId ].m_isInUse = false;
+	m_freeProxyIds.push_back( proxyId );
+	m_areCellsChanged = true;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void SpatialHashGrid2::Clear()
+{
+	m_proxies.clear();
+	m_freeProxyIds.clear();
+	m_cellEntries.clear();
+	m_bucketFirstEntries.clear();
+	m_areCellsChanged = false;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// A pair whose bounds share several cells meets in each of them; only the cell at the mins corner
+// of the cells they share reports it, so no set of reported pairs is needed. That corner is in the
+// lowest column of one of the two proxies and the lowest row of one of them, which the entries
+// record, so pairs meeting in any other cell are skipped without looking up either proxy.
+void SpatialHashGrid2::FindOverlappingPairs( std::vector<SpatialHashPair2>& out_pairs )
+{
+	RebuildCellEntriesIfChanged();
+	out_pairs.clear();
+	for ( int bucketIndex = 0; bucketIndex < m_numBuckets; bucketIndex++ )
+	{
+		int endEntryIndex = m_bucketFirstEntries[ bucketIndex + 1 ];
+		for ( int entryIndexA = m_bucketFirstEntries[ bucketIndex ]; entryIndexA < endEntryIndex; entryIndexA++ )
+		{
+			SpatialHashCellEntry2 const& entryA = m_cellEntries[ entryIndexA ];
+			for ( int entryIndexB = entryIndexA + 1; entryIndexB < endEntryIndex; entryIndexB++ )
+			{
+				SpatialHashCellEntry2 const& entryB = m_cellEntries[ entryIndexB ];
+				if ( entryA.m_cellX != entryB.m_cellX || entryA.m_cellY != entryB.m_cellY )
+				{
+					continue; // another cell hashed into the same bucket
+				}
+
+				bool isReportCell = ( entryA.m_isAtProxyMinsX || entryB.m_isAtProxyMinsX ) && ( entryA.m_isAtProxyMinsY || entryB.m_isAtProxyMinsY );
+				if ( isReportCell && DoBoundsOverlap( m_proxies[ entryA.m_proxyId ].m_bounds, m_proxies[ entryB.m_proxyId ].m_bounds ) )
+				{
+					bool isAFirst = entryA.m_proxyId < entryB.m_proxyId;
+					out_pairs.push_back( { isAFirst ? entryA.m_proxyId : entryB.m_proxyId, isAFirst ? entryB.m_proxyId : entryA.m_proxyId } );
+				}
+			}
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Same mins corner rule as FindOverlappingPairs(), with the query bounds as the second proxy
+void SpatialHashGrid2::FindProxiesOverlapping( AABB2 const& bounds, std::vector<int>& out_proxyIds )
+{
+	RebuildCellEntriesIfChanged();
+	out_proxyIds.clear();
+	IntVec2 queryCellMins = GetCellCoords( bounds.m_mins );
+	IntVec2 queryCellMaxs = GetCellCoords( bounds.m_maxs );
+	for ( int cellY = queryCellMins.y; cellY <= queryCellMaxs.y; cellY++ )
+	{
+		for ( int cellX = queryCellMins.x; cellX <= queryCellMaxs.x; cellX++ )
+		{
+			int bucketIndex = GetBucketIndex( cellX, cellY );
+			for ( int entryIndex = m_bucketFirstEntries[ bucketIndex ]; entryIndex < m_bucketFirstEntries[ bucketIndex + 1 ]; entryIndex++ )
+			{
+				SpatialHashCellEntry2 const& entry = m_cellEntries[ entryIndex ];
+				if ( entry.m_cellX != cellX || entry.m_cellY != cellY )
+				{
+					continue;
+				}
+
+				bool isReportCell = ( entry.m_isAtProxyMinsX || cellX == queryCellMins.x ) && ( entry.m_isAtProxyMinsY || cellY == queryCellMins.y );
+				if ( isReportCell && DoBoundsOverlap( m_proxies[ entry.m_proxyId ].m_bounds, bounds ) )
+				{
+					out_proxyIds.push_back( entry.m_proxyId );
+				}
+			}
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int SpatialHashGrid2::AddBounds( AABB2 const& bounds )
+{
+	int proxyId;
+	if ( !m_freeProxyIds.empty() )
+	{
+		proxyId = m_freeProxyIds.back();
+		m_freeProxyIds.pop_back();
+	}
+	else
+	{
+		proxyId = ( int ) m_proxies.size();
+		m_proxies.emplace_back();
+	}
+
+	SpatialHashProxy2& proxy = m_proxies[ proxyId ];
+	proxy.m_bounds			 = bounds;
+	proxy.m_cellMins		 = GetCellCoords( bounds.m_mins );
+	proxy.m_cellMaxs		 = GetCellCoords( bounds.m_maxs );
+	proxy.m_isInUse			 = true;
+	m_areCellsChanged		 = true;
+	return proxyId;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void SpatialHashGrid2::UpdateBounds( int proxyId, AABB2 const& bounds )
+{
+	SpatialHashProxy2& proxy = m_proxies[ proxyId ];
+	proxy.m_bounds			 = bounds;
+
+	IntVec2 cellMins = GetCellCoords( bounds.m_mins );
+	IntVec2 cellMaxs = GetCellCoords( bounds.m_maxs );
+	if ( cellMins.x != proxy.m_cellMins.x || cellMins.y != proxy.m_cellMins.y || cellMaxs.x != proxy.m_cellMaxs.x || cellMaxs.y != proxy.m_cellMaxs.y )
+	{
+		proxy.m_cellMins  = cellMins;
+		proxy.m_cellMaxs  = cellMaxs;
+		m_areCellsChanged = true;
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Counting sort of every proxy's cells by bucket: count the entries of each bucket, turn the counts
+// into where each bucket ends, then fill each bucket back to front so its end becomes its start
+void SpatialHashGrid2::RebuildCellEntriesIfChanged()
+{
+	if ( !m_areCellsChanged && !m_bucketFirstEntries.empty() )
+	{
+		return;
+	}
+
+	m_bucketFirstEntries.assign( m_numBuckets + 1, 0 );
+	for ( SpatialHashProxy2 const& proxy : m_proxies )
+	{
+		if ( !proxy.m_isInUse )
+		{
+			continue;
+		}
+		for ( int cellY = proxy.m_cellMins.y; cellY <= proxy.m_cellMaxs.y; cellY++ )
+		{
+			for ( int cellX = proxy.m_cellMins.x; cellX <= proxy.m_cellMaxs.x; cellX++ )
+			{
+				m_bucketFirstEntries[ GetBucketIndex( cellX, cellY ) ]++;
+			}
+		}
+	}
+
+	for ( int bucketIndex = 1; bucketIndex <= m_numBuckets; bucketIndex++ )
+	{
+		m_bucketFirstEntries[ bucketIndex ] += m_bucketFirstEntries[ bucketIndex - 1 ];
+	}
+
+	m_cellEntries.resize( m_bucketFirstEntries[ m_numBuckets ] );
+	for ( int proxyId = 0; proxyId < ( int ) m_proxies.size(); proxyId++ )
+	{
+		SpatialHashProxy2 const& proxy = m_proxies[ proxyId ];
+		if ( !proxy.m_isInUse )
+		{
+			continue;
+		}
+		for ( int cellY = proxy.m_cellMins.y; cellY <= proxy.m_cellMaxs.y; cellY++ )
+		{
+			for ( int cellX = proxy.m_cellMins.x; cellX <= proxy.m_cellMaxs.x; cellX++ )
+			{
+				int entryIndex				= --m_bucketFirstEntries[ GetBucketIndex( cellX, cellY ) ];
+				m_cellEntries[ entryIndex ] = { proxyId, cellX, cellY, cellX == proxy.m_cellMins.x, cellY == proxy.m_cellMins.y };
+			}
+		}
+	}
+	m_areCellsChanged = false;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+IntVec2 SpatialHashGrid2::GetCellCoords( Vec2 const& position ) const
+{
+	return IntVec2( ( int ) floorf( position.x * m_inverseCellSize ), ( int ) floorf( position.y * m_inverseCellSize ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int SpatialHashGrid2::GetBucketIndex( int cellX, int cellY ) const
+{
+	unsigned int hash = ( ( unsigned int ) cellX * 73856093u ) ^ ( ( unsigned int ) cellY * 19349663u );
+	return ( int ) ( hash & ( unsigned int ) ( m_numBuckets - 1 ) );
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+int PushDiscPairsOutOfEachOther2D( std::vector<SpatialHashPair2> const& pairs, Vec2* discCenters, float const* discRadii )
+{
+	int numPushed = 0;
+	for ( SpatialHashPair2 const& pair : pairs )
+	{
+		int indexA = pair.m_proxyIdA;
+		int indexB = pair.m_proxyIdB;
+		if ( PushDiscsOutOfEachOther2D( discCenters[ indexA ], discRadii[ indexA ], discCenters[ indexB ], discRadii[ indexB ] ) )
+		{
+			numPushed++;
+		}
+	}
+	return numPushed;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+void BounceDiscPairsOffEachOther2D( std::vector<SpatialHashPair2> const& pairs, Vec2* discCenters, float const* discRadii, Vec2* discVelocities,
+	float const* discElasticities )
+{
+	for ( SpatialHashPair2 const& pair : pairs )
+	{
+		int indexA = pair.m_proxyIdA;
+		int indexB = pair.m_proxyIdB;
+		BounceDiscOffEachOther2D( discCenters[ indexA ], discRadii[ indexA ], discVelocities[ indexA ], discCenters[ indexB ], discRadii[ indexB ],
+			discVelocities[ indexB ], discElasticities[ indexA ], discElasticities[ indexB ] );
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/OBB2.hpp"
+#include "Engine/Math/Vec2.hpp"
+
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------------
+struct SpatialHashPair2
+{
+	int m_proxyIdA = -1; // always the lower of the two
+	int m_proxyIdB = -1;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct SpatialHashProxy2
+{
+	AABB2	m_bounds;
+	IntVec2 m_cellMins; // range of cells the bounds cover
+	IntVec2 m_cellMaxs;
+	bool	m_isInUse = false;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Cells hash into a fixed number of buckets, so a bucket can hold entries of more than one cell
+struct SpatialHashCellEntry2
+{
+	int	 m_proxyId		  = -1;
+	int	 m_cellX		  = 0;
+	int	 m_cellY		  = 0;
+	bool m_isAtProxyMinsX = false; // the cell is in the lowest column of the proxy's cells
+	bool m_isAtProxyMinsY = false; // and in the lowest row
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Broadphase for many moving 2D shapes: a uniform grid of square cells, hashed into buckets so the
+// world needs no fixed size. Each proxy sits in every cell its bounds overlap, and only proxies
+// sharing a cell are paired, so a tick costs about O(n) instead of the O(n^2) of testing every
+// pair. Pairs are of overlapping bounds; the narrowphase still has to test the shapes themselves.
+//
+// Pick a cell size around the diameter of a typical shape: much smaller puts every shape in many
+// cells, much larger puts many shapes in one cell. Use a bucket count around the number of proxies.
+//
+// Adds, updates and removes only change the proxy. The cell entries are one array grouped by
+// bucket, so searches read them in order; the next search after a proxy is added, removed or
+// moved into a different range of cells rebuilds the array with an O(n) counting sort, and
+// moves that stay within their cells reuse it.
+//
+//	grid.UpdateDisc( discIndex, discCenters[ discIndex ], discRadii[ discIndex ] ); // every moved disc
+//	grid.FindOverlappingPairs( pairs );
+//	BounceDiscPairsOffEachOther2D( pairs, discCenters, discRadii, discVelocities, discElasticities );
+class SpatialHashGrid2
+{
+public:
+	explicit SpatialHashGrid2( float cellSize, int numBuckets = 4096 );
+
+	// each returns the proxy id used to update, remove and report the shape; ids count up from 0
+	// in the order added, until Remove() frees one for reuse
+	int AddDisc( Vec2 const& center, float radius );
+	int AddCapsule( Vec2 const& boneStart, Vec2 const& boneEnd, float radius );
+	int AddAABB( AABB2 const& bounds );
+	int AddOBB( OBB2 const& orientedBox );
+
+	void UpdateDisc( int proxyId, Vec2 const& center, float radius );
+	void UpdateCapsule( int proxyId, Vec2 const& boneStart, Vec2 const& boneEnd, float radius );
+	void UpdateAABB( int proxyId, AABB2 const& bounds );
+	void UpdateOBB( int proxyId, OBB2 const& orientedBox );
+
+	void Remove( int proxyId );
+	void Clear();
+
+	// each pair of proxies whose bounds overlap, once
+	void FindOverlappingPairs( std::vector<SpatialHashPair2>& out_pairs );
+
+	// each proxy whose bounds overlap the given bounds, once
+	void FindProxiesOverlapping( AABB2 const& bounds, std::vector<int>& out_proxyIds );
+
+	AABB2 const& GetProxyBounds( int proxyId ) const { return m_proxies[ proxyId ].m_bounds; }
+	int			 GetNumProxies() const { return ( int ) m_proxies.size() - ( int ) m_freeProxyIds.size(); }
+	float		 GetCellSize() const { return m_cellSize; }
+
+protected:
+	int	 AddBounds( AABB2 const& bounds );
+	void UpdateBounds( int proxyId, AABB2 const& bounds );
+	void RebuildCellEntriesIfChanged();
+
+	IntVec2 GetCellCoords( Vec2 const& position ) const;
+	int		GetBucketIndex( int cellX, int cellY ) const;
+
+	float							   m_cellSize		 = 1.f;
+	float							   m_inverseCellSize = 1.f;
+	int								   m_numBuckets		 = 0; // a power of two
+	std::vector<SpatialHashProxy2>	   m_proxies;			  // by proxy id
+	std::vector<int>				   m_freeProxyIds;
+	std::vector<SpatialHashCellEntry2> m_cellEntries;		  // grouped by bucket
+	std::vector<int>				   m_bucketFirstEntries;  // bucket b's entries start at [ b ] and end at [ b + 1 ]
+	bool							   m_areCellsChanged = false;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Batched narrowphase for a grid holding only discs, with the disc arrays indexed by proxy id.
+// Pairs are resolved in order with the pairwise functions in MathUtils; positions they change go
+// back into the grid with the next tick's updates.
+int	 PushDiscPairsOutOfEachOther2D( std::vector<SpatialHashPair2> const& pairs, Vec2* discCenters, float const* discRadii ); // returns the number pushed
+void BounceDiscPairsOffEachOther2D( std::vector<SpatialHashPair2> const& pairs, Vec2* discCenters, float const* discRadii, Vec2* discVelocities,
+	float const* discElasticities );
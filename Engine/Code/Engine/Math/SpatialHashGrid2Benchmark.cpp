@@ -0,0 +1,201 @@
+#include "Engine/Math/SpatialHashGrid2Benchmark.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Math/SpatialHashGrid2.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <algorithm>
+#include <math.h>
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------------
+struct BenchmarkDiscs
+{
+	std::vector<Vec2>  m_centers;
+	std::vector<Vec2>  m_velocities;
+	std::vector<float> m_radii;
+	std::vector<float> m_elasticities;
+	float			   m_worldSize = 0.f;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+static void LogToDevConsole( Rgba8 const& color, std::string const& text )
+{
+	if ( g_theDevConsole )
+	{
+		g_theDevConsole->AddLine( color, text );
+	}
+	else
+	{
+		DebuggerPrintf( "%s\n", text.c_str() );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static void CreateBenchmarkDiscs( BenchmarkDiscs& discs, int numDiscs, RandomNumberGenerator& rng )
+{
+	discs.m_worldSize = sqrtf( ( float ) numDiscs * 4.f );
+	discs.m_centers.resize( numDiscs );
+	discs.m_velocities.resize( numDiscs );
+	discs.m_radii.resize( numDiscs );
+	discs.m_elasticities.assign( numDiscs, 0.9f );
+	for ( int discIndex = 0; discIndex < numDiscs; discIndex++ )
+	{
+		discs.m_centers[ discIndex ]	= Vec2( rng.RollRandomFloatLessThan( discs.m_worldSize ), rng.RollRandomFloatLessThan( discs.m_worldSize ) );
+		discs.m_velocities[ discIndex ] = Vec2( rng.RollRandomFloatInRange( -5.f, 5.f ), rng.RollRandomFloatInRange( -5.f, 5.f ) );
+		discs.m_radii[ discIndex ]		= rng.RollRandomFloatInRange( 0.3f, 0.6f );
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static bool IsPairLess( SpatialHashPair2 const& pairA, SpatialHashPair2 const& pairB )
+{
+	return pairA.m_proxyIdA != pairB.m_proxyIdA ? pairA.m_proxyIdA < pairB.m_proxyIdA : pairA.m_proxyIdB < pairB.m_proxyIdB;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+static bool AreSamePair( SpatialHashPair2 const& pairA, SpatialHashPair2 const& pairB )
+{
+	return pairA.m_proxyIdA == pairB.m_proxyIdA && pairA.m_proxyIdB == pairB.m_proxyIdB;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+// Proxy ids count up from 0 in the order added, so they are the disc indexes
+static void CheckAgainstBruteForce( SpatialHashGrid2BenchmarkSettings const& settings, RandomNumberGenerator& rng, SpatialHashGrid2BenchmarkResult& result )
+{
+	BenchmarkDiscs discs;
+	CreateBenchmarkDiscs( discs, settings.m_numCheckedDiscs, rng );
+
+	SpatialHashGrid2 grid( settings.m_cellSize, settings.m_numCheckedDiscs );
+	for ( int discIndex = 0; discIndex < settings.m_numCheckedDiscs; discIndex++ )
+	{
+		grid.AddDisc( discs.m_centers[ discIndex ], discs.m_radii[ discIndex ] );
+	}
+
+	std::vector<SpatialHashPair2> pairs;
+	grid.FindOverlappingPairs( pairs );
+	std::sort( pairs.begin(), pairs.end(), IsPairLess );
+	std::vector<SpatialHashPair2>::iterator uniquePairsEnd = std::unique( pairs.begin(), pairs.end(), AreSamePair );
+	result.m_numDuplicatePairs							   = ( int ) ( pairs.end() - uniquePairsEnd );
+	pairs.erase( uniquePairsEnd, pairs.end() );
+
+	for ( int discIndexA = 0; discIndexA < settings.m_numCheckedDiscs; discIndexA++ )
+	{
+		for ( int discIndexB = discIndexA + 1; discIndexB < settings.m_numCheckedDiscs; discIndexB++ )
+		{
+			if ( DoDiscsOverlap( discs.m_centers[ discIndexA ], discs.m_radii[ discIndexA ], discs.m_centers[ discIndexB ], discs.m_radii[ discIndexB ] ) )
+			{
+				SpatialHashPair2 overlappingPair;
+				overlappingPair.m_proxyIdA = discIndexA;
+				overlappingPair.m_proxyIdB = discIndexB;
+				result.m_numCheckedOverlaps++;
+				result.m_numMissingPairs += std::binary_search( pairs.begin(), pairs.end(), overlappingPair, IsPairLess ) ? 0 : 1;
+			}
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+SpatialHashGrid2BenchmarkResult RunSpatialHashGrid2Benchmark( SpatialHashGrid2BenchmarkSettings const& settings )
+{
+	RandomNumberGenerator rng;
+	rng.SetSeed( settings.m_seed );
+
+	SpatialHashGrid2BenchmarkResult result;
+	CheckAgainstBruteForce( settings, rng, result );
+
+	BenchmarkDiscs discs;
+	CreateBenchmarkDiscs( discs, settings.m_numDiscs, rng );
+
+	SpatialHashGrid2 grid( settings.m_cellSize, settings.m_numDiscs );
+	for ( int discIndex = 0; discIndex < settings.m_numDiscs; discIndex++ )
+	{
+		grid.AddDisc( discs.m_centers[ discIndex ], discs.m_radii[ discIndex ] );
+	}
+
+	constexpr float TICK_SECONDS = 1.f / 60.f;
+
+	std::vector<SpatialHashPair2> pairs;
+	double						  updateSeconds = 0.0;
+	double						  pairsSeconds	= 0.0;
+	double						  bounceSeconds = 0.0;
+	double						  numPairs		= 0.0;
+	for ( int tickIndex = 0; tickIndex < settings.m_numTicks; tickIndex++ )
+	{
+		// moving the discs isn't timed; they turn back at the edges of the world
+		for ( int discIndex = 0; discIndex < settings.m_numDiscs; discIndex++ )
+		{
+			Vec2& center   = discs.m_centers[ discIndex ];
+			Vec2& velocity = discs.m_velocities[ discIndex ];
+			center += velocity * TICK_SECONDS;
+			if ( center.x < 0.f || center.x > discs.m_worldSize )
+			{
+				velocity.x = -velocity.x;
+			}
+			if ( center.y < 0.f || center.y > discs.m_worldSize )
+			{
+				velocity.y = -velocity.y;
+			}
+		}
+
+		double startSeconds = GetCurrentTimeSeconds();
+		for ( int discIndex = 0; discIndex < settings.m_numDiscs; discIndex++ )
+		{
+			grid.UpdateDisc( discIndex, discs.m_centers[ discIndex ], discs.m_radii[ discIndex ] );
+		}
+		double updatedSeconds = GetCurrentTimeSeconds();
+		grid.FindOverlappingPairs( pairs );
+		double pairedSeconds = GetCurrentTimeSeconds();
+		BounceDiscPairsOffEachOther2D( pairs, discs.m_centers.data(), discs.m_radii.data(), discs.m_velocities.data(), discs.m_elasticities.data() );
+		double bouncedSeconds = GetCurrentTimeSeconds();
+
+		updateSeconds += updatedSeconds - startSeconds;
+		pairsSeconds += pairedSeconds - updatedSeconds;
+		bounceSeconds += bouncedSeconds - pairedSeconds;
+		numPairs += ( double ) pairs.size();
+	}
+
+	double numTicks					   = ( double ) settings.m_numTicks;
+	result.m_updateMillisecondsPerTick = updateSeconds * 1000.0 / numTicks;
+	result.m_pairsMillisecondsPerTick  = pairsSeconds * 1000.0 / numTicks;
+	result.m_bounceMillisecondsPerTick = bounceSeconds * 1000.0 / numTicks;
+	result.m_candidatePairsPerTick	   = numPairs / numTicks;
+	return result;
+}
+
+
+//----------------------------------------------------------------------------------------------------------
+bool Command_SpatialHashBench( EventArgs& args )
+{
+	SpatialHashGrid2BenchmarkSettings settings;
+	settings.m_numDiscs = args.GetValue( "Discs", settings.m_numDiscs );
+	settings.m_numTicks = args.GetValue( "Ticks", settings.m_numTicks );
+	if ( settings.m_numDiscs < 1 || settings.m_numTicks < 1 )
+	{
+		LogToDevConsole( DevConsole::ERROR_COLOR, "SpatialHashBench: Discs and Ticks have to be at least 1" );
+		return true;
+	}
+
+	SpatialHashGrid2BenchmarkResult result = RunSpatialHashGrid2Benchmark( settings );
+	LogToDevConsole( DevConsole::INFO_MAJOR_COLOR, Stringf( "SpatialHashBench: %d discs, cell size %.2f; ms per tick: update %.2f, pairs %.2f, bounce %.2f, total %.2f",
+		settings.m_numDiscs, settings.m_cellSize, result.m_updateMillisecondsPerTick, result.m_pairsMillisecondsPerTick, result.m_bounceMillisecondsPerTick,
+		result.m_updateMillisecondsPerTick + result.m_pairsMillisecondsPerTick + result.m_bounceMillisecondsPerTick ) );
+	LogToDevConsole( DevConsole::INFO_MINOR_COLOR, Stringf( "  %.0f candidate pairs per tick", result.m_candidatePairsPerTick ) );
+
+	bool  isCorrect = result.m_numMissingPairs == 0 && result.m_numDuplicatePairs == 0;
+	Rgba8 color		= isCorrect ? DevConsole::INFO_MINOR_COLOR : DevConsole::ERROR_COLOR;
+	LogToDevConsole( color, Stringf( "  brute force check of %d discs: %d overlapping pairs, %d missing from the grid's pairs, %d reported twice",
+		settings.m_numCheckedDiscs, result.m_numCheckedOverlaps, result.m_numMissingPairs, result.m_numDuplicatePairs ) );
+	return true;
+}
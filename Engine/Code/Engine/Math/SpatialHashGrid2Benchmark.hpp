@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+
+
+//----------------------------------------------------------------------------------------------------------
+struct SpatialHashGrid2BenchmarkSettings
+{
+	int			 m_numDiscs		   = 100000; // radius 0.3 to 0.6, spread over a square about four units of area per disc
+	float		 m_cellSize		   = 1.2f;
+	int			 m_numTicks		   = 120;	// 60Hz ticks of moving, updating, pairing and bouncing every disc
+	int			 m_numCheckedDiscs = 5000;	// the brute force check is O(n^2), so it runs on a grid of its own this size
+	unsigned int m_seed			   = 9;
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+struct SpatialHashGrid2BenchmarkResult
+{
+	double m_updateMillisecondsPerTick = 0.0;
+	double m_pairsMillisecondsPerTick  = 0.0;
+	double m_bounceMillisecondsPerTick = 0.0;
+	double m_candidatePairsPerTick	   = 0.0;
+	int	   m_numCheckedOverlaps		   = 0; // disc pairs that overlap in the checked grid
+	int	   m_numMissingPairs		   = 0; // of those, the ones FindOverlappingPairs() didn't report
+	int	   m_numDuplicatePairs		   = 0; // pairs reported more than once
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Milliseconds per tick of a SpatialHashGrid2 holding only discs: UpdateDisc() on every disc,
+// FindOverlappingPairs(), then BounceDiscPairsOffEachOther2D(). The pairs of a smaller grid are
+// checked against testing every pair of its discs
+SpatialHashGrid2BenchmarkResult RunSpatialHashGrid2Benchmark( SpatialHashGrid2BenchmarkSettings const& settings );
+
+// "SpatialHashBench Discs=100000 Ticks=120"; logs milliseconds per tick and the brute force check
+// DevConsole::Startup() subscribes it
+bool Command_SpatialHashBench( EventArgs& args );
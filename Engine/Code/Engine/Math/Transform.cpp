@@ -12,25 +12,6 @@ Transform::Transform( Vec3 const& position, Quaternion const& rotation, Vec3 con
 }
 
 
-//-------------------------------------------------------------------------
-Transform Transform::ApplyChildToParentTransform( Transform const& child, Transform const& parent )
-{
-	Transform result;
-
-	// combine scale
-	result.m_scale = parent.m_scale * child.m_scale;
-
-	// combine rotation
-	result.m_rotation = parent.m_rotation * child.m_rotation;
-
-	// combine position
-	result.m_position = parent.m_rotation * ( parent.m_scale * child.m_position );
-	result.m_position = parent.m_position + result.m_position;
-
-	return result;
-}
-
-
 //----------------------------------------------------------------------------------------------------------
 Transform Transform::CreateFromMatrix( Mat44 const& matrix )
 {
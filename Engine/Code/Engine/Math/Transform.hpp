@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Engine/Math/MathSIMD.hpp"
 #include "Engine/Math/Quaternion.hpp"
 #include "Engine/Math/Vec3.hpp"
 
@@ -23,4 +24,26 @@ struct Transform
 	bool			 operator!=( Transform const& other ) const;
 	Transform const	 operator-( Transform const& other ) const; // transform - transform
 	Transform const	 operator+( Transform const& other ) const; // transform + transform
-};
\ No newline at end of file
+};
+
+
+//----------------------------------------------------------------------------------------------------------
+// Inline, for the global pose pass that runs it on every joint
+inline Transform Transform::ApplyChildToParentTransform( Transform const& child, Transform const& parent )
+{
+	Transform result;
+
+	// combine scale
+	__m128 parentScale = SIMDLoadVec3( parent.m_scale );
+	SIMDStoreVec3( result.m_scale, _mm_mul_ps( parentScale, SIMDLoadVec3( child.m_scale ) ) );
+
+	// combine rotation
+	result.m_rotation = parent.m_rotation * child.m_rotation;
+
+	// combine position
+	Vec3 scaledChildPosition;
+	SIMDStoreVec3( scaledChildPosition, _mm_mul_ps( parentScale, SIMDLoadVec3( child.m_position ) ) );
+	SIMDStoreVec3( result.m_position, _mm_add_ps( SIMDLoadVec3( parent.m_position ), SIMDLoadVec3( parent.m_rotation * scaledChildPosition ) ) );
+
+	return result;
+}